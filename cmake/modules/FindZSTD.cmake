@@ -0,0 +1,69 @@
+# Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.
+# All rights reserved.
+#
+# For the licensing terms see $ROOTSYS/LICENSE.
+# For the list of contributors see $ROOTSYS/README/CREDITS.
+
+#.rst:
+# FindZSTD
+# -------
+#
+# Find the ZSTD library header and define variables.
+#
+# Imported Targets
+# ^^^^^^^^^^^^^^^^
+#
+# This module defines :prop_tgt:`IMPORTED` target ``ZSTD::ZSTD``,
+# if ZSTD has been found
+#
+# Result Variables
+# ^^^^^^^^^^^^^^^^
+#
+# This module defines the following variables:
+#
+# ::
+#
+#   ZSTD_FOUND          - True if ZSTD is found.
+#   ZSTD_INCLUDE_DIRS   - Where to find zstd.h
+#
+# ::
+#
+#   ZSTD_VERSION        - The version of ZSTD found (x.y.z)
+#   ZSTD_VERSION_MAJOR  - The major version of ZSTD
+#   ZSTD_VERSION_MINOR  - The minor version of ZSTD
+#   ZSTD_VERSION_PATCH  - The patch version of ZSTD
+
+find_path(ZSTD_INCLUDE_DIR NAME zstd.h PATH_SUFFIXES include)
+
+if(NOT ZSTD_LIBRARY)
+  find_library(ZSTD_LIBRARY NAMES zstd PATH_SUFFIXES lib)
+endif()
+
+mark_as_advanced(ZSTD_INCLUDE_DIR)
+
+if(ZSTD_INCLUDE_DIR AND EXISTS "${ZSTD_INCLUDE_DIR}/zstd.h")
+  file(STRINGS "${ZSTD_INCLUDE_DIR}/zstd.h" ZSTD_H REGEX "^#define ZSTD_VERSION_[A-Z]+[ ]+[0-9]+.*$")
+  string(REGEX REPLACE ".+ZSTD_VERSION_MAJOR[ ]+([0-9]+).*$"   "\\1" ZSTD_VERSION_MAJOR "${ZSTD_H}")
+  string(REGEX REPLACE ".+ZSTD_VERSION_MINOR[ ]+([0-9]+).*$"   "\\1" ZSTD_VERSION_MINOR "${ZSTD_H}")
+  string(REGEX REPLACE ".+ZSTD_VERSION_RELEASE[ ]+([0-9]+).*$" "\\1" ZSTD_VERSION_PATCH "${ZSTD_H}")
+  set(ZSTD_VERSION "${ZSTD_VERSION_MAJOR}.${ZSTD_VERSION_MINOR}.${ZSTD_VERSION_PATCH}")
+endif()
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(ZSTD
+  REQUIRED_VARS ZSTD_LIBRARY ZSTD_INCLUDE_DIR VERSION_VAR ZSTD_VERSION)
+
+if(ZSTD_FOUND)
+  set(ZSTD_INCLUDE_DIRS "${ZSTD_INCLUDE_DIR}")
+
+  if(NOT ZSTD_LIBRARIES)
+    set(ZSTD_LIBRARIES ${ZSTD_LIBRARY})
+  endif()
+
+  if(NOT TARGET ZSTD::ZSTD)
+    add_library(ZSTD::ZSTD UNKNOWN IMPORTED)
+    set_target_properties(ZSTD::ZSTD PROPERTIES
+      IMPORTED_LOCATION "${ZSTD_LIBRARY}"
+      INTERFACE_INCLUDE_DIRECTORIES "${ZSTD_INCLUDE_DIRS}")
+  endif()
+endif()
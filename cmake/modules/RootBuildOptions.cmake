@@ -103,6 +103,7 @@ ROOT_BUILD_OPTION(builtin_veccore OFF "Build VecCore internally (requires networ
 ROOT_BUILD_OPTION(builtin_xrootd OFF "Build XRootD internally (requires network)")
 ROOT_BUILD_OPTION(builtin_xxhash OFF "Build bundled copy of xxHash")
 ROOT_BUILD_OPTION(builtin_zlib OFF "Build bundled copy of zlib")
+ROOT_BUILD_OPTION(builtin_zstd OFF "Build bundled copy of zstd")
 ROOT_BUILD_OPTION(ccache OFF "Enable ccache usage for speeding up builds")
 ROOT_BUILD_OPTION(cefweb OFF "Enable support for CEF (Chromium Embedded Framework) web-based display")
 ROOT_BUILD_OPTION(clad ON "Build clad, the cling automatic differentiation plugin (requires network)")
@@ -172,6 +173,7 @@ ROOT_BUILD_OPTION(winrtdebug OFF "Link against the Windows debug runtime library
 ROOT_BUILD_OPTION(x11 ON "Enable support for X11/Xft")
 ROOT_BUILD_OPTION(xml ON "Enable support for XML (requires libxml2)")
 ROOT_BUILD_OPTION(xrootd ON "Enable support for XRootD file server and client")
+ROOT_BUILD_OPTION(zlib_cf ON "Use the accelerated variant of the bundled copy of zlib (Linux on x86_64 and aarch64 only)")
 
 option(all "Enable all optional components by default" OFF)
 option(clingtest "Enable cling tests (Note: that this makes llvm/clang symbols visible in libCling)" OFF)
@@ -189,13 +191,13 @@ if(all AND minimal)
 endif()
 
 #--- Compression algorithms in ROOT-------------------------------------------------------------
-set(compression_default "zlib" CACHE STRING "Default compression algorithm (zlib (default), lz4, or lzma)")
+set(compression_default "zlib" CACHE STRING "Default compression algorithm (zlib (default), lz4, lzma or zstd)")
 string(TOLOWER "${compression_default}" compression_default)
-if("${compression_default}" MATCHES "zlib|lz4|lzma")
+if("${compression_default}" MATCHES "zlib|lz4|lzma|zstd")
   message(STATUS "ROOT default compression algorithm: ${compression_default}")
 else()
   message(FATAL_ERROR "Unsupported compression algorithm: ${compression_default}\n"
-    "Known values are zlib, lzma, lz4 (case-insensitive).")
+    "Known values are zlib, lzma, lz4, zstd (case-insensitive).")
 endif()
 
 #--- The 'all' option swithes ON major options---------------------------------------------------
@@ -279,6 +281,7 @@ if(builtin_all)
   set(builtin_xrootd_defvalue ON)
   set(builtin_xxhash_defvalue ON)
   set(builtin_zlib_defvalue ON)
+  set(builtin_zstd_defvalue ON)
 endif()
 
 #---Changes in defaults due to platform-------------------------------------------------------
@@ -420,14 +420,22 @@ if(compression_default STREQUAL "lz4")
   set(uselz4 define)
   set(usezlib undef)
   set(uselzma undef)
+  set(usezstd undef)
 elseif(compression_default STREQUAL "zlib")
   set(uselz4 undef)
   set(usezlib define)
   set(uselzma undef)
+  set(usezstd undef)
 elseif(compression_default STREQUAL "lzma")
   set(uselz4 undef)
   set(usezlib undef)
   set(uselzma define)
+  set(usezstd undef)
+elseif(compression_default STREQUAL "zstd")
+  set(uselz4 undef)
+  set(usezlib undef)
+  set(uselzma undef)
+  set(usezstd define)
 endif()
 # cloudflare zlib is available only on x86 and aarch64 platforms with Linux
 # for other platforms we have available builtin zlib 1.2.8
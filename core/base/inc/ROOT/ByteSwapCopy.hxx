@@ -0,0 +1,42 @@
+// @(#)root/base
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_ByteSwapCopy
+#define ROOT_ByteSwapCopy
+
+#include <cstddef>
+
+namespace ROOT {
+namespace Internal {
+
+/// \name Bulk byte swapping
+/// Copy n elements of 2, 4 or 8 bytes from `from` to `to`, swapping the
+/// bytes of each element; used to convert arrays between the big-endian
+/// format of the files and the native one.  Neither pointer needs to be
+/// aligned.  `to` may be equal to `from` (swapping in place), but the two
+/// arrays must not otherwise overlap.
+///
+/// The copy uses the widest vector instructions available on the CPU
+/// running the program (AVX2 or SSSE3 on x86, NEON on ARM64), chosen on
+/// the first call.
+///@{
+void ByteSwapCopy16(void *to, const void *from, std::size_t n);
+void ByteSwapCopy32(void *to, const void *from, std::size_t n);
+void ByteSwapCopy64(void *to, const void *from, std::size_t n);
+///@}
+
+/// Name of the instruction set used by the ByteSwapCopy functions:
+/// "avx2", "ssse3", "neon" or "scalar".
+const char *GetByteSwapCopyKernel();
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -64,6 +64,11 @@ public:
 
    virtual void UnzipEvent(TObject *tree, Long64_t pos, Double_t start, Int_t complen, Int_t objlen) = 0;
 
+   // Optional per-branch and timeline events, recorded by TTreePerfStats.
+   virtual void BranchUnzipEvent(TBranch * /*branch*/, Double_t /*start*/, Int_t /*complen*/, Int_t /*objlen*/) {}
+   virtual void BranchReadEvent(TBranch * /*branch*/, Double_t /*start*/) {}
+   virtual void TaskEvent(TObject * /*tree*/, const char * /*name*/, Double_t /*start*/) {}
+
    virtual void RateEvent(Double_t proctime, Double_t deltatime,
                           Long64_t eventsprocessed, Long64_t bytesRead) = 0;
 
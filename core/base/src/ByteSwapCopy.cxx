@@ -0,0 +1,201 @@
+// @(#)root/base
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/ByteSwapCopy.hxx"
+
+#include "Byteswap.h"
+
+#include <cstdint>
+#include <cstring>
+
+// The x86 kernels are compiled for their instruction set whatever the flags
+// of the build, and only run if the CPU supports it.
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#define R__BSWAP_X86
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define R__BSWAP_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+using Kernel_t = void (*)(char *to, const char *from, std::size_t n);
+
+inline std::uint16_t Swap(std::uint16_t x)
+{
+   return Rbswap_16(x);
+}
+
+inline std::uint32_t Swap(std::uint32_t x)
+{
+   return Rbswap_32(x);
+}
+
+inline std::uint64_t Swap(std::uint64_t x)
+{
+#ifdef Rbswap_64
+   return Rbswap_64(x);
+#else
+   return (std::uint64_t(Swap(std::uint32_t(x))) << 32) | Swap(std::uint32_t(x >> 32));
+#endif
+}
+
+template <typename T>
+void SwapScalar(char *to, const char *from, std::size_t n)
+{
+   for (std::size_t i = 0; i < n; ++i) {
+      T x;
+      memcpy(&x, from + i * sizeof(T), sizeof(T));
+      x = Swap(x);
+      memcpy(to + i * sizeof(T), &x, sizeof(T));
+   }
+}
+
+#ifdef R__BSWAP_X86
+/// The shuffle reversing the bytes of each element of Size bytes of a 128-bit lane.
+template <int Size>
+__attribute__((target("ssse3"))) __m128i SwapMask()
+{
+#define R__BSWAP_IDX(j) char((j) / Size * Size + Size - 1 - (j) % Size)
+   return _mm_setr_epi8(R__BSWAP_IDX(0), R__BSWAP_IDX(1), R__BSWAP_IDX(2), R__BSWAP_IDX(3), R__BSWAP_IDX(4),
+                        R__BSWAP_IDX(5), R__BSWAP_IDX(6), R__BSWAP_IDX(7), R__BSWAP_IDX(8), R__BSWAP_IDX(9),
+                        R__BSWAP_IDX(10), R__BSWAP_IDX(11), R__BSWAP_IDX(12), R__BSWAP_IDX(13), R__BSWAP_IDX(14),
+                        R__BSWAP_IDX(15));
+#undef R__BSWAP_IDX
+}
+
+template <typename T>
+__attribute__((target("ssse3"))) void SwapSSSE3(char *to, const char *from, std::size_t n)
+{
+   const __m128i mask = SwapMask<sizeof(T)>();
+   const std::size_t nbytes = n * sizeof(T);
+   std::size_t i = 0;
+   for (; i + 16 <= nbytes; i += 16) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(from + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(to + i), _mm_shuffle_epi8(v, mask));
+   }
+   SwapScalar<T>(to + i, from + i, (nbytes - i) / sizeof(T));
+}
+
+template <typename T>
+__attribute__((target("avx2"))) void SwapAVX2(char *to, const char *from, std::size_t n)
+{
+   // vpshufb shuffles each 128-bit lane on its own: both use the same mask.
+   const __m128i mask128 = SwapMask<sizeof(T)>();
+   const __m256i mask = _mm256_inserti128_si256(_mm256_castsi128_si256(mask128), mask128, 1);
+   const std::size_t nbytes = n * sizeof(T);
+   std::size_t i = 0;
+   for (; i + 64 <= nbytes; i += 64) {
+      __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(from + i));
+      __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(from + i + 32));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(to + i), _mm256_shuffle_epi8(v0, mask));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(to + i + 32), _mm256_shuffle_epi8(v1, mask));
+   }
+   for (; i + 16 <= nbytes; i += 16) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(from + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(to + i), _mm_shuffle_epi8(v, mask128));
+   }
+   SwapScalar<T>(to + i, from + i, (nbytes - i) / sizeof(T));
+}
+#endif
+
+#ifdef R__BSWAP_NEON
+template <typename T>
+uint8x16_t SwapNEON(uint8x16_t v);
+
+template <>
+inline uint8x16_t SwapNEON<std::uint16_t>(uint8x16_t v)
+{
+   return vrev16q_u8(v);
+}
+
+template <>
+inline uint8x16_t SwapNEON<std::uint32_t>(uint8x16_t v)
+{
+   return vrev32q_u8(v);
+}
+
+template <>
+inline uint8x16_t SwapNEON<std::uint64_t>(uint8x16_t v)
+{
+   return vrev64q_u8(v);
+}
+
+template <typename T>
+void SwapNEON(char *to, const char *from, std::size_t n)
+{
+   const std::size_t nbytes = n * sizeof(T);
+   std::size_t i = 0;
+   for (; i + 16 <= nbytes; i += 16) {
+      uint8x16_t v = vld1q_u8(reinterpret_cast<const std::uint8_t *>(from + i));
+      vst1q_u8(reinterpret_cast<std::uint8_t *>(to + i), SwapNEON<T>(v));
+   }
+   SwapScalar<T>(to + i, from + i, (nbytes - i) / sizeof(T));
+}
+#endif
+
+struct Kernels {
+   Kernel_t f16;
+   Kernel_t f32;
+   Kernel_t f64;
+   const char *fName;
+};
+
+const Kernels &GetKernels()
+{
+   static const Kernels kernels = []() -> Kernels {
+#if defined(R__BSWAP_X86)
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2"))
+         return {SwapAVX2<std::uint16_t>, SwapAVX2<std::uint32_t>, SwapAVX2<std::uint64_t>, "avx2"};
+      if (__builtin_cpu_supports("ssse3"))
+         return {SwapSSSE3<std::uint16_t>, SwapSSSE3<std::uint32_t>, SwapSSSE3<std::uint64_t>, "ssse3"};
+#elif defined(R__BSWAP_NEON)
+      return {SwapNEON<std::uint16_t>, SwapNEON<std::uint32_t>, SwapNEON<std::uint64_t>, "neon"};
+#endif
+      return {SwapScalar<std::uint16_t>, SwapScalar<std::uint32_t>, SwapScalar<std::uint64_t>, "scalar"};
+   }();
+   return kernels;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy n elements of 2 bytes, swapping their bytes.
+
+void ROOT::Internal::ByteSwapCopy16(void *to, const void *from, std::size_t n)
+{
+   GetKernels().f16(static_cast<char *>(to), static_cast<const char *>(from), n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy n elements of 4 bytes, swapping their bytes.
+
+void ROOT::Internal::ByteSwapCopy32(void *to, const void *from, std::size_t n)
+{
+   GetKernels().f32(static_cast<char *>(to), static_cast<const char *>(from), n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy n elements of 8 bytes, swapping their bytes.
+
+void ROOT::Internal::ByteSwapCopy64(void *to, const void *from, std::size_t n)
+{
+   GetKernels().f64(static_cast<char *>(to), static_cast<const char *>(from), n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Name of the instruction set used by the ByteSwapCopy functions.
+
+const char *ROOT::Internal::GetByteSwapCopyKernel()
+{
+   return GetKernels().fName;
+}
@@ -0,0 +1,39 @@
+#include "gtest/gtest.h"
+
+#include "ROOT/ByteSwapCopy.hxx"
+
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// Check a byte-swapping copy of n elements of `size` bytes against the
+// byte-by-byte reversal, at every alignment, also in place.
+void CheckByteSwapCopy(void (*copy)(void *, const void *, std::size_t), int size)
+{
+   for (std::size_t n = 0; n < 70; ++n) {
+      for (int offset = 0; offset < 3; ++offset) {
+         std::vector<unsigned char> from(n * size + offset), to(n * size + offset), expected(n * size + offset);
+         for (std::size_t i = 0; i < from.size(); ++i)
+            from[i] = (unsigned char)(7 * i + 3);
+         for (std::size_t e = 0; e < n; ++e)
+            for (int b = 0; b < size; ++b)
+               expected[offset + e * size + b] = from[offset + e * size + size - 1 - b];
+
+         copy(to.data() + offset, from.data() + offset, n);
+         EXPECT_EQ(0, memcmp(to.data() + offset, expected.data() + offset, n * size)) << n << " " << offset;
+         copy(from.data() + offset, from.data() + offset, n);
+         EXPECT_EQ(0, memcmp(from.data() + offset, expected.data() + offset, n * size)) << n << " " << offset;
+      }
+   }
+}
+
+} // anonymous namespace
+
+TEST(ByteSwapCopy, Kernels)
+{
+   EXPECT_NE(nullptr, ROOT::Internal::GetByteSwapCopyKernel());
+   CheckByteSwapCopy(ROOT::Internal::ByteSwapCopy16, 2);
+   CheckByteSwapCopy(ROOT::Internal::ByteSwapCopy32, 4);
+   CheckByteSwapCopy(ROOT::Internal::ByteSwapCopy64, 8);
+}
@@ -25,8 +25,10 @@ namespace ROOT {
 ///    compression usually results in greater compression factors, but takes
 ///    more CPU time and memory when compressing. LZMA memory usage is particularly
 ///    high for compression levels 8 and 9.
-///  - Finally, the LZ4 package results in worse compression ratios
+///  - The LZ4 package results in worse compression ratios
 ///    than ZLIB but achieves much faster decompression rates.
+///  - Finally, the ZSTD package (Zstandard) reaches compression ratios
+///    close to LZMA, with decompression rates close to LZ4.
 ///
 /// The current algorithms support level 1 to 9. The higher the level the greater
 /// the compression and more CPU time and memory resources used during compression.
@@ -38,6 +40,7 @@ namespace ROOT {
 ///   since in the case of LZMA we don't care about compression/decompression speed)
 ///   [207 - 208]
 ///  - LZ4 is recommended to be used with compression level 4 [404]
+///  - ZSTD is recommended to be used with compression level 5 [505]
 
 struct RCompressionSetting {
    struct EDefaults { /// Note: this is only temporarily a struct and will become a enum class hence the name convention
@@ -67,6 +70,7 @@ struct RCompressionSetting {
          kUseMin = 1,
          kDefaultZLIB = 1,
          kDefaultLZ4 = 4,
+         kDefaultZSTD = 5,
          kDefaultOld = 6,
          kDefaultLZMA = 7
       };
@@ -87,6 +91,8 @@ struct RCompressionSetting {
          kOldCompressionAlgo,
          /// Use LZ4 compression
          kLZ4,
+         /// Use ZSTD compression
+         kZSTD,
          /// Undefined compression algorithm (must be kept the last of the list in case a new algorithm is added).
          kUndefined
       };
@@ -107,6 +113,8 @@ enum ECompressionAlgorithm {
    /// Deprecated name, do *not* use:
    kLZ4 = RCompressionSetting::EAlgorithm::kLZ4,
    /// Deprecated name, do *not* use:
+   kZSTD = RCompressionSetting::EAlgorithm::kZSTD,
+   /// Deprecated name, do *not* use:
    kUndefinedCompressionAlgorithm = RCompressionSetting::EAlgorithm::kUndefined
 };
 
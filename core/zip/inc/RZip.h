@@ -33,6 +33,31 @@ extern "C" void R__unzip(int *srcsize, unsigned char *src, int *tgtsize, unsigne
 
 extern "C" int R__unzip_header(int *srcsize, unsigned char *src, int *tgtsize);
 
+/**
+ * Compression with a dictionary trained on samples of similar buffers, see R__zipTrainDictionary.  Only the
+ * ZSTD algorithm uses the dictionary; the other ones ignore it.  A buffer compressed with a dictionary can only be
+ * decompressed with R__unzipDict and the same dictionary.
+ */
+extern "C" void R__zipMultipleAlgorithmDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep,
+                                            ROOT::RCompressionSetting::EAlgorithm::EValues, const char *dict,
+                                            int dictsize);
+
+extern "C" void R__unzipDict(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep,
+                             const char *dict, int dictsize);
+
+/**
+ * Train a dictionary of at most dictsize bytes from nsamples buffers stored one after the other in samples.
+ * Return the size of the dictionary written in dict, or 0 if the algorithm does not support dictionaries or
+ * if the training failed (e.g. for lack of samples).
+ */
+extern "C" int R__zipTrainDictionary(ROOT::RCompressionSetting::EAlgorithm::EValues, const char *samples,
+                                     const int *samplesizes, int nsamples, char *dict, int dictsize);
+
+/**
+ * Return the ID of the dictionary needed to decompress the buffer, 0 if it does not need one.
+ */
+extern "C" unsigned int R__unzip_dictionary_id(unsigned char *src, int srcsize);
+
 enum { kMAXZIPBUF = 0xffffff };
 
 #endif
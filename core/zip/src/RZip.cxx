@@ -12,6 +12,7 @@
 #include "Bits.h"
 #include "ZipLZMA.h"
 #include "ZipLZ4.h"
+#include "ZipZSTD.h"
 
 #include "zlib.h"
 
@@ -37,6 +38,7 @@ static void R__unzipZLIB(int *srcsize, unsigned char *src, int *tgtsize, unsigne
    R__ZipMode = 1 : ZLIB compression algorithm is used (default)
    R__ZipMode = 2 : LZMA compression algorithm is used
    R__ZipMode = 4 : LZ4  compression algorithm is used
+   R__ZipMode = 5 : ZSTD compression algorithm is used
    R__ZipMode = 0 or 3 : a very old compression algorithm is used
    (the very old algorithm is supported for backward compatibility)
    The LZMA algorithm requires the external XZ package be installed when linking
@@ -46,9 +48,14 @@ static void R__unzipZLIB(int *srcsize, unsigned char *src, int *tgtsize, unsigne
   The LZ4 algorithm requires the external LZ4 package to be installed when linking
   is done.  LZ4 typically has the worst compression ratios, but much faster decompression
   speeds - sometimes by an order of magnitude.
+
+  The ZSTD algorithm uses the external ZSTD package, or its builtin copy.  ZSTD
+  compresses almost as well as LZMA, and decompresses almost as fast as LZ4.
 */
 #ifdef R__HAS_DEFAULT_LZ4
 ROOT::RCompressionSetting::EAlgorithm::EValues R__ZipMode = ROOT::RCompressionSetting::EAlgorithm::EValues::kLZ4;
+#elif defined(R__HAS_DEFAULT_ZSTD)
+ROOT::RCompressionSetting::EAlgorithm::EValues R__ZipMode = ROOT::RCompressionSetting::EAlgorithm::EValues::kZSTD;
 #else
 ROOT::RCompressionSetting::EAlgorithm::EValues R__ZipMode = ROOT::RCompressionSetting::EAlgorithm::EValues::kZLIB;
 #endif
@@ -72,9 +79,19 @@ unsigned long R__crc32(unsigned long crc, const unsigned char* buf, unsigned int
 /*                      1 = zlib */
 /*                      2 = lzma */
 /*                      3 = old */
+/*                      4 = lz4 */
+/*                      5 = zstd */
 void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, ROOT::RCompressionSetting::EAlgorithm::EValues compressionAlgorithm)
      /* int cxlevel;                      compression level */
 {
+   R__zipMultipleAlgorithmDict(cxlevel, srcsize, src, tgtsize, tgt, irep, compressionAlgorithm, nullptr, 0);
+}
+
+/* dict, dictsize:                   dictionary for ZSTD, ignored by the other algorithms */
+void R__zipMultipleAlgorithmDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep,
+                                 ROOT::RCompressionSetting::EAlgorithm::EValues compressionAlgorithm,
+                                 const char *dict, int dictsize)
+{
 
   if (*srcsize < 1 + HDRSIZE + 1) {
      *irep = 0;
@@ -97,6 +114,9 @@ void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize,
   } else if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kLZ4) {
      R__zipLZ4(cxlevel, srcsize, src, tgtsize, tgt, irep);
      return;
+  } else if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kZSTD) {
+     R__zipZSTDDict(cxlevel, srcsize, src, tgtsize, tgt, irep, dict, dictsize);
+     return;
   } else if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kOldCompressionAlgo || compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kUseGlobal) {
      R__zipOld(cxlevel, srcsize, src, tgtsize, tgt, irep);
      return;
@@ -266,10 +286,15 @@ static int is_valid_header_lz4(unsigned char *src)
    return src[0] == 'L' && src[1] == '4';
 }
 
+static int is_valid_header_zstd(unsigned char *src)
+{
+   return src[0] == 'Z' && src[1] == 'S' && src[2] == 1;
+}
+
 static int is_valid_header(unsigned char *src)
 {
    return is_valid_header_zlib(src) || is_valid_header_old(src) || is_valid_header_lzma(src) ||
-          is_valid_header_lz4(src);
+          is_valid_header_lz4(src) || is_valid_header_zstd(src);
 }
 
 int R__unzip_header(int *srcsize, uch *src, int *tgtsize)
@@ -313,6 +338,11 @@ int R__unzip_header(int *srcsize, uch *src, int *tgtsize)
 // N.B. (Brian) - I have kept the original note out of complete awe of the
 // age of the original code...
 void R__unzip(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep)
+{
+  R__unzipDict(srcsize, src, tgtsize, tgt, irep, nullptr, 0);
+}
+
+void R__unzipDict(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep, const char *dict, int dictsize)
 {
   long isize;
   uch  *ibufptr,*obufptr;
@@ -361,6 +391,9 @@ void R__unzip(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep)
   } else if (is_valid_header_lz4(src)) {
      R__unzipLZ4(srcsize, src, tgtsize, tgt, irep);
      return;
+  } else if (is_valid_header_zstd(src)) {
+     R__unzipZSTDDict(srcsize, src, tgtsize, tgt, irep, dict, dictsize);
+     return;
   }
 
   /* Old zlib format */
@@ -413,3 +446,23 @@ void R__unzipZLIB(int *srcsize, unsigned char *src, int *tgtsize, unsigned char
      *irep = stream.total_out;
      return;
 }
+
+int R__zipTrainDictionary(ROOT::RCompressionSetting::EAlgorithm::EValues compressionAlgorithm, const char *samples,
+                          const int *samplesizes, int nsamples, char *dict, int dictsize)
+{
+   if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kUseGlobal) {
+      compressionAlgorithm = R__ZipMode;
+   }
+   if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kZSTD) {
+      return R__trainZSTDDict(samples, samplesizes, nsamples, dict, dictsize);
+   }
+   return 0;
+}
+
+unsigned int R__unzip_dictionary_id(unsigned char *src, int srcsize)
+{
+   if (srcsize > HDRSIZE && is_valid_header_zstd(src)) {
+      return R__getZSTDDictID(src, srcsize);
+   }
+   return 0;
+}
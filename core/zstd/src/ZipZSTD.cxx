@@ -0,0 +1,214 @@
+// @(#)root/zstd:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ZipZSTD.h"
+
+#include "ROOT/RConfig.hxx"
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include <zdict.h>
+#include <zstd.h>
+
+// Header consists of:
+// - 2 byte identifier "ZS"
+// - 1 byte version of the ZSTD header of ROOT (currently 1).
+// - 3 bytes of compressed size
+// - 3 bytes of uncompressed size
+// The ZSTD frame itself carries the content checksum, and the ID of the
+// dictionary it was compressed with, if any.
+static const int kHeaderSize = 9;
+static const char kHeaderVersion = 1;
+
+namespace {
+
+/// The dictionaries digested for compression (ZSTD_CDict, one per level) or
+/// decompression (ZSTD_DDict), kept per thread: digesting a dictionary costs
+/// about as much as compressing a small basket.  They are identified by their
+/// ID and size; dictionaries without ID (raw content) are not cached.
+template <typename DictT, size_t (*FreeT)(DictT *)>
+class RDigestedDictCache {
+   struct Entry {
+      unsigned int fID;
+      int fSize;
+      int fLevel;
+      std::unique_ptr<DictT, size_t (*)(DictT *)> fDict;
+   };
+   static constexpr size_t kMaxEntries = 32;
+   std::vector<Entry> fEntries;
+   size_t fNext = 0;
+
+public:
+   template <typename CreateT>
+   DictT *Get(const char *dict, int dictsize, int level, CreateT create)
+   {
+      const unsigned int id = ZDICT_getDictID(dict, dictsize);
+      if (!id)
+         return nullptr;
+      for (auto &entry : fEntries) {
+         if (entry.fID == id && entry.fSize == dictsize && entry.fLevel == level)
+            return entry.fDict.get();
+      }
+      Entry entry{id, dictsize, level, {create(), FreeT}};
+      if (!entry.fDict)
+         return nullptr;
+      DictT *digested = entry.fDict.get();
+      if (fEntries.size() < kMaxEntries) {
+         fEntries.emplace_back(std::move(entry));
+      } else {
+         fEntries[fNext] = std::move(entry);
+         fNext = (fNext + 1) % kMaxEntries;
+      }
+      return digested;
+   }
+};
+
+} // anonymous namespace
+
+void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+{
+   R__zipZSTDDict(cxlevel, srcsize, src, tgtsize, tgt, irep, nullptr, 0);
+}
+
+void R__zipZSTDDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, const char *dict,
+                    int dictsize)
+{
+   // One context per thread, reused from one buffer to the next.
+   static thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> ctx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+   static thread_local RDigestedDictCache<ZSTD_CDict, ZSTD_freeCDict> cdicts;
+
+   *irep = 0;
+
+   if (R__unlikely(*tgtsize <= kHeaderSize || !ctx)) {
+      return;
+   }
+
+   // Refuse to compress more than 16MB at a time -- we are only allowed 3 bytes for size info.
+   if (R__unlikely(*srcsize > 0xffffff || *srcsize < 0)) {
+      return;
+   }
+
+   if (cxlevel > 9) {
+      cxlevel = 9;
+   }
+   // The ROOT levels 1 to 9 span the ZSTD levels 2 to 18; beyond, ZSTD gets very slow.
+   const int level = 2 * cxlevel;
+   char *dst = &tgt[kHeaderSize];
+   const size_t dstCapacity = static_cast<size_t>(*tgtsize - kHeaderSize);
+   const size_t srcSize = static_cast<size_t>(*srcsize);
+   ZSTD_CDict *cdict = nullptr;
+   if (dict && dictsize > 0) {
+      cdict = cdicts.Get(dict, dictsize, level, [&]() { return ZSTD_createCDict(dict, dictsize, level); });
+   }
+   ZSTD_CCtx_reset(ctx.get(), ZSTD_reset_session_and_parameters);
+   ZSTD_CCtx_setParameter(ctx.get(), ZSTD_c_compressionLevel, level);
+   ZSTD_CCtx_setParameter(ctx.get(), ZSTD_c_checksumFlag, 1);
+   if (cdict) {
+      ZSTD_CCtx_refCDict(ctx.get(), cdict);
+   } else if (dict && dictsize > 0) {
+      ZSTD_CCtx_loadDictionary(ctx.get(), dict, dictsize);
+   }
+   size_t returnStatus = ZSTD_compress2(ctx.get(), dst, dstCapacity, src, srcSize);
+
+   // This includes the case of a target buffer too small: the caller then keeps the data uncompressed.
+   if (R__unlikely(ZSTD_isError(returnStatus))) {
+      return;
+   }
+
+   tgt[0] = 'Z';
+   tgt[1] = 'S';
+   tgt[2] = kHeaderVersion;
+
+   // NOTE: these next 6 bytes are required from the ROOT compressed buffer format;
+   // upper layers will assume they are laid out in a specific manner.
+   size_t out_size = returnStatus; /* compressed size */
+   size_t in_size = (unsigned)(*srcsize);
+   tgt[3] = (char)(out_size & 0xff);
+   tgt[4] = (char)((out_size >> 8) & 0xff);
+   tgt[5] = (char)((out_size >> 16) & 0xff);
+
+   tgt[6] = (char)(in_size & 0xff); /* decompressed size */
+   tgt[7] = (char)((in_size >> 8) & 0xff);
+   tgt[8] = (char)((in_size >> 16) & 0xff);
+
+   *irep = (int)returnStatus + kHeaderSize;
+}
+
+void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
+{
+   R__unzipZSTDDict(srcsize, src, tgtsize, tgt, irep, nullptr, 0);
+}
+
+void R__unzipZSTDDict(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep, const char *dict,
+                      int dictsize)
+{
+   // NOTE: We don't check that srcsize / tgtsize is reasonable or within the ROOT-imposed limits.
+   // This is assumed to be handled by the upper layers.
+
+   static thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> ctx{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+   static thread_local RDigestedDictCache<ZSTD_DDict, ZSTD_freeDDict> ddicts;
+
+   *irep = 0;
+   if (R__unlikely(src[0] != 'Z' || src[1] != 'S')) {
+      fprintf(stderr, "R__unzipZSTD: algorithm run against buffer with incorrect header (got %d%d; expected %d%d).\n",
+              src[0], src[1], 'Z', 'S');
+      return;
+   }
+   if (R__unlikely(src[2] != kHeaderVersion)) {
+      fprintf(stderr, "R__unzipZSTD: unknown version of the ZSTD header (got %d; expected %d).\n", src[2],
+              kHeaderVersion);
+      return;
+   }
+   if (R__unlikely(!ctx)) {
+      fprintf(stderr, "R__unzipZSTD: cannot create the decompression context.\n");
+      return;
+   }
+
+   const size_t srcSize = static_cast<size_t>(*srcsize - kHeaderSize);
+   size_t returnStatus;
+   ZSTD_DDict *ddict = nullptr;
+   if (dict && dictsize > 0) {
+      ddict = ddicts.Get(dict, dictsize, 0, [&]() { return ZSTD_createDDict(dict, dictsize); });
+   }
+   if (ddict) {
+      returnStatus = ZSTD_decompress_usingDDict(ctx.get(), tgt, static_cast<size_t>(*tgtsize), &src[kHeaderSize],
+                                                srcSize, ddict);
+   } else {
+      returnStatus = ZSTD_decompress_usingDict(ctx.get(), tgt, static_cast<size_t>(*tgtsize), &src[kHeaderSize],
+                                               srcSize, dict, dict ? dictsize : 0);
+   }
+   if (R__unlikely(ZSTD_isError(returnStatus))) {
+      fprintf(stderr, "R__unzipZSTD: error in decompression: %s.\n", ZSTD_getErrorName(returnStatus));
+      return;
+   }
+
+   *irep = (int)returnStatus;
+}
+
+int R__trainZSTDDict(const char *samples, const int *samplesizes, int nsamples, char *dict, int dictsize)
+{
+   if (nsamples <= 0 || dictsize <= 0)
+      return 0;
+   std::vector<size_t> sizes(samplesizes, samplesizes + nsamples);
+   size_t returnStatus = ZDICT_trainFromBuffer(dict, dictsize, samples, sizes.data(), nsamples);
+   if (ZDICT_isError(returnStatus)) {
+      // Typically not enough samples, or samples too small.
+      return 0;
+   }
+   return (int)returnStatus;
+}
+
+unsigned int R__getZSTDDictID(unsigned char *src, int srcsize)
+{
+   if (srcsize <= kHeaderSize || src[0] != 'Z' || src[1] != 'S')
+      return 0;
+   return ZSTD_getDictID_fromFrame(&src[kHeaderSize], srcsize - kHeaderSize);
+}
@@ -552,6 +552,53 @@ void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double
    }
 
    Double_t ww = 1;
+
+   // With fixed bins and axes that cannot be extended, the bin of a point does not depend on the points filled
+   // before it: compute the bins of a block of points in a loop that can be vectorized, then fill them.
+   if (!fXaxis.GetXbins()->fN && !fXaxis.CanExtend() && !fYaxis.GetXbins()->fN && !fYaxis.CanExtend()) {
+      const Int_t kBlockSize = 256;
+      Int_t bins[kBlockSize];
+      const Int_t nbinsx = fXaxis.GetNbins();
+      const Int_t nbinsy = fYaxis.GetNbins();
+      const Double_t xmin = fXaxis.GetXmin();
+      const Double_t xmax = fXaxis.GetXmax();
+      const Double_t ymin = fYaxis.GetXmin();
+      const Double_t ymax = fYaxis.GetXmax();
+      for (Int_t first = ifirst; first < ntimes; first += kBlockSize * stride) {
+         const Int_t nblock = TMath::Min(kBlockSize, (ntimes - first + stride - 1) / stride);
+         for (Int_t j = 0; j < nblock; ++j) {
+            const Double_t xj = x[first + j * stride];
+            const Double_t yj = y[first + j * stride];
+            // same as TAxis::FindFixBin
+            const Int_t bx = xj < xmin ? 0 : (!(xj < xmax) ? nbinsx + 1 : 1 + int(nbinsx * (xj - xmin) / (xmax - xmin)));
+            const Int_t by = yj < ymin ? 0 : (!(yj < ymax) ? nbinsy + 1 : 1 + int(nbinsy * (yj - ymin) / (ymax - ymin)));
+            bins[j] = by * (nbinsx + 2) + bx;
+         }
+         for (Int_t j = 0; j < nblock; ++j) {
+            i = first + j * stride;
+            fEntries++;
+            bin = bins[j];
+            if (w) ww = w[i];
+            if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+            if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+            AddBinContent(bin,ww);
+            binx = bin % (nbinsx + 2);
+            biny = bin / (nbinsx + 2);
+            if (binx == 0 || binx > nbinsx || biny == 0 || biny > nbinsy) {
+               if (!GetStatOverflowsBehaviour()) continue;
+            }
+            fTsumw   += ww;
+            fTsumw2  += ww*ww;
+            fTsumwx  += ww*x[i];
+            fTsumwx2 += ww*x[i]*x[i];
+            fTsumwy  += ww*y[i];
+            fTsumwy2 += ww*y[i]*y[i];
+            fTsumwxy += ww*x[i]*y[i];
+         }
+      }
+      return;
+   }
+
    for (i=ifirst;i<ntimes;i+=stride) {
       fEntries++;
       binx = fXaxis.FindBin(x[i]);
@@ -3,6 +3,9 @@
 #include "TH1.h"
 #include "TH1F.h"
 
+#include <limits>
+#include <vector>
+
 // StatOverflows TH1
 TEST(TH1, StatOverflows)
 {
@@ -30,3 +33,29 @@ TEST(TH1, StatOverflows)
    EXPECT_EQ(TH1::EStatOverflows::kConsider, h1.GetStatOverflows());
    EXPECT_EQ(TH1::EStatOverflows::kNeutral,  h2.GetStatOverflows());
 }
+
+// FillN with fixed bins must give the same result as Fill
+TEST(TH1, FillNFixedBins)
+{
+   const Int_t n = 1000;
+   std::vector<Double_t> x(n), w(n);
+   for (Int_t i = 0; i < n; ++i) {
+      x[i] = -1.5 + 0.013 * i;
+      w[i] = 1. + (i % 3);
+   }
+   x[n / 2] = std::numeric_limits<Double_t>::quiet_NaN();
+
+   TH1F href("href", "href", 7, -1, 10);
+   TH1F h("h", "h", 7, -1, 10);
+   for (Int_t i = 0; i < n; ++i)
+      href.Fill(x[i], w[i]);
+   h.FillN(n, x.data(), w.data());
+
+   for (Int_t bin = 0; bin <= href.GetNbinsX() + 1; ++bin) {
+      EXPECT_EQ(href.GetBinContent(bin), h.GetBinContent(bin));
+      EXPECT_EQ(href.GetBinError(bin), h.GetBinError(bin));
+   }
+   EXPECT_EQ(href.GetEntries(), h.GetEntries());
+   EXPECT_EQ(href.GetMean(), h.GetMean());
+   EXPECT_EQ(href.GetStdDev(), h.GetStdDev());
+}
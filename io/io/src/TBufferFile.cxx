@@ -35,15 +35,9 @@ The concrete implementation of TBuffer for writing/reading to/from a ROOT file o
 #include "TInterpreter.h"
 #include "TVirtualMutex.h"
 #include "TROOT.h"
+#include "ROOT/ByteSwapCopy.hxx"
 
-#if (defined(__linux) || defined(__APPLE__)) && defined(__i386__) && \
-     defined(__GNUC__)
-#define USE_BSWAPCPY
-#endif
-
-#ifdef USE_BSWAPCPY
-#include "Bswapcpy.h"
-#endif
+#include <algorithm>
 
 
 const UInt_t kNewClassTag       = 0xFFFFFFFF;
@@ -57,6 +51,57 @@ const Int_t  kMapOffset         = 2;   // first 2 map entries are taken by null
 
 ClassImp(TBufferFile);
 
+namespace {
+
+// Number of values converted at once by R__ReadConverted and R__WriteConverted.
+constexpr Int_t kConvertChunk = 256;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read n values stored in the buffer as 32-bit T, and convert them to Out:
+/// the values are byte-swapped by chunks rather than one by one.
+
+template <typename T, typename Out, typename Convert>
+void R__ReadConverted(char *&buf, Out *to, Int_t n, Convert convert)
+{
+   static_assert(sizeof(T) == 4, "R__ReadConverted reads 32-bit values");
+   T chunk[kConvertChunk];
+   for (Int_t i = 0; i < n; i += kConvertChunk) {
+      const Int_t m = std::min(n - i, kConvertChunk);
+#ifdef R__BYTESWAP
+      ROOT::Internal::ByteSwapCopy32(chunk, buf, m);
+#else
+      memcpy(chunk, buf, m * sizeof(T));
+#endif
+      buf += m * sizeof(T);
+      for (Int_t j = 0; j < m; ++j)
+         to[i + j] = convert(chunk[j]);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert n values to 32-bit T and write them to the buffer, which must be
+/// large enough: the values are byte-swapped by chunks rather than one by one.
+
+template <typename T, typename In, typename Convert>
+void R__WriteConverted(char *&buf, const In *from, Int_t n, Convert convert)
+{
+   static_assert(sizeof(T) == 4, "R__WriteConverted writes 32-bit values");
+   T chunk[kConvertChunk];
+   for (Int_t i = 0; i < n; i += kConvertChunk) {
+      const Int_t m = std::min(n - i, kConvertChunk);
+      for (Int_t j = 0; j < m; ++j)
+         chunk[j] = convert(from[i + j]);
+#ifdef R__BYTESWAP
+      ROOT::Internal::ByteSwapCopy32(buf, chunk, m);
+#else
+      memcpy(buf, chunk, m * sizeof(T));
+#endif
+      buf += m * sizeof(T);
+   }
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Thread-safe check on StreamerInfos of a TClass
 
@@ -762,17 +807,11 @@ Int_t TBufferFile::ReadArray(Short_t *&h)
    if (!h) h = new Short_t[n];
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(h, fBufCur, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy16(h, fBufCur, n);
 #else
    memcpy(h, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -795,17 +834,11 @@ Int_t TBufferFile::ReadArray(Int_t *&ii)
    if (!ii) ii = new Int_t[n];
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(ii, fBufCur, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(ii, fBufCur, n);
 #else
    memcpy(ii, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -854,12 +887,11 @@ Int_t TBufferFile::ReadArray(Long64_t *&ll)
    if (!ll) ll = new Long64_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   ROOT::Internal::ByteSwapCopy64(ll, fBufCur, n);
 #else
    memcpy(ll, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -882,17 +914,11 @@ Int_t TBufferFile::ReadArray(Float_t *&f)
    if (!f) f = new Float_t[n];
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(f, fBufCur, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(f, fBufCur, n);
 #else
    memcpy(f, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -915,12 +941,11 @@ Int_t TBufferFile::ReadArray(Double_t *&d)
    if (!d) d = new Double_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   ROOT::Internal::ByteSwapCopy64(d, fBufCur, n);
 #else
    memcpy(d, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -1035,17 +1060,11 @@ Int_t TBufferFile::ReadStaticArray(Short_t *h)
    if (!h) return 0;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(h, fBufCur, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy16(h, fBufCur, n);
 #else
    memcpy(h, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -1067,17 +1086,11 @@ Int_t TBufferFile::ReadStaticArray(Int_t *ii)
    if (!ii) return 0;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(ii, fBufCur, n);
-   fBufCur += sizeof(Int_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(ii, fBufCur, n);
 #else
    memcpy(ii, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -1124,12 +1137,11 @@ Int_t TBufferFile::ReadStaticArray(Long64_t *ll)
    if (!ll) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   ROOT::Internal::ByteSwapCopy64(ll, fBufCur, n);
 #else
    memcpy(ll, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -1151,17 +1163,11 @@ Int_t TBufferFile::ReadStaticArray(Float_t *f)
    if (!f) return 0;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(f, fBufCur, n);
-   fBufCur += sizeof(Float_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(f, fBufCur, n);
 #else
    memcpy(f, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -1183,12 +1189,11 @@ Int_t TBufferFile::ReadStaticArray(Double_t *d)
    if (!d) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   ROOT::Internal::ByteSwapCopy64(d, fBufCur, n);
 #else
    memcpy(d, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 
    return n;
 }
@@ -1301,17 +1306,11 @@ void TBufferFile::ReadFastArray(Short_t *h, Int_t n)
    if (n <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(h, fBufCur, n);
-   fBufCur += sizeof(Short_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy16(h, fBufCur, n);
 #else
    memcpy(h, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1323,17 +1322,11 @@ void TBufferFile::ReadFastArray(Int_t *ii, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(ii, fBufCur, n);
-   fBufCur += sizeof(Int_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(ii, fBufCur, n);
 #else
    memcpy(ii, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1361,12 +1354,11 @@ void TBufferFile::ReadFastArray(Long64_t *ll, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   ROOT::Internal::ByteSwapCopy64(ll, fBufCur, n);
 #else
    memcpy(ll, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1378,17 +1370,11 @@ void TBufferFile::ReadFastArray(Float_t *f, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(f, fBufCur, n);
-   fBufCur += sizeof(Float_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(f, fBufCur, n);
 #else
    memcpy(f, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1400,12 +1386,11 @@ void TBufferFile::ReadFastArray(Double_t *d, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   ROOT::Internal::ByteSwapCopy64(d, fBufCur, n);
 #else
    memcpy(d, fBufCur, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1420,9 +1405,7 @@ void TBufferFile::ReadFastArrayFloat16(Float_t *f, Int_t n, TStreamerElement *el
       //a range was specified. We read an integer and convert it back to a float
       Double_t xmin = ele->GetXmin();
       Double_t factor = ele->GetFactor();
-      for (int j=0;j < n; j++) {
-         UInt_t aint; *this >> aint; f[j] = (Float_t)(aint/factor + xmin);
-      }
+      R__ReadConverted<UInt_t>(fBufCur, f, n, [=](UInt_t aint) { return (Float_t)(aint/factor + xmin); });
    } else {
       Int_t i;
       Int_t nbits = 0;
@@ -1457,9 +1440,7 @@ void TBufferFile::ReadFastArrayWithFactor(Float_t *ptr, Int_t n, Double_t factor
    if (n <= 0 || 3*n > fBufSize) return;
 
    //a range was specified. We read an integer and convert it back to a float
-   for (int j=0;j < n; j++) {
-      UInt_t aint; *this >> aint; ptr[j] = (Float_t)(aint/factor + minvalue);
-   }
+   R__ReadConverted<UInt_t>(fBufCur, ptr, n, [=](UInt_t aint) { return (Float_t)(aint/factor + minvalue); });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1502,20 +1483,14 @@ void TBufferFile::ReadFastArrayDouble32(Double_t *d, Int_t n, TStreamerElement *
       //a range was specified. We read an integer and convert it back to a double.
       Double_t xmin = ele->GetXmin();
       Double_t factor = ele->GetFactor();
-      for (int j=0;j < n; j++) {
-         UInt_t aint; *this >> aint; d[j] = (Double_t)(aint/factor + xmin);
-      }
+      R__ReadConverted<UInt_t>(fBufCur, d, n, [=](UInt_t aint) { return (Double_t)(aint/factor + xmin); });
    } else {
       Int_t i;
       Int_t nbits = 0;
       if (ele) nbits = (Int_t)ele->GetXmin();
       if (!nbits) {
          //we read a float and convert it to double
-         Float_t afloat;
-         for (i = 0; i < n; i++) {
-            *this >> afloat;
-            d[i] = (Double_t)afloat;
-         }
+         R__ReadConverted<Float_t>(fBufCur, d, n, [](Float_t afloat) { return (Double_t)afloat; });
       } else {
          //we read the exponent and the truncated mantissa of the float
          //and rebuild the double.
@@ -1547,9 +1522,7 @@ void TBufferFile::ReadFastArrayWithFactor(Double_t *d, Int_t n, Double_t factor,
    if (n <= 0 || 3*n > fBufSize) return;
 
    //a range was specified. We read an integer and convert it back to a double.
-   for (int j=0;j < n; j++) {
-      UInt_t aint; *this >> aint; d[j] = (Double_t)(aint/factor + minvalue);
-   }
+   R__ReadConverted<UInt_t>(fBufCur, d, n, [=](UInt_t aint) { return (Double_t)(aint/factor + minvalue); });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1562,11 +1535,7 @@ void TBufferFile::ReadFastArrayWithNbits(Double_t *d, Int_t n, Int_t nbits)
 
    if (!nbits) {
       //we read a float and convert it to double
-      Float_t afloat;
-      for (Int_t i = 0; i < n; i++) {
-         *this >> afloat;
-         d[i] = (Double_t)afloat;
-      }
+      R__ReadConverted<Float_t>(fBufCur, d, n, [](Float_t afloat) { return (Double_t)afloat; });
    } else {
       //we read the exponent and the truncated mantissa of the float
       //and rebuild the double.
@@ -1734,17 +1703,11 @@ void TBufferFile::WriteArray(const Short_t *h, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(fBufCur, h, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy16(fBufCur, h, n);
 #else
    memcpy(fBufCur, h, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1764,17 +1727,11 @@ void TBufferFile::WriteArray(const Int_t *ii, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, ii, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(fBufCur, ii, n);
 #else
    memcpy(fBufCur, ii, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1832,12 +1789,11 @@ void TBufferFile::WriteArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   ROOT::Internal::ByteSwapCopy64(fBufCur, ll, n);
 #else
    memcpy(fBufCur, ll, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1857,17 +1813,11 @@ void TBufferFile::WriteArray(const Float_t *f, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, f, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(fBufCur, f, n);
 #else
    memcpy(fBufCur, f, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1887,12 +1837,11 @@ void TBufferFile::WriteArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   ROOT::Internal::ByteSwapCopy64(fBufCur, d, n);
 #else
    memcpy(fBufCur, d, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2000,17 +1949,11 @@ void TBufferFile::WriteFastArray(const Short_t *h, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(fBufCur, h, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy16(fBufCur, h, n);
 #else
    memcpy(fBufCur, h, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2024,17 +1967,11 @@ void TBufferFile::WriteFastArray(const Int_t *ii, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, ii, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(fBufCur, ii, n);
 #else
    memcpy(fBufCur, ii, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2076,12 +2013,11 @@ void TBufferFile::WriteFastArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   ROOT::Internal::ByteSwapCopy64(fBufCur, ll, n);
 #else
    memcpy(fBufCur, ll, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2095,17 +2031,11 @@ void TBufferFile::WriteFastArray(const Float_t *f, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, f, n);
-   fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
-# endif
+   ROOT::Internal::ByteSwapCopy32(fBufCur, f, n);
 #else
    memcpy(fBufCur, f, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2119,12 +2049,11 @@ void TBufferFile::WriteFastArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   ROOT::Internal::ByteSwapCopy64(fBufCur, d, n);
 #else
    memcpy(fBufCur, d, l);
-   fBufCur += l;
 #endif
+   fBufCur += l;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2145,12 +2074,11 @@ void TBufferFile::WriteFastArrayFloat16(const Float_t *f, Int_t n, TStreamerElem
       Double_t factor = ele->GetFactor();
       Double_t xmin = ele->GetXmin();
       Double_t xmax = ele->GetXmax();
-      for (int j = 0; j < n; j++) {
-         Float_t x = f[j];
+      R__WriteConverted<UInt_t>(fBufCur, f, n, [=](Float_t x) {
          if (x < xmin) x = xmin;
          if (x > xmax) x = xmax;
-         UInt_t aint = UInt_t(0.5+factor*(x-xmin)); *this << aint;
-      }
+         return UInt_t(0.5+factor*(x-xmin));
+      });
    } else {
       Int_t nbits = 0;
       //number of bits stored in fXmin (see TStreamerElement::GetRange)
@@ -2196,12 +2124,11 @@ void TBufferFile::WriteFastArrayDouble32(const Double_t *d, Int_t n, TStreamerEl
       Double_t factor = ele->GetFactor();
       Double_t xmin = ele->GetXmin();
       Double_t xmax = ele->GetXmax();
-      for (int j = 0; j < n; j++) {
-         Double_t x = d[j];
+      R__WriteConverted<UInt_t>(fBufCur, d, n, [=](Double_t x) {
          if (x < xmin) x = xmin;
          if (x > xmax) x = xmax;
-         UInt_t aint = UInt_t(0.5+factor*(x-xmin)); *this << aint;
-      }
+         return UInt_t(0.5+factor*(x-xmin));
+      });
    } else {
       Int_t nbits = 0;
       //number of bits stored in fXmin (see TStreamerElement::GetRange)
@@ -2209,10 +2136,7 @@ void TBufferFile::WriteFastArrayDouble32(const Double_t *d, Int_t n, TStreamerEl
       Int_t i;
       if (!nbits) {
          //if no range and no bits specified, we convert from double to float
-         for (i = 0; i < n; i++) {
-            Float_t afloat = (Float_t)d[i];
-            *this << afloat;
-         }
+         R__WriteConverted<Float_t>(fBufCur, d, n, [](Double_t x) { return (Float_t)x; });
       } else {
          //a range is not specified, but nbits is.
          //In this case we truncate the mantissa to nbits and we stream
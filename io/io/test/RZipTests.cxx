@@ -0,0 +1,179 @@
+#include "Compression.h"
+#include "RZip.h"
+
+#include "gtest/gtest.h"
+
+#include "zlib.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Round trips of the ZLIB algorithm through R__zip and R__unzip. The data exercise the match copies of
+// inflate (including the chunked copies of the accelerated variant of the builtin zlib): overlapping matches of
+// short distance, matches reaching the end of the 32 KiB window, literals and stored blocks.
+
+namespace {
+
+const int kHeaderSize = 9;
+
+// Runs of a random pattern of `period` bytes, i.e. overlapping matches at distance `period`, separated by
+// random literals.
+std::vector<char> ShortDistances(std::mt19937 &gen, int period)
+{
+   std::uniform_int_distribution<int> byte(0, 255);
+   std::uniform_int_distribution<int> runLength(3, 600);
+   std::vector<char> data;
+   while (data.size() < 100000) {
+      for (int i = 0; i < period; ++i)
+         data.push_back(byte(gen));
+      const int length = runLength(gen);
+      for (int i = 0; i < length; ++i)
+         data.push_back(data[data.size() - period]);
+      data.push_back(byte(gen));
+   }
+   return data;
+}
+
+// Random data, with copies of its earlier parts at distances up to the size of the window (32768 bytes).
+std::vector<char> FarMatches(std::mt19937 &gen)
+{
+   std::uniform_int_distribution<int> byte(0, 255);
+   std::vector<char> data;
+   for (int i = 0; i < 40000; ++i)
+      data.push_back(byte(gen));
+   for (int distance : {32768, 32767, 32766, 32000, 30000, 20000, 16384, 4096, 258, 32768, 1000}) {
+      for (int length : {3, 17, 258, 1000}) {
+         for (int i = 0; i < length; ++i)
+            data.push_back(data[data.size() - distance]);
+         for (int i = 0; i < 5; ++i)
+            data.push_back(byte(gen));
+      }
+   }
+   return data;
+}
+
+// Letters of skewed frequencies, with few matches: mostly literals.
+std::vector<char> Literals(std::mt19937 &gen)
+{
+   std::geometric_distribution<int> letter(0.15);
+   std::vector<char> data;
+   for (int i = 0; i < 100000; ++i)
+      data.push_back('a' + std::min(letter(gen), 25));
+   return data;
+}
+
+// Uniformly random bytes: deflate writes stored blocks.
+std::vector<char> Incompressible(std::mt19937 &gen)
+{
+   std::uniform_int_distribution<int> byte(0, 255);
+   std::vector<char> data;
+   for (int i = 0; i < 100000; ++i)
+      data.push_back(byte(gen));
+   return data;
+}
+
+std::vector<char> Zip(std::vector<char> &data, int level)
+{
+   // Room for the stored blocks of incompressible data
+   std::vector<char> zipped(data.size() + data.size() / 100 + 1000);
+   int srcsize = data.size();
+   int tgtsize = zipped.size() - kHeaderSize;
+   int irep = 0;
+   R__zipMultipleAlgorithm(level, &srcsize, data.data(), &tgtsize, zipped.data(), &irep,
+                           ROOT::RCompressionSetting::EAlgorithm::kZLIB);
+   zipped.resize(irep);
+   return zipped;
+}
+
+void ExpectRoundTrip(std::vector<char> &data)
+{
+   for (int level : {1, 6, 9}) {
+      auto zipped = Zip(data, level);
+      ASSERT_GT(zipped.size(), 0u) << "level " << level;
+      EXPECT_EQ('Z', zipped[0]);
+      EXPECT_EQ('L', zipped[1]);
+
+      std::vector<char> unzipped(data.size());
+      int srcsize = zipped.size();
+      int tgtsize = unzipped.size();
+      int irep = 0;
+      R__unzip(&srcsize, reinterpret_cast<unsigned char *>(zipped.data()), &tgtsize,
+               reinterpret_cast<unsigned char *>(unzipped.data()), &irep);
+      EXPECT_EQ(irep, (int)data.size()) << "level " << level;
+      EXPECT_TRUE(unzipped == data) << "level " << level;
+   }
+}
+
+// Inflate the zlib stream of `zipped` giving it at most `chunk` bytes of input and of output space at a time.
+std::vector<char> InflateByChunks(std::vector<char> &zipped, std::size_t size, unsigned int chunk)
+{
+   std::vector<char> out(size);
+   z_stream stream;
+   stream.zalloc = Z_NULL;
+   stream.zfree = Z_NULL;
+   stream.opaque = Z_NULL;
+   stream.next_in = reinterpret_cast<Bytef *>(zipped.data() + kHeaderSize);
+   stream.avail_in = 0;
+   if (inflateInit(&stream) != Z_OK)
+      return {};
+   Bytef *inEnd = reinterpret_cast<Bytef *>(zipped.data() + zipped.size());
+   stream.next_out = reinterpret_cast<Bytef *>(out.data());
+   int err = Z_OK;
+   while (err == Z_OK) {
+      stream.avail_in = std::min<std::size_t>(chunk, inEnd - stream.next_in);
+      stream.avail_out = std::min<std::size_t>(chunk, out.size() - stream.total_out);
+      err = inflate(&stream, Z_NO_FLUSH);
+   }
+   inflateEnd(&stream);
+   if (err != Z_STREAM_END)
+      return {};
+   out.resize(stream.total_out);
+   return out;
+}
+
+} // anonymous namespace
+
+TEST(RZip, ZLIBShortDistances)
+{
+   std::mt19937 gen(1);
+   for (int period = 1; period <= 15; ++period) {
+      auto data = ShortDistances(gen, period);
+      ExpectRoundTrip(data);
+   }
+}
+
+TEST(RZip, ZLIBFarMatches)
+{
+   std::mt19937 gen(2);
+   auto data = FarMatches(gen);
+   ExpectRoundTrip(data);
+}
+
+TEST(RZip, ZLIBLiterals)
+{
+   std::mt19937 gen(3);
+   auto data = Literals(gen);
+   ExpectRoundTrip(data);
+}
+
+TEST(RZip, ZLIBIncompressible)
+{
+   std::mt19937 gen(4);
+   auto data = Incompressible(gen);
+   ExpectRoundTrip(data);
+}
+
+TEST(RZip, ZLIBInflateByChunks)
+{
+   std::mt19937 gen(5);
+   std::vector<std::vector<char>> inputs{ShortDistances(gen, 1), ShortDistances(gen, 7), ShortDistances(gen, 13),
+                                         FarMatches(gen), Literals(gen), Incompressible(gen)};
+   for (auto &data : inputs) {
+      auto zipped = Zip(data, 6);
+      ASSERT_GT(zipped.size(), 0u);
+      for (unsigned int chunk : {1u, 5u, 6u, 7u, 64u, 257u, 258u, 259u, 4096u}) {
+         EXPECT_TRUE(InflateByChunks(zipped, data.size(), chunk) == data) << "chunks of " << chunk << " bytes";
+      }
+   }
+}
@@ -0,0 +1,65 @@
+#include "gtest/gtest.h"
+
+#include "TBufferFile.h"
+#include "TStreamerElement.h"
+#include "TVirtualStreamerInfo.h"
+
+#include <vector>
+
+// Large enough to use the vector kernels, with an odd remainder.
+constexpr Int_t kN = 1003;
+
+template <typename T>
+void CheckFastArray()
+{
+   std::vector<T> values(kN), read(kN);
+   for (Int_t i = 0; i < kN; ++i)
+      values[i] = T(i * 3 - 1000) / T(2);
+
+   TBufferFile wbuf(TBuffer::kWrite);
+   wbuf.WriteFastArray(values.data(), kN);
+   EXPECT_EQ(wbuf.Length(), Int_t(kN * sizeof(T)));
+
+   TBufferFile rbuf(TBuffer::kRead, wbuf.Length(), wbuf.Buffer(), kFALSE);
+   rbuf.ReadFastArray(read.data(), kN);
+   EXPECT_EQ(values, read);
+   EXPECT_EQ(rbuf.Length(), wbuf.Length());
+}
+
+TEST(TBufferFile, FastArrays)
+{
+   CheckFastArray<Short_t>();
+   CheckFastArray<Int_t>();
+   CheckFastArray<Long64_t>();
+   CheckFastArray<Float_t>();
+   CheckFastArray<Double_t>();
+}
+
+TEST(TBufferFile, Double32AndFloat16)
+{
+   std::vector<Double_t> d(kN), dread(kN);
+   std::vector<Float_t> f(kN), fread(kN);
+   for (Int_t i = 0; i < kN; ++i) {
+      d[i] = i / 10.;
+      f[i] = i / 10.f;
+   }
+   TStreamerElement d32("d", "[0,128,20]", 0, TVirtualStreamerInfo::kDouble32, "Double32_t");
+   TStreamerElement f16("f", "[0,128,20]", 0, TVirtualStreamerInfo::kFloat16, "Float16_t");
+
+   TBufferFile wbuf(TBuffer::kWrite);
+   wbuf.WriteFastArrayDouble32(d.data(), kN, nullptr); // as floats
+   wbuf.WriteFastArrayDouble32(d.data(), kN, &d32);    // with a range
+   wbuf.WriteFastArrayFloat16(f.data(), kN, &f16);
+
+   TBufferFile rbuf(TBuffer::kRead, wbuf.Length(), wbuf.Buffer(), kFALSE);
+   rbuf.ReadFastArrayDouble32(dread.data(), kN, nullptr);
+   for (Int_t i = 0; i < kN; ++i)
+      EXPECT_EQ(dread[i], Double_t(Float_t(d[i])));
+   rbuf.ReadFastArrayDouble32(dread.data(), kN, &d32);
+   for (Int_t i = 0; i < kN; ++i)
+      EXPECT_NEAR(dread[i], d[i], 1e-3);
+   rbuf.ReadFastArrayFloat16(fread.data(), kN, &f16);
+   for (Int_t i = 0; i < kN; ++i)
+      EXPECT_NEAR(fread[i], f[i], 1e-3);
+   EXPECT_EQ(rbuf.Length(), wbuf.Length());
+}
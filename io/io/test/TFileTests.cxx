@@ -1,8 +1,14 @@
+#include "Compression.h"
+#include "RZip.h"
 #include "TFile.h"
+#include "TKey.h"
 #include "TSystem.h"
 
 #include "gtest/gtest.h"
 
+#include <memory>
+#include <vector>
+
 // Tests ROOT-9857
 TEST(TFile, ReadFromSameFile)
 {
@@ -22,4 +28,46 @@ TEST(TFile, ReadFromSameFile)
    auto o2 = f2.Get(objpath);
 
    EXPECT_TRUE(o1 != o2) << "Same objects read from two different files have the same pointer!";
-}
\ No newline at end of file
+}
+TEST(TFile, ZSTDCompression)
+{
+   std::vector<char> src(100000);
+   for (size_t i = 0; i < src.size(); ++i)
+      src[i] = (i * 7) % 13 + i / 1000;
+   std::vector<char> tgt(src.size());
+   int srcsize = src.size();
+   int tgtsize = tgt.size();
+   int irep = 0;
+   R__zipMultipleAlgorithm(5, &srcsize, src.data(), &tgtsize, tgt.data(), &irep,
+                           ROOT::RCompressionSetting::EAlgorithm::kZSTD);
+   ASSERT_GT(irep, 0);
+   EXPECT_LT(irep, srcsize);
+   EXPECT_EQ('Z', tgt[0]);
+   EXPECT_EQ('S', tgt[1]);
+
+   std::vector<char> out(src.size());
+   int outsize = out.size();
+   int orep = 0;
+   R__unzip(&irep, reinterpret_cast<unsigned char *>(tgt.data()), &outsize, reinterpret_cast<unsigned char *>(out.data()),
+            &orep);
+   EXPECT_EQ(srcsize, orep);
+   EXPECT_EQ(src, out);
+
+   const auto filename = "ZSTDCompression.root";
+   {
+      TFile f(filename, "RECREATE", "", ROOT::CompressionSettings(ROOT::kZSTD, 5));
+      EXPECT_EQ(ROOT::RCompressionSetting::EAlgorithm::kZSTD, f.GetCompressionAlgorithm());
+      f.WriteObject(&src, "src");
+   }
+   {
+      TFile f(filename);
+      EXPECT_EQ(ROOT::RCompressionSetting::EAlgorithm::kZSTD, f.GetCompressionAlgorithm());
+      TKey *key = f.GetKey("src");
+      ASSERT_NE(key, nullptr);
+      EXPECT_LT(key->GetNbytes() - key->GetKeylen(), key->GetObjlen());
+      std::unique_ptr<std::vector<char>> read(f.Get<std::vector<char>>("src"));
+      ASSERT_NE(read, nullptr);
+      EXPECT_EQ(src, *read);
+   }
+   gSystem->Unlink(filename);
+}
@@ -49,6 +49,7 @@
 //  - 3 - "old ROOT algorithm"  A variant of zlib; do not use, kept for
 //        backwards compatability.
 //  - 4 - LZ4.
+//  - 5 - ZSTD.
 //  In this example, one loops over nevent events.
 //  The branch "event" is created at the first event.
 //  The branch address is set for all other events.
@@ -123,6 +124,8 @@ int main(int argc, char **argv)
    Int_t enable_imt = 0;   // Whether to enable IMT mode.
 #ifdef R__HAS_DEFAULT_LZ4
    Int_t compAlg = 4; // Allow user to specify underlying compression algorithm.
+#elif defined(R__HAS_DEFAULT_ZSTD)
+   Int_t compAlg = 5;
 #else
    Int_t compAlg = 1;
 #endif
@@ -363,6 +363,11 @@ void stress2()
       Long64_t lastgood = 10733;
       if (last < lastgood - 200 || last > lastgood + 200 || comp < 1.5 || comp > 2.1)
          OK = kFALSE;
+#elif defined(R__HAS_DEFAULT_ZSTD)
+      // The level of ZSTD differs from the one of zlib: wider bounds until the reference is taken from a ZSTD build.
+      Long64_t lastgood = 9700;
+      if (last < lastgood - 600 || last > lastgood + 600 || comp < 1.9 || comp > 2.7)
+         OK = kFALSE;
 #else
 #ifdef R__HAS_CLOUDFLARE_ZLIB
       Long64_t lastgood = 9813;
@@ -411,6 +416,12 @@ void stress3()
       constexpr Long64_t difflastgoodlz4 = 5500;
       if (last < lastgood - tolerance || last > lastgood + difflastgoodlz4 + tolerance || comp < 1.5 || comp > 2.1)
          OK = kFALSE;
+#elif defined(R__HAS_DEFAULT_ZSTD)
+      constexpr Long64_t difflastgoodzstd = -1500;
+      constexpr Long64_t tolerancezstd = 2000;
+      if (last < lastgood + difflastgoodzstd - tolerancezstd || last > lastgood + difflastgoodzstd + tolerancezstd ||
+          comp < 1.8 || comp > 2.7)
+         OK = kFALSE;
 #else
       if (last < lastgood - tolerance || last > lastgood + tolerance || comp < 1.8 || comp > 2.4)
          OK = kFALSE;
@@ -422,6 +433,10 @@ void stress3()
       printf("%-8s LZ4 file size= %lld (expected %lld +/- %lld)\n"
              "%-8s Comp Fact=  %3.2f (expected 1.8 +/- 0.3)\n",
              " ", last, lastgood + difflastgoodlz4, tolerance, " ", comp);
+#elif defined(R__HAS_DEFAULT_ZSTD)
+      printf("%-8s ZSTD file size= %lld (expected %lld +/- %lld)\n"
+             "%-8s Comp Fact=  %3.2f (expected 2.25 +/- 0.45)\n",
+             " ", last, lastgood + difflastgoodzstd, tolerancezstd, " ", comp);
 #else
        printf("%-8s File size= %lld (expected %lld +/- %lld)\n"
              "%-8s Comp Fact=  %3.2f (expected 2.1 +/- 0.3)\n",
@@ -15,8 +15,8 @@
 #include "ROOT/RDataSource.hxx"
 
 #include <deque>
-#include <list>
 #include <map>
+#include <string>
 #include <vector>
 
 #include <TRegexp.h>
@@ -42,9 +42,17 @@ private:
    ULong64_t fProcessedLines = 0ULL; // marks the progress of the consumption of the csv lines
    std::vector<std::string> fHeaders;
    std::map<std::string, ColType_t> fColTypes;
-   std::list<ColType_t> fColTypesList;
+   std::vector<ColType_t> fColTypesList;                   // fColTypesList[column]
    std::vector<std::vector<void *>> fColAddresses;         // fColAddresses[column][slot]
-   std::vector<Record_t> fRecords;                         // fRecords[entry][column]
+   std::string fLeftover;              // bytes read from the stream beyond the last line of the current chunk
+   ULong64_t fChunkFirstEntry = 0ULL;  // entry number of the first record of the current chunk
+   ULong64_t fNRecords = 0ULL;         // number of records in the current chunk
+   // Records of the current chunk, stored column-wise: only the vector matching the type of a column is filled
+   std::vector<std::vector<double>> fDoubleColumns;        // fDoubleColumns[column][record]
+   std::vector<std::vector<Long64_t>> fLong64Columns;      // fLong64Columns[column][record]
+   std::vector<std::vector<std::string>> fStringColumns;   // fStringColumns[column][record]
+   // This is a vector of char rather than of bool so that different records can be written concurrently
+   std::vector<std::vector<char>> fBoolColumns;            // fBoolColumns[column][record]
    std::vector<std::vector<double>> fDoubleEvtValues;      // one per column per slot
    std::vector<std::vector<Long64_t>> fLong64EvtValues;    // one per column per slot
    std::vector<std::vector<std::string>> fStringEvtValues; // one per column per slot
@@ -55,7 +63,10 @@ private:
    static TRegexp intRegex, doubleRegex1, doubleRegex2, trueRegex, falseRegex;
 
    void FillHeaders(const std::string &);
-   void FillRecord(const std::string &, Record_t &);
+   ULong64_t ReadChunk(std::string &);
+   void ParseChunk(const std::string &);
+   void ParseRecord(const char *, std::size_t, ULong64_t, std::string &);
+   void StoreValue(const std::string &, unsigned int, ULong64_t);
    void GenerateHeaders(size_t);
    std::vector<void *> GetColumnReadersImpl(std::string_view, const std::type_info &);
    void InferColTypes(std::vector<std::string> &);
@@ -12,8 +12,10 @@
 #define ROOT_RDFOPERATIONS
 
 #include <algorithm>
+#include <array>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -37,10 +39,14 @@
 #include "TDirectory.h"
 #include "TFile.h" // for SnapshotHelper
 #include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
 #include "TGraph.h"
 #include "TLeaf.h"
 #include "TObjArray.h"
 #include "TObject.h"
+#include "TProfile.h"
+#include "TProfile2D.h"
 #include "TTree.h"
 #include "TTreeReader.h" // for SnapshotHelper
 
@@ -254,54 +260,190 @@ extern template void FillHelper::Exec(unsigned int, const std::vector<int> &, co
 extern template void
 FillHelper::Exec(unsigned int, const std::vector<unsigned int> &, const std::vector<unsigned int> &);
 
+/// Number of coordinates of the points with which objects of type HIST are filled in bulk by FillParHelper.
+/// 0 means that values are not buffered and `HIST::Fill` is called once per value.
+template <typename HIST>
+struct FillBufferDim {
+   static constexpr unsigned int value =
+      std::is_base_of<::TH3, HIST>::value || std::is_base_of<::TProfile2D, HIST>::value
+         ? 3
+         : (std::is_base_of<::TH2, HIST>::value || std::is_base_of<::TProfile, HIST>::value
+               ? 2
+               : (std::is_base_of<::TH1, HIST>::value ? 1 : 0));
+};
+
+bool MustShareFillObject(const ::TH1 &h, unsigned int nSlots);
+
+template <typename HIST>
+bool MustShareFillObject(const HIST &h, unsigned int nSlots, std::true_type /*isTH1*/)
+{
+   return MustShareFillObject(static_cast<const ::TH1 &>(h), nSlots);
+}
+
+template <typename HIST>
+bool MustShareFillObject(const HIST &, unsigned int, std::false_type /*isTH1*/)
+{
+   return false;
+}
+
+/// Fill one object per slot, then merge them at the end of the event loop.
+/// For histograms, values are buffered per slot and filled in bulk (via `FillN` where available) every
+/// kBufSize entries, which amortizes the cost of the virtual `Fill` calls and of the bin lookups.
+/// If the per-slot clones of a histogram would exceed the memory budget set by the `RDataFrame.MaxHistoCloneMemory`
+/// rootrc variable (in MB), no clones are made: all slots fill the same histogram, one buffer at a time.
 template <typename HIST = Hist_t>
 class FillParHelper : public RActionImpl<FillParHelper<HIST>> {
+   static constexpr unsigned int kBufDim = FillBufferDim<HIST>::value;
+   static constexpr std::size_t kBufSize = 1024; ///< Number of entries buffered per slot before they are filled in bulk
+   /// One buffer per coordinate plus one for the weights, which stays empty for unweighted filling
+   using Buffers_t = std::array<std::vector<double>, kBufDim + 1>;
+
    std::vector<HIST *> fObjects;
+   std::vector<Buffers_t> fBuffers;
+   /// True if all slots fill the same object, fObjects[0]. Concurrent bulk fills are then serialized by fMutex.
+   bool fIsShared = false;
+   std::unique_ptr<std::mutex> fMutex;
+
+   // Values that cannot be buffered are passed to HIST::Fill as they come
+   template <typename... Xs>
+   void FillOrBuffer(std::false_type /*canBuffer*/, unsigned int slot, Xs... xs)
+   {
+      if (fIsShared) {
+         std::lock_guard<std::mutex> lock(*fMutex);
+         fObjects[slot]->Fill(xs...);
+      } else {
+         fObjects[slot]->Fill(xs...);
+      }
+   }
+
+   template <typename... Xs>
+   void FillOrBuffer(std::true_type /*canBuffer*/, unsigned int slot, Xs... xs)
+   {
+      auto &buffers = fBuffers[slot];
+      const double values[] = {static_cast<double>(xs)...};
+      for (auto i = 0u; i < sizeof...(Xs); ++i)
+         buffers[i].emplace_back(values[i]);
+      if (buffers[0].size() == kBufSize)
+         Flush(slot);
+   }
+
+   /// Fill the object of this slot with one point: either the kBufDim coordinates, or the coordinates and a weight.
+   template <typename... Xs>
+   void FillImpl(unsigned int slot, Xs... xs)
+   {
+      constexpr bool canBuffer = kBufDim > 0 && (sizeof...(Xs) == kBufDim || sizeof...(Xs) == kBufDim + 1);
+      FillOrBuffer(std::integral_constant<bool, canBuffer>{}, slot, xs...);
+   }
+
+   // Bulk filling. These are templates so that they are only instantiated for the kBufDim that is actually used.
+   template <typename H>
+   static void FillBulk(H &h, Buffers_t &b, std::size_t n, const double *w, std::integral_constant<unsigned int, 1>)
+   {
+      h.FillN(static_cast<Int_t>(n), b[0].data(), w);
+   }
+
+   template <typename H>
+   static void FillBulk(H &h, Buffers_t &b, std::size_t n, const double *w, std::integral_constant<unsigned int, 2>)
+   {
+      h.FillN(static_cast<Int_t>(n), b[0].data(), b[1].data(), w);
+   }
+
+   // there is no FillN for 3D histograms and 2D profiles: still, the virtual call happens in a tight loop
+   template <typename H>
+   static void FillBulk(H &h, Buffers_t &b, std::size_t n, const double *w, std::integral_constant<unsigned int, 3>)
+   {
+      if (w) {
+         for (std::size_t i = 0; i < n; ++i)
+            h.Fill(b[0][i], b[1][i], b[2][i], w[i]);
+      } else {
+         for (std::size_t i = 0; i < n; ++i)
+            h.Fill(b[0][i], b[1][i], b[2][i]);
+      }
+   }
+
+   template <typename H>
+   static void FillBulk(H &, Buffers_t &, std::size_t, const double *, std::integral_constant<unsigned int, 0>)
+   {
+   }
+
+   /// Fill the object of this slot with the content of the buffers of this slot, then clear them.
+   void Flush(unsigned int slot)
+   {
+      if (fBuffers.empty())
+         return;
+      auto &buffers = fBuffers[slot];
+      const auto n = buffers[0].size();
+      if (n == 0)
+         return;
+      const auto &wBuffer = buffers[kBufDim];
+      const double *w = wBuffer.empty() ? nullptr : wBuffer.data();
+      if (fIsShared) {
+         std::lock_guard<std::mutex> lock(*fMutex);
+         FillBulk(*fObjects[slot], buffers, n, w, std::integral_constant<unsigned int, kBufDim>{});
+      } else {
+         FillBulk(*fObjects[slot], buffers, n, w, std::integral_constant<unsigned int, kBufDim>{});
+      }
+      for (auto &b : buffers)
+         b.clear();
+   }
 
 public:
    FillParHelper(FillParHelper &&) = default;
    FillParHelper(const FillParHelper &) = delete;
 
-   FillParHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots) : fObjects(nSlots, nullptr)
+   FillParHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots)
+      : fObjects(nSlots, nullptr), fMutex(new std::mutex)
    {
       fObjects[0] = h.get();
+      fIsShared = MustShareFillObject(*h, nSlots, std::is_base_of<::TH1, HIST>{});
       // Initialise all other slots
       for (unsigned int i = 1; i < nSlots; ++i) {
+         if (fIsShared) {
+            fObjects[i] = fObjects[0];
+            continue;
+         }
          fObjects[i] = new HIST(*fObjects[0]);
          if (auto objAsHist = dynamic_cast<TH1*>(fObjects[i])) {
             objAsHist->SetDirectory(nullptr);
          }
       }
+      if (kBufDim > 0) {
+         fBuffers.resize(nSlots);
+         for (auto &buffers : fBuffers)
+            for (auto &b : buffers)
+               b.reserve(kBufSize);
+      }
    }
 
    void InitTask(TTreeReader *, unsigned int) {}
 
+   void FinalizeTask(unsigned int slot) { Flush(slot); }
+
    void Exec(unsigned int slot, double x0) // 1D histos
    {
-      fObjects[slot]->Fill(x0);
+      FillImpl(slot, x0);
    }
 
    void Exec(unsigned int slot, double x0, double x1) // 1D weighted and 2D histos
    {
-      fObjects[slot]->Fill(x0, x1);
+      FillImpl(slot, x0, x1);
    }
 
    void Exec(unsigned int slot, double x0, double x1, double x2) // 2D weighted and 3D histos
    {
-      fObjects[slot]->Fill(x0, x1, x2);
+      FillImpl(slot, x0, x1, x2);
    }
 
    void Exec(unsigned int slot, double x0, double x1, double x2, double x3) // 3D weighted histos
    {
-      fObjects[slot]->Fill(x0, x1, x2, x3);
+      FillImpl(slot, x0, x1, x2, x3);
    }
 
    template <typename X0, typename std::enable_if<IsContainer<X0>::value, int>::type = 0>
    void Exec(unsigned int slot, const X0 &x0s)
    {
-      auto thisSlotH = fObjects[slot];
       for (auto &x0 : x0s) {
-         thisSlotH->Fill(x0); // TODO: Can be optimised in case T == vector<double>
+         FillImpl(slot, x0); // TODO: Can be optimised in case T == vector<double>
       }
    }
 
@@ -318,7 +460,6 @@ public:
              typename std::enable_if<IsContainer<X0>::value && IsContainer<X1>::value, int>::type = 0>
    void Exec(unsigned int slot, const X0 &x0s, const X1 &x1s)
    {
-      auto thisSlotH = fObjects[slot];
       if (x0s.size() != x1s.size()) {
          throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
       }
@@ -326,7 +467,7 @@ public:
       const auto x0sEnd = std::end(x0s);
       auto x1sIt = std::begin(x1s);
       for (; x0sIt != x0sEnd; x0sIt++, x1sIt++) {
-         thisSlotH->Fill(*x0sIt, *x1sIt); // TODO: Can be optimised in case T == vector<double>
+         FillImpl(slot, *x0sIt, *x1sIt); // TODO: Can be optimised in case T == vector<double>
       }
    }
 
@@ -334,9 +475,8 @@ public:
              typename std::enable_if<IsContainer<X0>::value && !IsContainer<W>::value, int>::type = 0>
    void Exec(unsigned int slot, const X0 &x0s, const W w)
    {
-      auto thisSlotH = fObjects[slot];
       for (auto &&x : x0s) {
-         thisSlotH->Fill(x, w);
+         FillImpl(slot, x, w);
       }
    }
 
@@ -345,7 +485,6 @@ public:
                                      int>::type = 0>
    void Exec(unsigned int slot, const X0 &x0s, const X1 &x1s, const X2 &x2s)
    {
-      auto thisSlotH = fObjects[slot];
       if (!(x0s.size() == x1s.size() && x1s.size() == x2s.size())) {
          throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
       }
@@ -354,7 +493,7 @@ public:
       auto x1sIt = std::begin(x1s);
       auto x2sIt = std::begin(x2s);
       for (; x0sIt != x0sEnd; x0sIt++, x1sIt++, x2sIt++) {
-         thisSlotH->Fill(*x0sIt, *x1sIt, *x2sIt); // TODO: Can be optimised in case T == vector<double>
+         FillImpl(slot, *x0sIt, *x1sIt, *x2sIt); // TODO: Can be optimised in case T == vector<double>
       }
    }
 
@@ -363,7 +502,6 @@ public:
                                      int>::type = 0>
    void Exec(unsigned int slot, const X0 &x0s, const X1 &x1s, const W w)
    {
-      auto thisSlotH = fObjects[slot];
       if (x0s.size() != x1s.size()) {
          throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
       }
@@ -371,7 +509,7 @@ public:
       const auto x0sEnd = std::end(x0s);
       auto x1sIt = std::begin(x1s);
       for (; x0sIt != x0sEnd; x0sIt++, x1sIt++) {
-         thisSlotH->Fill(*x0sIt, *x1sIt, w); // TODO: Can be optimised in case T == vector<double>
+         FillImpl(slot, *x0sIt, *x1sIt, w); // TODO: Can be optimised in case T == vector<double>
       }
    }
 
@@ -381,7 +519,6 @@ public:
                                      int>::type = 0>
    void Exec(unsigned int slot, const X0 &x0s, const X1 &x1s, const X2 &x2s, const X3 &x3s)
    {
-      auto thisSlotH = fObjects[slot];
       if (!(x0s.size() == x1s.size() && x1s.size() == x2s.size() && x1s.size() == x3s.size())) {
          throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
       }
@@ -391,7 +528,7 @@ public:
       auto x2sIt = std::begin(x2s);
       auto x3sIt = std::begin(x3s);
       for (; x0sIt != x0sEnd; x0sIt++, x1sIt++, x2sIt++, x3sIt++) {
-         thisSlotH->Fill(*x0sIt, *x1sIt, *x2sIt, *x3sIt); // TODO: Can be optimised in case T == vector<double>
+         FillImpl(slot, *x0sIt, *x1sIt, *x2sIt, *x3sIt); // TODO: Can be optimised in case T == vector<double>
       }
    }
 
@@ -401,7 +538,6 @@ public:
                                      int>::type = 0>
    void Exec(unsigned int slot, const X0 &x0s, const X1 &x1s, const X2 &x2s, const W w)
    {
-      auto thisSlotH = fObjects[slot];
       if (!(x0s.size() == x1s.size() && x1s.size() == x2s.size())) {
          throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
       }
@@ -410,7 +546,7 @@ public:
       auto x1sIt = std::begin(x1s);
       auto x2sIt = std::begin(x2s);
       for (; x0sIt != x0sEnd; x0sIt++, x1sIt++, x2sIt++) {
-         thisSlotH->Fill(*x0sIt, *x1sIt, *x2sIt, w);
+         FillImpl(slot, *x0sIt, *x1sIt, *x2sIt, w);
       }
    }
 
@@ -418,8 +554,13 @@ public:
 
    void Finalize()
    {
-      auto resObj = fObjects[0];
       const auto nSlots = fObjects.size();
+      for (unsigned int slot = 0; slot < nSlots; ++slot)
+         Flush(slot);
+      if (fIsShared)
+         return;
+
+      auto resObj = fObjects[0];
       TList l;
       l.SetOwner(); // The list will free the memory associated to its elements upon destruction
       for (unsigned int slot = 1; slot < nSlots; ++slot) {
@@ -429,7 +570,11 @@ public:
       resObj->Merge(&l);
    }
 
-   HIST &PartialUpdate(unsigned int slot) { return *fObjects[slot]; }
+   HIST &PartialUpdate(unsigned int slot)
+   {
+      Flush(slot);
+      return *fObjects[slot];
+   }
 
    std::string GetActionName() { return "FillPar"; }
 };
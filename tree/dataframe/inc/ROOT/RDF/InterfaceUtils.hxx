@@ -76,6 +76,19 @@ HeadNode_t CreateSnaphotRDF(const ColumnNames_t &validCols,
 
 std::string DemangleTypeIdName(const std::type_info &typeInfo);
 
+std::string GetPersistentCacheFileName(std::string_view cacheDir, const std::vector<std::string> &fingerprints);
+
+bool HasPersistentCacheFile(const std::string &fileName);
+
+std::string GetPersistentCacheTmpFileName(const std::string &fileName);
+
+void CommitPersistentCacheFile(const std::string &tmpFileName, const std::string &fileName);
+
+std::shared_ptr<RLoopManager> OpenPersistentCache(const std::string &fileName);
+
+/// Name of the TTree that holds the cached columns in the files written by RInterface::PersistentCache.
+constexpr const char *kPersistentCacheTreeName = "RDFPersistentCache";
+
 ColumnNames_t ConvertRegexToColumns(const RDFInternal::RBookedCustomColumns &customColumns, TTree *tree,
                                     ROOT::RDF::RDataSource *dataSource, std::string_view columnNameRegexp,
                                     std::string_view callerName);
@@ -17,6 +17,7 @@
 #include "ROOT/RDF/Utils.hxx"      // ColumnNames_t
 #include "ROOT/RDF/RColumnValue.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RDataSource.hxx"
 
 #include <cstddef> // std::size_t
 #include <memory>
@@ -149,6 +150,21 @@ public:
          static_cast<Action_t *>(this)->Exec(slot, entry, TypeInd_t());
    }
 
+   void RunFused(unsigned int slot, ULong64_t begin, ULong64_t end, ROOT::RDF::RDataSource *ds) final
+   {
+      for (auto entry = begin; entry < end && !fLoopManager->HasStoppedProcessing(); ++entry) {
+         if (ds && !ds->SetEntry(slot, entry))
+            continue;
+         RActionCRTP::Run(slot, entry);
+      }
+   }
+
+   void RunFused(unsigned int slot, TTreeReader &r, Long64_t firstEntry) final
+   {
+      while (!fLoopManager->HasStoppedProcessing() && r.Next())
+         RActionCRTP::Run(slot, firstEntry < 0 ? r.GetCurrentEntry() : firstEntry++);
+   }
+
    void TriggerChildrenCount() final { fPrevData.IncrChildrenCount(); }
 
    void FinalizeSlot(unsigned int slot) final
@@ -20,6 +20,10 @@
 
 namespace ROOT {
 
+namespace RDF {
+class RDataSource;
+}
+
 namespace Detail {
 namespace RDF {
 class RLoopManager;
@@ -65,6 +69,14 @@ public:
    RLoopManager *GetLoopManager() { return fLoopManager; }
    unsigned int GetNSlots() const { return fNSlots; }
    virtual void Run(unsigned int slot, Long64_t entry) = 0;
+   /// Run the action on the entries [begin, end), or until all branches of the graph stopped processing entries.
+   /// If a data-source is passed, the entries for which its SetEntry returns false are skipped.
+   /// This is the fused event loop of a graph made of this action and its upstream nodes only, see
+   /// RLoopManager::Run: the per-entry call chain is instantiated in a single loop.
+   virtual void RunFused(unsigned int slot, ULong64_t begin, ULong64_t end, ROOT::RDF::RDataSource *ds) = 0;
+   /// Run the action on the remaining entries of a TTreeReader, or until all branches of the graph stopped processing
+   /// entries. Entries are numbered from `firstEntry`, or as the reader does if `firstEntry` is negative.
+   virtual void RunFused(unsigned int slot, TTreeReader &r, Long64_t firstEntry) = 0;
    virtual void Initialize() = 0;
    virtual void InitSlot(TTreeReader *r, unsigned int slot) = 0;
    virtual void TriggerChildrenCount() = 0;
@@ -21,7 +21,9 @@
 #include "RtypesCore.h"
 
 #include <deque>
+#include <string>
 #include <type_traits>
+#include <typeinfo>
 #include <vector>
 
 class TTreeReader;
@@ -119,13 +121,9 @@ public:
 
    void *GetValuePtr(unsigned int slot) final { return static_cast<void *>(&fLastResults[slot]); }
 
-   void Update(unsigned int slot, Long64_t entry) final
+   void UpdateImpl(unsigned int slot, Long64_t entry) final
    {
-      if (entry != fLastCheckedEntry[slot]) {
-         // evaluate this filter, cache the result
-         UpdateHelper(slot, entry, TypeInd_t(), ColumnTypes_t(), ExtraArgsTag{});
-         fLastCheckedEntry[slot] = entry;
-      }
+      UpdateHelper(slot, entry, TypeInd_t(), ColumnTypes_t(), ExtraArgsTag{});
    }
 
    const std::type_info &GetTypeId() const
@@ -133,6 +131,16 @@ public:
       return fIsDataSourceColumn ? typeid(typename std::remove_pointer<ret_type>::type) : typeid(ret_type);
    }
 
+   std::string GetFingerprint() const final
+   {
+      // compiled code cannot be identified: neither the type of a lambda nor the one of a function pointer change
+      // with its body or with its captured values
+      auto fingerprint = RDFInternal::kUnidentifiedFingerprint + ("Define:" + fName);
+      for (const auto &c : fColumnNames)
+         fingerprint += ':' + c;
+      return fingerprint;
+   }
+
    void ClearValueReaders(unsigned int slot) final
    {
       if (fIsInitialized[slot]) {
@@ -45,6 +45,8 @@ protected:
    std::deque<bool> fIsInitialized; // because vector<bool> is not thread-safe
 
    static unsigned int GetNextID();
+   /// Evaluate the value of this column for the given entry.
+   virtual void UpdateImpl(unsigned int slot, Long64_t entry) = 0;
 
 public:
    RCustomColumnBase(RLoopManager *lm, std::string_view name, const unsigned int nSlots, const bool isDSColumn,
@@ -57,7 +59,18 @@ public:
    virtual const std::type_info &GetTypeId() const = 0;
    RLoopManager *GetLoopManagerUnchecked() const;
    std::string GetName() const;
-   virtual void Update(unsigned int slot, Long64_t entry) = 0;
+   /// Return a description of this custom column that identifies the computation it performs.
+   virtual std::string GetFingerprint() const;
+   /// Evaluate the value of this column for the given entry, unless it has already been evaluated.
+   /// The check is not virtual so that reading a value already computed for this entry, e.g. by an upstream Filter,
+   /// costs no more than a comparison.
+   void Update(unsigned int slot, Long64_t entry)
+   {
+      if (entry != fLastCheckedEntry[slot]) {
+         UpdateImpl(slot, entry);
+         fLastCheckedEntry[slot] = entry;
+      }
+   }
    virtual void ClearValueReaders(unsigned int slot) = 0;
    bool IsDataSourceColumn() const { return fIsDataSourceColumn; }
    virtual void InitNode();
@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <typeinfo>
 #include <vector>
 
 namespace ROOT {
@@ -156,6 +157,17 @@ public:
       filters.push_back(name);
    }
 
+   void AddFingerprint(std::vector<std::string> &fingerprints) final
+   {
+      fPrevData.AddFingerprint(fingerprints);
+      // compiled code cannot be identified: neither the type of a lambda nor the one of a function pointer change
+      // with its body or with its captured values
+      auto fingerprint = RDFInternal::kUnidentifiedFingerprint + ("Filter:" + fName);
+      for (const auto &c : fColumnNames)
+         fingerprint += ':' + c;
+      fingerprints.emplace_back(std::move(fingerprint));
+   }
+
    virtual void ClearTask(unsigned int slot) final
    {
       for (auto &column : fCustomColumns.GetColumns()) {
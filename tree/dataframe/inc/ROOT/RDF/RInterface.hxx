@@ -251,7 +251,7 @@ public:
       auto upcastNodeOnHeap = RDFInternal::MakeSharedOnHeap(RDFInternal::UpcastNode(fProxiedPtr));
       using BaseNodeType_t = typename std::remove_pointer<decltype(upcastNodeOnHeap)>::type::element_type;
       RInterface<BaseNodeType_t> upcastInterface(*upcastNodeOnHeap, *fLoopManager, fCustomColumns, fDataSource);
-      const auto jittedFilter = std::make_shared<RDFDetail::RJittedFilter>(fLoopManager, name);
+      const auto jittedFilter = std::make_shared<RDFDetail::RJittedFilter>(fLoopManager, name, expression);
 
       RDFInternal::BookFilterJit(jittedFilter.get(), upcastNodeOnHeap, name, expression, fLoopManager->GetAliasMap(),
                                  fLoopManager->GetBranchNames(), fCustomColumns, fLoopManager->GetTree(), fDataSource,
@@ -376,7 +376,7 @@ public:
                                      fDataSource ? fDataSource->GetColumnNames() : ColumnNames_t{});
 
       auto jittedCustomColumn =
-         std::make_shared<RDFDetail::RJittedCustomColumn>(fLoopManager, name, fLoopManager->GetNSlots());
+         std::make_shared<RDFDetail::RJittedCustomColumn>(fLoopManager, name, fLoopManager->GetNSlots(), expression);
 
       RDFInternal::BookDefineJit(name, expression, *fLoopManager, fDataSource, jittedCustomColumn, fCustomColumns,
                                  fLoopManager->GetBranchNames());
@@ -689,6 +689,75 @@ public:
       return Cache(selectedColumns);
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns in a persistent, content-addressed cache on disk
+   /// \param[in] cacheDir The directory where cache files are stored. It is created if it does not exist.
+   /// \param[in] columnList The columns to be cached.
+   /// \param[in] key A string that is mixed into the identifier of the cached dataset, required if the computation
+   /// involves compiled callables, a data-source or an in-memory tree.
+   /// \return a `RDataFrame` that wraps the cached dataset.
+   ///
+   /// Like `Cache`, this returns a new `RDataFrame` that only contains the selected columns, but the content is
+   /// stored in a ROOT file in `cacheDir` and can be reused across processes. The file is identified by a hash of
+   /// the computation that leads to this node: the input dataset (file names, sizes and modification times, entries
+   /// of the entry list), column aliases, the chain of Filters and Ranges, all Defines and the selected columns. If
+   /// the cache file for that hash exists, it is read back and neither the upstream computation nor the input dataset
+   /// are touched. Otherwise the columns are written via `Snapshot`, which
+   /// immediately runs the event loop, and the new dataframe reads them back from the freshly written file.
+   ///
+   /// Jitted Filters and Defines are identified by their expression. Compiled callables cannot be identified: two
+   /// functions with the same signature, or a lambda whose body or captured values changed, look the same. Likewise,
+   /// the input of a data-source or of a tree which is not read from a file cannot be inspected. If the computation
+   /// involves any of them, a `key` describing them must be passed, otherwise an exception is thrown; change it
+   /// whenever they change, since the cache is reused for the same key.
+   /// As for `Snapshot`, dots in column names are replaced by underscores in the cached dataset.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// auto cached = df.Define("pt", "sqrt(px*px + py*py)").Filter("pt > 10").PersistentCache("rdfcache", {"pt"});
+   /// ~~~
+   RInterface<RLoopManager>
+   PersistentCache(std::string_view cacheDir, const ColumnNames_t &columnList, std::string_view key = "")
+   {
+      if (columnList.empty())
+         throw std::runtime_error("PersistentCache: the list of columns to be cached is empty.");
+      const auto validCols = GetValidatedColumnNames(columnList.size(), columnList);
+
+      std::vector<std::string> fingerprints;
+      fProxiedPtr->AddFingerprint(fingerprints);
+      // Defines are lazy and their position w.r.t. Filters does not change their values, so the ones booked up to
+      // this node are all we need to know about, in a canonical (sorted by name) order
+      for (const auto &column : fCustomColumns.GetColumns()) {
+         if (!RDFInternal::IsInternalColumn(column.first) && !column.second->IsDataSourceColumn())
+            fingerprints.emplace_back(column.second->GetFingerprint());
+      }
+      std::string columnsFingerprint = "Columns";
+      for (const auto &c : validCols)
+         columnsFingerprint += ':' + c;
+      fingerprints.emplace_back(std::move(columnsFingerprint));
+      if (key.empty()) {
+         for (const auto &fingerprint : fingerprints) {
+            if (fingerprint[0] == RDFInternal::kUnidentifiedFingerprint)
+               throw std::runtime_error("PersistentCache: the computation cannot be identified (" +
+                                        fingerprint.substr(1) +
+                                        " is compiled code, a data-source or an in-memory tree), a key describing it "
+                                        "is required.");
+         }
+      }
+      fingerprints.emplace_back("Key:" + std::string(key));
+
+      const auto fileName = RDFInternal::GetPersistentCacheFileName(cacheDir, fingerprints);
+      if (!RDFInternal::HasPersistentCacheFile(fileName)) {
+         // write under a temporary name first, so that concurrent or interrupted writers never expose partial files
+         const auto tmpFileName = RDFInternal::GetPersistentCacheTmpFileName(fileName);
+         Snapshot(RDFInternal::kPersistentCacheTreeName, tmpFileName, validCols);
+         RDFInternal::CommitPersistentCacheFile(tmpFileName, fileName);
+      }
+
+      RInterface<RLoopManager> cachedRDF(RDFInternal::OpenPersistentCache(fileName));
+      return cachedRDF;
+   }
+
    // clang-format off
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Creates a node that filters entries based on range: [begin, end)
@@ -698,7 +767,11 @@ public:
    /// \return the first node of the computation graph for which the event loop is limited to a certain range of entries.
    ///
    /// Note that in case of previous Ranges and Filters the selected range refers to the transformed dataset.
-   /// Ranges are only available if EnableImplicitMT has _not_ been called. Multi-thread ranges are not supported.
+   ///
+   /// In multi-thread event loops entries are not processed in order, so Ranges can only be applied directly to the
+   /// RDataFrame, i.e. not after Filters or other Ranges. They then select entries by their entry number in the
+   /// dataset, and the event loop skips the entries that are outside of all Ranges, if all the actions and Filters hang
+   /// from one. Ranges over a TTree with an associated TEntryList are not supported in multi-thread event loops.
    ///
    /// ### Example usage:
    /// ~~~{.cpp}
@@ -712,7 +785,10 @@ public:
       // check invariants
       if (stride == 0 || (end != 0 && end < begin))
          throw std::runtime_error("Range: stride must be strictly greater than 0 and end must be greater than begin.");
-      CheckIMTDisabled("Range");
+      if (fLoopManager->IsMultiThreaded() &&
+          static_cast<RDFDetail::RNodeBase *>(fProxiedPtr.get()) != static_cast<RDFDetail::RNodeBase *>(fLoopManager))
+         throw std::runtime_error("Range: in multi-thread event loops, Ranges can only be applied directly to the "
+                                  "RDataFrame, as entries are not processed in order.");
 
       using Range_t = RDFDetail::RRange<Proxied>;
       auto rangePtr = std::make_shared<Range_t>(begin, end, stride, fProxiedPtr);
@@ -39,6 +39,8 @@ public:
    void SetAction(std::unique_ptr<RActionBase> a) { fConcreteAction = std::move(a); }
 
    void Run(unsigned int slot, Long64_t entry) final;
+   void RunFused(unsigned int slot, ULong64_t begin, ULong64_t end, ROOT::RDF::RDataSource *ds) final;
+   void RunFused(unsigned int slot, TTreeReader &r, Long64_t firstEntry) final;
    void Initialize() final;
    void InitSlot(TTreeReader *r, unsigned int slot) final;
    void TriggerChildrenCount() final;
@@ -32,10 +32,12 @@ class RLoopManager;
 /// before the event-loop starts.
 class RJittedCustomColumn : public RCustomColumnBase {
    std::unique_ptr<RCustomColumnBase> fConcreteCustomColumn = nullptr;
+   const std::string fExpression; ///< The expression that is jitted into the concrete custom column
 
 public:
-   RJittedCustomColumn(RLoopManager *lm, std::string_view name, unsigned int nSlots)
-      : RCustomColumnBase(lm, name, nSlots, /*isDSColumn=*/false, RDFInternal::RBookedCustomColumns())
+   RJittedCustomColumn(RLoopManager *lm, std::string_view name, unsigned int nSlots, std::string_view expression = "")
+      : RCustomColumnBase(lm, name, nSlots, /*isDSColumn=*/false, RDFInternal::RBookedCustomColumns()),
+        fExpression(expression)
    {
    }
 
@@ -44,7 +46,8 @@ public:
    void InitSlot(TTreeReader *r, unsigned int slot) final;
    void *GetValuePtr(unsigned int slot) final;
    const std::type_info &GetTypeId() const final;
-   void Update(unsigned int slot, Long64_t entry) final;
+   std::string GetFingerprint() const final { return "Define:" + fName + ':' + fExpression; }
+   void UpdateImpl(unsigned int slot, Long64_t entry) final;
    void ClearValueReaders(unsigned int slot) final;
    void InitNode() final;
 };
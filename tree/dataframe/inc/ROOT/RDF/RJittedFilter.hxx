@@ -38,9 +38,10 @@ namespace RDFGraphDrawing = ROOT::Internal::RDF::GraphDrawing;
 /// at a later time, from jitted code.
 class RJittedFilter final : public RFilterBase {
    std::unique_ptr<RFilterBase> fConcreteFilter = nullptr;
+   const std::string fExpression; ///< The expression that is jitted into the concrete filter
 
 public:
-   RJittedFilter(RLoopManager *lm, std::string_view name);
+   RJittedFilter(RLoopManager *lm, std::string_view name, std::string_view expression = "");
    ~RJittedFilter() { fLoopManager->Deregister(this); }
 
    void SetFilter(std::unique_ptr<RFilterBase> f);
@@ -51,6 +52,7 @@ public:
    void PartialReport(ROOT::RDF::RCutFlowReport &) const final;
    void FillReport(ROOT::RDF::RCutFlowReport &) const final;
    void IncrChildrenCount() final;
+   unsigned int GetNChildren() const final;
    void StopProcessing() final;
    void ResetChildrenCount() final;
    void TriggerChildrenCount() final;
@@ -58,6 +60,7 @@ public:
    void ClearValueReaders(unsigned int slot) final;
    void InitNode() final;
    void AddFilterName(std::vector<std::string> &filters) final;
+   void AddFingerprint(std::vector<std::string> &fingerprints) final;
    void ClearTask(unsigned int slot) final;
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph();
 };
@@ -108,6 +108,7 @@ class RLoopManager : public RNodeBase {
    const ULong64_t fNEmptyEntries{0};
    const unsigned int fNSlots{1};
    bool fMustRunNamedFilters{true};
+   bool fRunFused{false}; ///< Whether the current event loop runs through RActionBase::RunFused, see CanRunFused
    const ELoopType fLoopType; ///< The kind of event loop that is going to be run (e.g. on ROOT files, on no files)
    std::string fToJitDeclare; ///< Code that should be just-in-time declared right before the event loop
    std::string fToJitExec;    ///< Code that should be just-in-time executed right before the event loop
@@ -124,6 +125,8 @@ class RLoopManager : public RNodeBase {
    ColumnNames_t fValidBranchNames;
 
    void CheckIndexedFriends();
+   bool HasActiveRanges() const;
+   std::pair<ULong64_t, ULong64_t> GetRangesBoundaries() const;
    void RunEmptySourceMT();
    void RunEmptySource();
    void RunTreeProcessorMT();
@@ -131,6 +134,7 @@ class RLoopManager : public RNodeBase {
    void RunDataSourceMT();
    void RunDataSource();
    void RunAndCheckFilters(unsigned int slot, Long64_t entry);
+   bool CanRunFused() const;
    void InitNodeSlots(TTreeReader *r, unsigned int slot);
    void InitNodes();
    void CleanUpNodes();
@@ -160,7 +164,14 @@ public:
    void Deregister(RFilterBase *filterPtr);
    void Book(RRangeBase *rangePtr);
    void Deregister(RRangeBase *rangePtr);
-   bool CheckFilters(unsigned int, Long64_t) final;
+   /// Whether the event loop is run by multiple threads, in which case entries are not processed in order.
+   bool IsMultiThreaded() const
+   {
+      return fLoopType == ELoopType::kROOTFilesMT || fLoopType == ELoopType::kNoFilesMT ||
+             fLoopType == ELoopType::kDataSourceMT;
+   }
+   /// End of recursive chain of calls. Defined inline so that the chain of a fully typed graph can be inlined.
+   bool CheckFilters(unsigned int, Long64_t) final { return true; }
    unsigned int GetNSlots() const { return fNSlots; }
    void Report(ROOT::RDF::RCutFlowReport &rep) const final;
    /// End of recursive chain of calls, does nothing
@@ -168,6 +179,8 @@ public:
    void SetTree(const std::shared_ptr<TTree> &tree) { fTree = tree; }
    void IncrChildrenCount() final { ++fNChildren; }
    void StopProcessing() final { ++fNStopsReceived; }
+   /// Whether all the branches of the graph signaled that they do not need more entries, e.g. because of Ranges.
+   bool HasStoppedProcessing() const { return fNStopsReceived >= fNChildren; }
    void ToJitDeclare(const std::string &s) { fToJitDeclare.append(s); }
    void ToJitExec(const std::string &s) { fToJitExec.append(s); }
    void AddColumnAlias(const std::string &alias, const std::string &colName) { fAliasColumnNameMap[alias] = colName; }
@@ -177,6 +190,7 @@ public:
 
    /// End of recursive chain of calls, does nothing
    void AddFilterName(std::vector<std::string> &) {}
+   void AddFingerprint(std::vector<std::string> &fingerprints) final;
    /// For each booked filter, returns either the name or "Unnamed Filter"
    std::vector<std::string> GetFiltersNames();
 
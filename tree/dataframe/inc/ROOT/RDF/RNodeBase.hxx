@@ -53,8 +53,14 @@ public:
    virtual void IncrChildrenCount() = 0;
    virtual void StopProcessing() = 0;
    virtual void AddFilterName(std::vector<std::string> &filters) = 0;
+   /// Append to `fingerprints` a description of this node and of all its upstream nodes, from the head node down.
+   /// Used to identify the computation that leads to this node, e.g. by RInterface::PersistentCache.
+   virtual void AddFingerprint(std::vector<std::string> &fingerprints) = 0;
    virtual std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> GetGraph() = 0;
 
+   /// Number of nodes of the functional graph hanging from this object, as counted before the event loop.
+   virtual unsigned int GetNChildren() const { return fNChildren; }
+
    virtual void ResetChildrenCount()
    {
       fNChildren = 0;
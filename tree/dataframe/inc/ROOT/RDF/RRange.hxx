@@ -16,6 +16,7 @@
 #include "RtypesCore.h"
 
 #include <memory>
+#include <string>
 
 namespace ROOT {
 
@@ -51,6 +52,9 @@ public:
    /// Ranges act as filters when it comes to selecting entries that downstream nodes should process
    bool CheckFilters(unsigned int slot, Long64_t entry) final
    {
+      // no state is shared among slots in this case, so no caching
+      if (fSelectByEntryNumber)
+         return fPrevData.CheckFilters(slot, entry) && IsSelected(entry);
       if (entry != fLastCheckedEntry) {
          if (fHasStopped)
             return false;
@@ -98,6 +102,13 @@ public:
 
    /// This function must be defined by all nodes, but only the filters will add their name
    void AddFilterName(std::vector<std::string> &filters) { fPrevData.AddFilterName(filters); }
+
+   void AddFingerprint(std::vector<std::string> &fingerprints) final
+   {
+      fPrevData.AddFingerprint(fingerprints);
+      fingerprints.emplace_back("Range:" + std::to_string(fStart) + ':' + std::to_string(fStop) + ':' +
+                                std::to_string(fStride));
+   }
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph()
    {
       // TODO: Ranges node have no information about custom columns, hence it is not possible now
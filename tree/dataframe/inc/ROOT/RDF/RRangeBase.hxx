@@ -39,6 +39,8 @@ protected:
    ULong64_t fNProcessedEntries{0};
    bool fHasStopped{false};    ///< True if the end of the range has been reached
    const unsigned int fNSlots; ///< Number of thread slots used by this node, inherited from parent node.
+   /// True if entries are selected by their entry number rather than by counting them, as in multi-thread event loops
+   bool fSelectByEntryNumber{false};
 
    void ResetCounters();
 
@@ -49,8 +51,19 @@ public:
    RRangeBase &operator=(const RRangeBase &) = delete;
    virtual ~RRangeBase();
 
-   void InitNode() { ResetCounters(); }
+   void InitNode();
    virtual std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph() = 0;
+   unsigned int GetStart() const { return fStart; }
+   unsigned int GetStop() const { return fStop; }
+   bool HasChildren() const { return fNChildren > 0; }
+
+   /// Whether the entry with this number is selected when selecting by entry number. This is the selection that a
+   /// sequential event loop applies to the n-th entry it processes, with n = entry + 1.
+   bool IsSelected(Long64_t entry) const
+   {
+      const auto n = static_cast<ULong64_t>(entry) + 1ull;
+      return n > fStart && (fStop == 0 || n <= fStop) && (fStride == 1 || n % fStride == 0);
+   }
 };
 
 } // ns RDF
@@ -59,6 +59,10 @@ struct IsVector_t : public std::false_type {};
 template <typename T, typename A>
 struct IsVector_t<std::vector<T, A>> : public std::true_type {};
 
+/// First character of the fingerprints of the nodes whose computation cannot be identified, i.e. compiled callables,
+/// data-sources and in-memory trees: RInterface::PersistentCache only caches them under an explicit key.
+constexpr char kUnidentifiedFingerprint = '!';
+
 const std::type_info &TypeName2TypeID(const std::string &name);
 
 std::string TypeID2TypeName(const std::type_info &id);
@@ -23,6 +23,11 @@ ROOT::RDF::MakeArrowDataFrame, which accepts one parameter:
 The types of the columns are derived from the types in the associated
 arrow::Schema.
 
+The data is not copied: numeric columns are read directly from the Arrow buffers, and
+list columns are exposed as RVecs which adopt the memory of the Arrow arrays. The entry
+ranges never cross the boundaries of the chunks of the columns, and chunks are split in
+smaller ranges when needed to give work to all processing slots.
+
 */
 // clang-format on
 
@@ -202,9 +207,16 @@ public:
 /// Helper class which keeps track for each slot where to get the entry.
 class TValueGetter {
 private:
-   std::vector<void *> fValuesPtrPerSlot;
-   std::vector<ULong64_t> fLastEntryPerSlot;
-   std::vector<ULong64_t> fLastChunkPerSlot;
+   /// State of a slot. It is updated at every entry: the padding keeps the states of different slots on different
+   /// cache lines, so that slots processed by different threads do not invalidate each other's caches.
+   struct SlotState {
+      void *fValuePtr = nullptr;          ///< Pointer to the value of the current entry
+      const char *fRawValues = nullptr;   ///< Beginning of the values of the current chunk, for fixed-width columns
+      ULong64_t fLastEntry = 0;           ///< Last entry which was looked up
+      ULong64_t fLastChunk = 0;           ///< Chunk which contains fLastEntry
+      char fPadding[64];
+   };
+   std::vector<SlotState> fSlotStates;
    std::vector<ULong64_t> fFirstEntryPerChunk;
    std::vector<ArrayPtrVisitor> fArrayVisitorPerSlot;
    /// Since data can be chunked in different arrays we need to construct an
@@ -212,10 +224,25 @@ private:
    /// quickly move to the correct chunk.
    std::vector<ULong64_t> fChunkIndex;
    arrow::ArrayVector fChunks;
+   /// Size in bytes of a value for columns of fixed-width numbers, 0 otherwise. The values of these columns are
+   /// read directly from the Arrow buffers, without going through the visitor.
+   size_t fByteWidth = 0;
+
+   static size_t GetByteWidth(const arrow::DataType &type)
+   {
+      switch (type.id()) {
+      case arrow::Type::INT32:
+      case arrow::Type::INT64:
+      case arrow::Type::UINT32:
+      case arrow::Type::UINT64:
+      case arrow::Type::FLOAT:
+      case arrow::Type::DOUBLE: return static_cast<const arrow::FixedWidthType &>(type).bit_width() / 8;
+      default: return 0;
+      }
+   }
 
 public:
-   TValueGetter(size_t slots, arrow::ArrayVector chunks)
-      : fValuesPtrPerSlot(slots, nullptr), fLastEntryPerSlot(slots, 0), fLastChunkPerSlot(slots, 0), fChunks{chunks}
+   TValueGetter(size_t slots, arrow::ArrayVector chunks) : fSlotStates(slots), fChunks{chunks}
    {
       fChunkIndex.reserve(fChunks.size());
       size_t next = 0;
@@ -224,8 +251,11 @@ public:
          next += chunk->length();
          fChunkIndex.push_back(next);
       }
-      for (size_t si = 0, se = fValuesPtrPerSlot.size(); si != se; ++si) {
-         fArrayVisitorPerSlot.push_back(ArrayPtrVisitor{fValuesPtrPerSlot.data() + si});
+      for (size_t si = 0, se = fSlotStates.size(); si != se; ++si) {
+         fArrayVisitorPerSlot.push_back(ArrayPtrVisitor{&fSlotStates[si].fValuePtr});
+      }
+      if (!fChunks.empty()) {
+         fByteWidth = GetByteWidth(*fChunks.front()->type());
       }
    }
 
@@ -233,8 +263,8 @@ public:
    std::vector<void *> SlotPtrs()
    {
       std::vector<void *> result;
-      for (size_t i = 0; i < fValuesPtrPerSlot.size(); ++i) {
-         result.push_back(fValuesPtrPerSlot.data() + i);
+      for (auto &state : fSlotStates) {
+         result.push_back(&state.fValuePtr);
       }
       return result;
    }
@@ -243,29 +273,33 @@ public:
    // SetEntry and InitSlot
    void UncachedSlotLookup(unsigned int slot, ULong64_t entry)
    {
-      // If entry is greater than the previous one,
-      // we can skip all the chunks before the last one we
-      // queried.
-      size_t ci = 0;
-      assert(slot < fLastChunkPerSlot.size());
-      if (fLastEntryPerSlot[slot] < entry) {
-         ci = fLastChunkPerSlot.at(slot);
-      }
+      assert(slot < fSlotStates.size());
+      auto &state = fSlotStates[slot];
 
-      for (size_t ce = fChunkIndex.size(); ci != ce; ++ci) {
-         if (entry < fChunkIndex[ci]) {
-            assert(slot < fLastChunkPerSlot.size());
-            fLastChunkPerSlot[slot] = ci;
-            break;
-         }
+      // fChunkIndex contains the end of each chunk: the chunk of the entry is
+      // the first one which ends after it.
+      const auto chunkIt = std::upper_bound(fChunkIndex.begin(), fChunkIndex.end(), entry);
+      if (chunkIt == fChunkIndex.end()) {
+         std::string msg = "Could not get pointer for slot ";
+         msg += std::to_string(slot) + " looking at entry " + std::to_string(entry);
+         throw std::runtime_error(msg);
       }
+      state.fLastChunk = std::distance(fChunkIndex.begin(), chunkIt);
+      state.fLastEntry = entry;
 
       // Update the pointer to the requested entry.
       // Notice that we need to find the entry
-      auto chunk = fChunks.at(fLastChunkPerSlot[slot]);
+      auto &chunk = fChunks[state.fLastChunk];
+      const auto entryInChunk = entry - fFirstEntryPerChunk[state.fLastChunk];
+      if (fByteWidth) {
+         // buffers[1] holds the values, buffers[0] the validity bitmap
+         state.fRawValues =
+            reinterpret_cast<const char *>(chunk->data()->buffers[1]->data()) + chunk->offset() * fByteWidth;
+         state.fValuePtr = const_cast<char *>(state.fRawValues + entryInChunk * fByteWidth);
+         return;
+      }
       assert(slot < fArrayVisitorPerSlot.size());
-      fArrayVisitorPerSlot[slot].SetEntry(entry - fFirstEntryPerChunk[fLastChunkPerSlot[slot]]);
-      fLastEntryPerSlot[slot] = entry;
+      fArrayVisitorPerSlot[slot].SetEntry(entryInChunk);
       auto status = chunk->Accept(fArrayVisitorPerSlot.data() + slot);
       if (!status.ok()) {
          std::string msg = "Could not get pointer for slot ";
@@ -277,8 +311,17 @@ public:
    /// Set the current entry to be retrieved
    void SetEntry(unsigned int slot, ULong64_t entry)
    {
+      auto &state = fSlotStates[slot];
       // Same entry as before
-      if (fLastEntryPerSlot[slot] == entry) {
+      if (state.fLastEntry == entry) {
+         return;
+      }
+      // Entry ranges do not cross chunk boundaries: for fixed-width columns, the
+      // value is found with an offset from the beginning of the current chunk.
+      const auto chunk = state.fLastChunk;
+      if (fByteWidth && entry >= fFirstEntryPerChunk[chunk] && entry < fChunkIndex[chunk]) {
+         state.fValuePtr = const_cast<char *>(state.fRawValues + (entry - fFirstEntryPerChunk[chunk]) * fByteWidth);
+         state.fLastEntry = entry;
          return;
       }
       UncachedSlotLookup(slot, entry);
@@ -512,20 +555,35 @@ void RArrowDS::InitSlot(unsigned int slot, ULong64_t entry)
    }
 }
 
-void splitInEqualRanges(std::vector<std::pair<ULong64_t, ULong64_t>> &ranges, int nRecords, unsigned int nSlots)
+/// Split the entries in ranges which do not cross the boundaries of the chunks of any of the columns, so that
+/// within a range the values of each column are read from a single Arrow array. Chunks are further split in
+/// ranges of at most nRecords / nSlots entries, so that all slots have some work even if the table has few chunks.
+void splitInChunkAlignedRanges(std::vector<std::pair<ULong64_t, ULong64_t>> &ranges,
+                               std::shared_ptr<arrow::Table> &table,
+                               std::vector<std::pair<size_t, size_t>> const &getterIndex, ULong64_t nRecords,
+                               unsigned int nSlots)
 {
    ranges.clear();
-   const auto chunkSize = nRecords / nSlots;
-   const auto remainder = 1U == nSlots ? 0 : nRecords % nSlots;
-   auto start = 0UL;
-   auto end = 0UL;
-   for (auto i : ROOT::TSeqU(nSlots)) {
-      start = end;
-      end += chunkSize;
-      ranges.emplace_back(start, end);
-      (void)i;
-   }
-   ranges.back().second += remainder;
+   std::vector<ULong64_t> boundaries{0ULL, nRecords};
+   for (auto &columnAndGetter : getterIndex) {
+      ULong64_t end = 0ULL;
+      for (auto &chunk : table->column(columnAndGetter.first)->data()->chunks()) {
+         end += chunk->length();
+         boundaries.push_back(end);
+      }
+   }
+   std::sort(boundaries.begin(), boundaries.end());
+   boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+
+   const auto maxRangeSize = std::max(1ULL, (nRecords + nSlots - 1) / nSlots);
+   for (size_t i = 0; i + 1 < boundaries.size(); ++i) {
+      const auto begin = boundaries[i];
+      const auto size = boundaries[i + 1] - begin;
+      const auto nRanges = (size + maxRangeSize - 1) / maxRangeSize;
+      for (ULong64_t r = 0; r < nRanges; ++r) {
+         ranges.emplace_back(begin + r * size / nRanges, begin + (r + 1) * size / nRanges);
+      }
+   }
 }
 
 int getNRecords(std::shared_ptr<arrow::Table> &table, std::vector<std::string> &columnNames)
@@ -572,7 +630,7 @@ std::vector<void *> RArrowDS::GetColumnReadersImpl(std::string_view colName, con
 void RArrowDS::Initialise()
 {
    auto nRecords = getNRecords(fTable, fColumnNames);
-   splitInEqualRanges(fEntryRanges, nRecords, fNSlots);
+   splitInChunkAlignedRanges(fEntryRanges, fTable, fGetterIndex, nRecords, fNSlots);
 }
 
 std::string RArrowDS::GetLabel()
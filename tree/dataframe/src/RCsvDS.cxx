@@ -65,21 +65,33 @@ double-quote characters must be represented by a pair of double-quote characters
     2000,Mercury,Cougar
 ~~~
 
-The current implementation of RCsvDS reads the entire CSV file content into memory before
-RDataFrame starts processing it. Therefore, before creating a CSV RDataFrame, it is
+The file is read in chunks of `linesChunkSize` records, the last parameter of MakeCsvDataFrame; by default
+(`linesChunkSize = -1`) the entire CSV file content is read into memory before RDataFrame starts
+processing it. Therefore, before creating a CSV RDataFrame with the default chunk size, it is
 important to check both how much memory is available and the size of the CSV file.
+The records of a chunk are stored column by column; when implicit multi-threading is enabled, the chunk
+is split at line boundaries and its pieces are parsed in parallel.
 */
 // clang-format on
 
+#include "RConfigure.h" // R__USE_IMT
 #include <ROOT/RDF/Utils.hxx>
 #include <ROOT/TSeq.hxx>
 #include <ROOT/RCsvDS.hxx>
 #include <ROOT/RMakeUnique.hxx>
 #include <TError.h>
+#include <TROOT.h> // IsImplicitMTEnabled, GetImplicitMTPoolSize
+#ifdef R__USE_IMT
+#include <ROOT/TThreadExecutor.hxx>
+#endif
 
 #include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
 namespace ROOT {
@@ -109,41 +121,6 @@ void RCsvDS::FillHeaders(const std::string &line)
    }
 }
 
-void RCsvDS::FillRecord(const std::string &line, Record_t &record)
-{
-   std::istringstream lineStream(line);
-   auto i = 0U;
-
-   auto columns = ParseColumns(line);
-
-   for (auto &col : columns) {
-      auto colType = fColTypes[fHeaders[i]];
-
-      switch (colType) {
-      case 'd': {
-         record.emplace_back(new double(std::stod(col)));
-         break;
-      }
-      case 'l': {
-         record.emplace_back(new Long64_t(std::stoll(col)));
-         break;
-      }
-      case 'b': {
-         auto b = new bool();
-         record.emplace_back(b);
-         std::istringstream is(col);
-         is >> std::boolalpha >> *b;
-         break;
-      }
-      case 's': {
-         record.emplace_back(new std::string(col));
-         break;
-      }
-      }
-      ++i;
-   }
-}
-
 void RCsvDS::GenerateHeaders(size_t size)
 {
    for (size_t i = 0; i < size; ++i) {
@@ -248,6 +225,207 @@ size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &col
    return i;
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Read from the stream the bytes of the next chunk of records, i.e. fLinesChunkSize non-empty lines or all the
+/// remaining ones if fLinesChunkSize is -1. The stream is read in large blocks: the bytes read beyond the last
+/// line of the chunk are kept in fLeftover for the next call. Returns the number of records in the chunk.
+ULong64_t RCsvDS::ReadChunk(std::string &chunk)
+{
+   constexpr std::size_t blockSize = 1 << 20;
+   const bool readAll = -1LL == fLinesChunkSize;
+   const auto maxLines = static_cast<ULong64_t>(fLinesChunkSize);
+
+   chunk.clear();
+   chunk.swap(fLeftover);
+
+   ULong64_t nLines = 0ULL;
+   std::size_t lineStart = 0; // beginning of the first line that was not counted yet
+   std::size_t scanPos = 0;   // bytes before this position have already been searched for line breaks
+   while (true) {
+      while (readAll || nLines < maxLines) {
+         const auto lineEnd = chunk.find('\n', scanPos);
+         if (std::string::npos == lineEnd)
+            break;
+         if (lineEnd > lineStart)
+            ++nLines;
+         lineStart = scanPos = lineEnd + 1;
+      }
+      if (!readAll && nLines == maxLines) {
+         fLeftover.assign(chunk, lineStart, std::string::npos);
+         chunk.resize(lineStart);
+         return nLines;
+      }
+      scanPos = chunk.size();
+
+      if (!fStream)
+         break;
+      chunk.resize(scanPos + blockSize);
+      fStream.read(&chunk[scanPos], blockSize);
+      chunk.resize(scanPos + fStream.gcount());
+   }
+
+   // The last line of the file might not be terminated by a line break
+   if (chunk.size() > lineStart)
+      ++nLines;
+   return nLines;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Parse the records contained in a chunk read with ReadChunk and store them column-wise.
+/// If implicit multi-threading is enabled, the chunk is split in pieces at line boundaries: the non-empty lines
+/// of each piece are counted in parallel to know the position of its first record, then the pieces are parsed
+/// in parallel, each writing directly into its own section of the columns.
+void RCsvDS::ParseChunk(const std::string &chunk)
+{
+   const auto nColumns = fColTypesList.size();
+   for (auto col : ROOT::TSeqU(nColumns)) {
+      switch (fColTypesList[col]) {
+      case 'd': fDoubleColumns[col].resize(fNRecords); break;
+      case 'l': fLong64Columns[col].resize(fNRecords); break;
+      case 'b': fBoolColumns[col].resize(fNRecords); break;
+      case 's': fStringColumns[col].resize(fNRecords); break;
+      }
+   }
+
+   // Parse the lines in chunk[begin, end), storing them starting from the given record
+   auto parseLines = [this, &chunk](std::size_t begin, std::size_t end, ULong64_t record) {
+      std::string field;
+      while (begin < end) {
+         const auto lineEnd = std::min(chunk.find('\n', begin), end);
+         if (lineEnd > begin)
+            ParseRecord(chunk.data() + begin, lineEnd - begin, record++, field);
+         begin = lineEnd + 1;
+      }
+   };
+
+   unsigned int nPieces = 1U;
+#ifdef R__USE_IMT
+   constexpr std::size_t minPieceSize = 1 << 16;
+   if (ROOT::IsImplicitMTEnabled())
+      nPieces = std::max(1UL, std::min<unsigned long>(4UL * ROOT::GetImplicitMTPoolSize(), chunk.size() / minPieceSize));
+#endif
+
+   if (1U == nPieces) {
+      parseLines(0, chunk.size(), 0ULL);
+      return;
+   }
+
+#ifdef R__USE_IMT
+   // Piece boundaries, moved forward to the beginning of the next line
+   std::vector<std::size_t> bounds(nPieces + 1, chunk.size());
+   bounds[0] = 0;
+   for (auto i : ROOT::TSeqU(1U, nPieces)) {
+      const auto lineEnd = chunk.find('\n', std::max(bounds[i - 1], i * (chunk.size() / nPieces)));
+      bounds[i] = std::string::npos == lineEnd ? chunk.size() : lineEnd + 1;
+   }
+
+   std::vector<ULong64_t> firstRecords(nPieces + 1, 0ULL);
+   auto countLines = [&](unsigned int i) {
+      ULong64_t n = 0ULL;
+      for (auto begin = bounds[i]; begin < bounds[i + 1];) {
+         const auto lineEnd = std::min(chunk.find('\n', begin), bounds[i + 1]);
+         if (lineEnd > begin)
+            ++n;
+         begin = lineEnd + 1;
+      }
+      firstRecords[i + 1] = n;
+   };
+
+   ROOT::TThreadExecutor pool;
+   pool.Foreach(countLines, ROOT::TSeqU(nPieces));
+   for (auto i : ROOT::TSeqU(nPieces))
+      firstRecords[i + 1] += firstRecords[i];
+   R__ASSERT(firstRecords[nPieces] == fNRecords && "The number of records in the chunk changed while parsing it.");
+
+   pool.Foreach([&](unsigned int i) { parseLines(bounds[i], bounds[i + 1], firstRecords[i]); }, ROOT::TSeqU(nPieces));
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Split a line in fields and store them as entries of the given record. This follows the same quoting rules as
+/// ParseValue, reusing `field` as buffer for the content of the fields. Missing fields are default-initialised,
+/// fields beyond the number of columns are ignored.
+void RCsvDS::ParseRecord(const char *line, std::size_t size, ULong64_t record, std::string &field)
+{
+   const auto nColumns = fColTypesList.size();
+   unsigned int col = 0U;
+   for (std::size_t i = 0; i < size && col < nColumns; ++i, ++col) {
+      field.clear();
+      bool quoted = false;
+      for (; i < size; ++i) {
+         if (line[i] == fDelimiter && !quoted) {
+            break;
+         } else if (line[i] == '"') {
+            // Keep just one quote for escaped quotes, none for the normal quotes
+            if (i + 1 < size && line[i + 1] == '"') {
+               field += line[++i];
+            } else {
+               quoted = !quoted;
+            }
+         } else {
+            field += line[i];
+         }
+      }
+      StoreValue(field, col, record);
+   }
+
+   field.clear();
+   for (; col < nColumns; ++col) {
+      StoreValue(field, col, record);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Convert the content of a field according to the type of its column and store it.
+/// An empty field stands for a missing value and is stored as a default-initialised value.
+void RCsvDS::StoreValue(const std::string &field, unsigned int col, ULong64_t record)
+{
+   const auto colType = fColTypesList[col];
+   if (field.empty()) {
+      switch (colType) {
+      case 'd': fDoubleColumns[col][record] = 0.; break;
+      case 'l': fLong64Columns[col][record] = 0LL; break;
+      case 'b': fBoolColumns[col][record] = false; break;
+      case 's': fStringColumns[col][record].clear(); break;
+      }
+      return;
+   }
+
+   const char *begin = field.c_str();
+   char *end = nullptr;
+   switch (colType) {
+   case 'd': {
+      fDoubleColumns[col][record] = std::strtod(begin, &end);
+      break;
+   }
+   case 'l': {
+      fLong64Columns[col][record] = std::strtoll(begin, &end, 10);
+      break;
+   }
+   case 'b': {
+      // Same as reading the field with std::boolalpha: leading spaces are skipped
+      while (std::isspace(static_cast<unsigned char>(*begin)))
+         ++begin;
+      fBoolColumns[col][record] = 0 == std::strncmp(begin, "true", 4);
+      return;
+   }
+   case 's': {
+      fStringColumns[col][record] = field;
+      return;
+   }
+   }
+
+   if (end == begin) {
+      std::string msg = "Could not convert value \"";
+      msg += field;
+      msg += "\" of column ";
+      msg += fHeaders[col];
+      msg += " to ";
+      msg += fgColTypeMap.at(colType);
+      throw std::runtime_error(msg);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// Constructor to create a CSV RDataSource for RDataFrame.
 /// \param[in] fileName Path of the CSV file.
@@ -292,31 +470,15 @@ RCsvDS::RCsvDS(std::string_view fileName, bool readHeaders, char delimiter, Long
 
 void RCsvDS::FreeRecords()
 {
-   for (auto &record : fRecords) {
-      for (size_t i = 0; i < record.size(); ++i) {
-         void *p = record[i];
-         const auto colType = fColTypes[fHeaders[i]];
-         switch (colType) {
-         case 'd': {
-            delete static_cast<double *>(p);
-            break;
-         }
-         case 'l': {
-            delete static_cast<Long64_t *>(p);
-            break;
-         }
-         case 'b': {
-            delete static_cast<bool *>(p);
-            break;
-         }
-         case 's': {
-            delete static_cast<std::string *>(p);
-            break;
-         }
-         }
-      }
-   }
-   fRecords.clear();
+   for (auto &col : fDoubleColumns)
+      col.clear();
+   for (auto &col : fLong64Columns)
+      col.clear();
+   for (auto &col : fStringColumns)
+      col.clear();
+   for (auto &col : fBoolColumns)
+      col.clear();
+   fNRecords = 0ULL;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -330,8 +492,10 @@ void RCsvDS::Finalise()
 {
    fStream.clear();
    fStream.seekg(fDataPos);
+   fLeftover.clear();
    fProcessedLines = 0ULL;
    fEntryRangesRequested = 0ULL;
+   fChunkFirstEntry = 0ULL;
    FreeRecords();
 }
 
@@ -344,31 +508,29 @@ std::vector<std::pair<ULong64_t, ULong64_t>> RCsvDS::GetEntryRanges()
 {
 
    // Read records and store them in memory
-   auto linesToRead = fLinesChunkSize;
    FreeRecords();
+   fChunkFirstEntry = fProcessedLines;
 
-   std::string line;
-   while ((-1LL == fLinesChunkSize || 0 != linesToRead--) && std::getline(fStream, line)) {
-      fRecords.emplace_back();
-      FillRecord(line, fRecords.back());
-   }
+   std::string chunk;
+   fNRecords = ReadChunk(chunk);
+   ParseChunk(chunk);
 
    if (gDebug > 0) {
       if (fLinesChunkSize == -1LL) {
-         Info("GetEntryRanges", "Attempted to read entire CSV file into memory, %lu lines read", fRecords.size());
+         Info("GetEntryRanges", "Attempted to read entire CSV file into memory, %llu lines read", fNRecords);
       } else {
-         Info("GetEntryRanges", "Attempted to read chunk of %lld lines of CSV file into memory, %lu lines read", fLinesChunkSize, fRecords.size());
+         Info("GetEntryRanges", "Attempted to read chunk of %lld lines of CSV file into memory, %llu lines read", fLinesChunkSize, fNRecords);
       }
    }
 
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   const auto nRecords = fRecords.size();
+   const auto nRecords = fNRecords;
    if (0 == nRecords)
       return entryRanges;
 
    const auto chunkSize = nRecords / fNSlots;
    const auto remainder = 1U == fNSlots ? 0 : nRecords % fNSlots;
-   auto start = 0ULL == fEntryRangesRequested ? 0ULL : fProcessedLines;
+   auto start = fProcessedLines;
    auto end = start;
 
    for (auto i : ROOT::TSeqU(fNSlots)) {
@@ -409,30 +571,26 @@ bool RCsvDS::HasColumn(std::string_view colName) const
 bool RCsvDS::SetEntry(unsigned int slot, ULong64_t entry)
 {
    // Here we need to normalise the entry to the number of lines we already processed.
-   const auto offset = (fEntryRangesRequested - 1) * fLinesChunkSize;
-   const auto recordPos = entry - offset;
-   int colIndex = 0;
-   for (auto &colType : fColTypesList) {
-      auto dataPtr = fRecords[recordPos][colIndex];
-      switch (colType) {
+   const auto recordPos = entry - fChunkFirstEntry;
+   for (auto colIndex : ROOT::TSeqU(fColTypesList.size())) {
+      switch (fColTypesList[colIndex]) {
       case 'd': {
-         fDoubleEvtValues[colIndex][slot] = *static_cast<double *>(dataPtr);
+         fDoubleEvtValues[colIndex][slot] = fDoubleColumns[colIndex][recordPos];
          break;
       }
       case 'l': {
-         fLong64EvtValues[colIndex][slot] = *static_cast<Long64_t *>(dataPtr);
+         fLong64EvtValues[colIndex][slot] = fLong64Columns[colIndex][recordPos];
          break;
       }
       case 'b': {
-         fBoolEvtValues[colIndex][slot] = *static_cast<bool *>(dataPtr);
+         fBoolEvtValues[colIndex][slot] = fBoolColumns[colIndex][recordPos];
          break;
       }
       case 's': {
-         fStringEvtValues[colIndex][slot] = *static_cast<std::string *>(dataPtr);
+         fStringEvtValues[colIndex][slot] = fStringColumns[colIndex][recordPos];
          break;
       }
       }
-      colIndex++;
    }
    return true;
 }
@@ -452,6 +610,12 @@ void RCsvDS::SetNSlots(unsigned int nSlots)
    fLong64EvtValues.resize(nColumns, std::vector<Long64_t>(fNSlots));
    fStringEvtValues.resize(nColumns, std::vector<std::string>(fNSlots));
    fBoolEvtValues.resize(nColumns, std::deque<bool>(fNSlots));
+
+   // Initialize the column-wise storage of the records
+   fDoubleColumns.resize(nColumns);
+   fLong64Columns.resize(nColumns);
+   fStringColumns.resize(nColumns);
+   fBoolColumns.resize(nColumns);
 }
 
 std::string RCsvDS::GetLabel()
@@ -46,6 +46,11 @@ std::string RCustomColumnBase::GetName() const
    return fName;
 }
 
+std::string RCustomColumnBase::GetFingerprint() const
+{
+   return "Define:" + fName;
+}
+
 void RCustomColumnBase::InitNode()
 {
    fLastCheckedEntry = std::vector<Long64_t>(fNSlots, -1);
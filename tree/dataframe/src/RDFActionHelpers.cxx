@@ -9,6 +9,7 @@
  *************************************************************************/
 
 #include "ROOT/RDF/ActionHelpers.hxx"
+#include "TEnv.h"
 
 namespace ROOT {
 namespace Internal {
@@ -105,6 +106,19 @@ void FillHelper::Finalize()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////
+/// Return true if FillParHelper should not clone `h` once per slot, because the clones would take more memory than
+/// allowed by the `RDataFrame.MaxHistoCloneMemory` rootrc variable (in MB, default 1024).
+bool MustShareFillObject(const ::TH1 &h, unsigned int nSlots)
+{
+   if (nSlots < 2)
+      return false;
+   const auto nArrays = h.GetSumw2N() > 0 ? 2. : 1.;
+   const auto cloneBytes = nArrays * h.GetNcells() * sizeof(Double_t);
+   const auto maxBytes = gEnv->GetValue("RDataFrame.MaxHistoCloneMemory", 1024.) * 1024. * 1024.;
+   return (nSlots - 1) * cloneBytes > maxBytes;
+}
+
 template void FillHelper::Exec(unsigned int, const std::vector<float> &);
 template void FillHelper::Exec(unsigned int, const std::vector<double> &);
 template void FillHelper::Exec(unsigned int, const std::vector<char> &);
@@ -20,10 +20,12 @@
 #include <TClassEdit.h>
 #include <TFriendElement.h>
 #include <TInterpreter.h>
+#include <TMD5.h>
 #include <TObject.h>
 #include <TRegexp.h>
 #include <TPRegexp.h>
 #include <TString.h>
+#include <TSystem.h>
 #include <TTree.h>
 
 // pragma to disable warnings on Rcpp which have
@@ -142,6 +144,62 @@ std::string DemangleTypeIdName(const std::type_info &typeInfo)
    return TClassEdit::DemangleTypeIdName(typeInfo, dummy);
 }
 
+////////////////////////////////////////////////////////////////////////////
+/// Return the name of the file that caches the result of the computation described by `fingerprints`.
+/// The name is built from the MD5 hash of the fingerprints. The cache directory is created if needed.
+std::string GetPersistentCacheFileName(std::string_view cacheDir, const std::vector<std::string> &fingerprints)
+{
+   TMD5 md5;
+   for (const auto &fingerprint : fingerprints) {
+      // include the terminating null character so that {"ab", "c"} and {"a", "bc"} hash differently
+      md5.Update(reinterpret_cast<const UChar_t *>(fingerprint.c_str()), fingerprint.size() + 1);
+   }
+   md5.Final();
+
+   const std::string dirName(cacheDir);
+   if (gSystem->AccessPathName(dirName.c_str()) && gSystem->mkdir(dirName.c_str(), /*recursive=*/true) != 0)
+      throw std::runtime_error("PersistentCache: cannot create the cache directory \"" + dirName + "\".");
+
+   return dirName + "/rdfcache_" + md5.AsString() + ".root";
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Return true if a (complete) cache file with this name exists.
+/// Cache files are written under a temporary name and only renamed when complete, see CommitPersistentCacheFile.
+bool HasPersistentCacheFile(const std::string &fileName)
+{
+   return !gSystem->AccessPathName(fileName.c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Return a name under which this process can write the cache file `fileName` without clashing with other writers.
+std::string GetPersistentCacheTmpFileName(const std::string &fileName)
+{
+   return fileName + ".tmp" + std::to_string(gSystem->GetPid()) + ".root";
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Make a fully written cache file visible to other processes, atomically.
+void CommitPersistentCacheFile(const std::string &tmpFileName, const std::string &fileName)
+{
+   if (gSystem->Rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+      gSystem->Unlink(tmpFileName.c_str());
+      throw std::runtime_error("PersistentCache: cannot move \"" + tmpFileName + "\" to \"" + fileName + "\".");
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Return the head node of a computation graph that reads the cached columns from the cache file `fileName`.
+std::shared_ptr<RLoopManager> OpenPersistentCache(const std::string &fileName)
+{
+   ::TDirectory::TContext ctxt;
+   auto chain = std::make_shared<TChain>(kPersistentCacheTreeName);
+   chain->Add(fileName.c_str());
+   auto lm = std::make_shared<RLoopManager>(nullptr, ColumnNames_t{});
+   lm->SetTree(chain);
+   return lm;
+}
+
 ColumnNames_t ConvertRegexToColumns(const RDFInternal::RBookedCustomColumns & customColumns,
                                     TTree *tree,
                                     ROOT::RDF::RDataSource *dataSource,
@@ -24,6 +24,18 @@ void RJittedAction::Run(unsigned int slot, Long64_t entry)
    fConcreteAction->Run(slot, entry);
 }
 
+void RJittedAction::RunFused(unsigned int slot, ULong64_t begin, ULong64_t end, ROOT::RDF::RDataSource *ds)
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   fConcreteAction->RunFused(slot, begin, end, ds);
+}
+
+void RJittedAction::RunFused(unsigned int slot, TTreeReader &r, Long64_t firstEntry)
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   fConcreteAction->RunFused(slot, r, firstEntry);
+}
+
 void RJittedAction::Initialize()
 {
    R__ASSERT(fConcreteAction != nullptr);
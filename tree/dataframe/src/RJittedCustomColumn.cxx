@@ -31,7 +31,7 @@ const std::type_info &RJittedCustomColumn::GetTypeId() const
    return fConcreteCustomColumn->GetTypeId();
 }
 
-void RJittedCustomColumn::Update(unsigned int slot, Long64_t entry)
+void RJittedCustomColumn::UpdateImpl(unsigned int slot, Long64_t entry)
 {
    R__ASSERT(fConcreteCustomColumn != nullptr);
    fConcreteCustomColumn->Update(slot, entry);
@@ -46,5 +46,6 @@ void RJittedCustomColumn::ClearValueReaders(unsigned int slot)
 void RJittedCustomColumn::InitNode()
 {
    R__ASSERT(fConcreteCustomColumn != nullptr);
+   RCustomColumnBase::InitNode(); // Update checks this node's fLastCheckedEntry before forwarding
    fConcreteCustomColumn->InitNode();
 }
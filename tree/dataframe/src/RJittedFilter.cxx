@@ -15,8 +15,8 @@
 
 using namespace ROOT::Detail::RDF;
 
-RJittedFilter::RJittedFilter(RLoopManager *lm, std::string_view name)
-   : RFilterBase(lm, name, lm->GetNSlots(), RDFInternal::RBookedCustomColumns()) { }
+RJittedFilter::RJittedFilter(RLoopManager *lm, std::string_view name, std::string_view expression)
+   : RFilterBase(lm, name, lm->GetNSlots(), RDFInternal::RBookedCustomColumns()), fExpression(expression) { }
 
 void RJittedFilter::SetFilter(std::unique_ptr<RFilterBase> f)
 {
@@ -59,6 +59,12 @@ void RJittedFilter::IncrChildrenCount()
    fConcreteFilter->IncrChildrenCount();
 }
 
+unsigned int RJittedFilter::GetNChildren() const
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->GetNChildren();
+}
+
 void RJittedFilter::StopProcessing()
 {
    R__ASSERT(fConcreteFilter != nullptr);
@@ -110,6 +116,17 @@ void RJittedFilter::AddFilterName(std::vector<std::string> &filters)
    fConcreteFilter->AddFilterName(filters);
 }
 
+void RJittedFilter::AddFingerprint(std::vector<std::string> &fingerprints)
+{
+   if (fConcreteFilter == nullptr) {
+      // No event loop performed yet, but the JITTING must be performed.
+      GetLoopManagerUnchecked()->Jit();
+   }
+   fConcreteFilter->AddFingerprint(fingerprints);
+   // The type of the jitted lambda depends on the interpreter session, the expression does not
+   fingerprints.back() = "Filter:" + fName + ':' + fExpression;
+}
+
 std::shared_ptr<RDFGraphDrawing::GraphNode> RJittedFilter::GetGraph()
 {
    if (fConcreteFilter != nullptr) {
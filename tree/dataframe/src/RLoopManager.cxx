@@ -9,18 +9,26 @@
 #include "RtypesCore.h" // Long64_t
 #include "TBranchElement.h"
 #include "TBranchObject.h"
+#include "TChain.h"
+#include "TChainElement.h"
 #include "TEntryList.h"
+#include "TEnv.h"
 #include "TError.h"
+#include "TFile.h"
+#include "TFriendElement.h"
 #include "TInterpreter.h"
 #include "TROOT.h" // IsImplicitMTEnabled
+#include "TSystem.h"
 #include "TTreeReader.h"
 
 #ifdef R__USE_IMT
 #include "ROOT/TThreadExecutor.hxx"
 #endif
 
+#include <algorithm>
 #include <atomic>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -226,18 +234,54 @@ void RLoopManager::CheckIndexedFriends()
    }
 }
 
+/// Return true if any Range will be run during the event loop.
+bool RLoopManager::HasActiveRanges() const
+{
+   return std::any_of(fBookedRanges.begin(), fBookedRanges.end(), [](RRangeBase *r) { return r->HasChildren(); });
+}
+
+/// Return the entry numbers [first, second) outside of which no entry is processed by any action, because all the
+/// branches of the computation graph start with a Range. second is 0 if entries must be processed until the end of the
+/// dataset. Only valid in multi-thread event loops, where Ranges can only be applied to the RLoopManager.
+std::pair<ULong64_t, ULong64_t> RLoopManager::GetRangesBoundaries() const
+{
+   unsigned int nActiveRanges = 0u;
+   auto begin = std::numeric_limits<ULong64_t>::max();
+   ULong64_t end = 0ull;
+   bool untilTheEnd = false;
+   for (auto range : fBookedRanges) {
+      if (!range->HasChildren())
+         continue;
+      ++nActiveRanges;
+      begin = std::min<ULong64_t>(begin, range->GetStart());
+      if (range->GetStop() == 0u)
+         untilTheEnd = true;
+      else
+         end = std::max<ULong64_t>(end, range->GetStop());
+   }
+   // some actions or Filters do not hang from a Range: all entries must be processed
+   if (nActiveRanges == 0u || nActiveRanges != fNChildren)
+      return {0ull, 0ull};
+   return {begin, untilTheEnd ? 0ull : end};
+}
+
 /// Run event loop with no source files, in parallel.
 void RLoopManager::RunEmptySourceMT()
 {
 #ifdef R__USE_IMT
    RSlotStack slotStack(fNSlots);
    // Working with an empty tree.
+   // Only generate the entries selected by Ranges, if all branches of the graph start with one.
+   const auto boundaries = GetRangesBoundaries();
+   const auto firstEntry = boundaries.first;
+   const auto endEntry = boundaries.second == 0ull ? fNEmptyEntries : std::min(boundaries.second, fNEmptyEntries);
+   const auto nEntries = endEntry > firstEntry ? endEntry - firstEntry : 0ull;
    // Evenly partition the entries according to fNSlots. Produce around 2 tasks per slot.
-   const auto nEntriesPerSlot = fNEmptyEntries / (fNSlots * 2);
-   auto remainder = fNEmptyEntries % (fNSlots * 2);
+   const auto nEntriesPerSlot = nEntries / (fNSlots * 2);
+   auto remainder = nEntries % (fNSlots * 2);
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   ULong64_t start = 0;
-   while (start < fNEmptyEntries) {
+   ULong64_t start = firstEntry;
+   while (start < endEntry) {
       ULong64_t end = start + nEntriesPerSlot;
       if (remainder > 0) {
          ++end;
@@ -251,8 +295,12 @@ void RLoopManager::RunEmptySourceMT()
    auto genFunction = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
       auto slot = slotStack.GetSlot();
       InitNodeSlots(nullptr, slot);
-      for (auto currEntry = range.first; currEntry < range.second; ++currEntry) {
-         RunAndCheckFilters(slot, currEntry);
+      if (fRunFused) {
+         fBookedActions.front()->RunFused(slot, range.first, range.second, nullptr);
+      } else {
+         for (auto currEntry = range.first; currEntry < range.second; ++currEntry) {
+            RunAndCheckFilters(slot, currEntry);
+         }
       }
       CleanUpTask(slot);
       slotStack.ReturnSlot(slot);
@@ -268,8 +316,12 @@ void RLoopManager::RunEmptySourceMT()
 void RLoopManager::RunEmptySource()
 {
    InitNodeSlots(nullptr, 0);
-   for (ULong64_t currEntry = 0; currEntry < fNEmptyEntries && fNStopsReceived < fNChildren; ++currEntry) {
-      RunAndCheckFilters(0, currEntry);
+   if (fRunFused) {
+      fBookedActions.front()->RunFused(0u, 0ull, fNEmptyEntries, nullptr);
+   } else {
+      for (ULong64_t currEntry = 0; currEntry < fNEmptyEntries && fNStopsReceived < fNChildren; ++currEntry) {
+         RunAndCheckFilters(0, currEntry);
+      }
    }
    CleanUpTask(0u);
 }
@@ -283,17 +335,34 @@ void RLoopManager::RunTreeProcessorMT()
    const auto &entryList = fTree->GetEntryList() ? *fTree->GetEntryList() : TEntryList();
    auto tp = std::make_unique<ROOT::TTreeProcessorMT>(*fTree, entryList);
 
+   // Ranges select entries by their global entry number, which the readers only provide if an entries range is set.
+   // Files that only contain entries beyond the end of all Ranges are not even opened.
+   const bool hasRanges = HasActiveRanges();
+   if (hasRanges) {
+      if (entryList.GetN() > 0)
+         throw std::runtime_error("Range is not supported in multi-thread event loops over a TTree with an entry list.");
+      const auto boundaries = GetRangesBoundaries();
+      tp->SetEntriesRange(boundaries.first, boundaries.second);
+   }
+
    std::atomic<ULong64_t> entryCount(0ull);
 
-   tp->Process([this, &slotStack, &entryCount](TTreeReader &r) -> void {
+   tp->Process([this, &slotStack, &entryCount, hasRanges](TTreeReader &r) -> void {
       auto slot = slotStack.GetSlot();
       InitNodeSlots(&r, slot);
       const auto entryRange = r.GetEntriesRange(); // we trust TTreeProcessorMT to call SetEntriesRange
       const auto nEntries = entryRange.second - entryRange.first;
       auto count = entryCount.fetch_add(nEntries);
-      // recursive call to check filters and conditionally execute actions
-      while (r.Next()) {
-         RunAndCheckFilters(slot, count++);
+      if (fRunFused) {
+         fBookedActions.front()->RunFused(slot, r, hasRanges ? -1ll : Long64_t(count));
+      } else {
+         // recursive call to check filters and conditionally execute actions
+         while (r.Next()) {
+            if (hasRanges)
+               RunAndCheckFilters(slot, r.GetCurrentEntry());
+            else
+               RunAndCheckFilters(slot, count++);
+         }
       }
       CleanUpTask(slot);
       slotStack.ReturnSlot(slot);
@@ -312,8 +381,12 @@ void RLoopManager::RunTreeReader()
 
    // recursive call to check filters and conditionally execute actions
    // in the non-MT case processing can be stopped early by ranges, hence the check on fNStopsReceived
-   while (r.Next() && fNStopsReceived < fNChildren) {
-      RunAndCheckFilters(0, r.GetCurrentEntry());
+   if (fRunFused) {
+      fBookedActions.front()->RunFused(0u, r, -1ll);
+   } else {
+      while (r.Next() && fNStopsReceived < fNChildren) {
+         RunAndCheckFilters(0, r.GetCurrentEntry());
+      }
    }
    CleanUpTask(0u);
 }
@@ -328,6 +401,10 @@ void RLoopManager::RunDataSource()
       InitNodeSlots(nullptr, 0u);
       fDataSource->InitSlot(0u, 0ull);
       for (const auto &range : ranges) {
+         if (fRunFused) {
+            fBookedActions.front()->RunFused(0u, range.first, range.second, fDataSource.get());
+            continue;
+         }
          auto end = range.second;
          for (auto entry = range.first; entry < end; ++entry) {
             if (fDataSource->SetEntry(0u, entry)) {
@@ -356,9 +433,13 @@ void RLoopManager::RunDataSourceMT()
       InitNodeSlots(nullptr, slot);
       fDataSource->InitSlot(slot, range.first);
       const auto end = range.second;
-      for (auto entry = range.first; entry < end; ++entry) {
-         if (fDataSource->SetEntry(slot, entry)) {
-            RunAndCheckFilters(slot, entry);
+      if (fRunFused) {
+         fBookedActions.front()->RunFused(slot, range.first, end, fDataSource.get());
+      } else {
+         for (auto entry = range.first; entry < end; ++entry) {
+            if (fDataSource->SetEntry(slot, entry)) {
+               RunAndCheckFilters(slot, entry);
+            }
          }
       }
       CleanUpTask(slot);
@@ -366,9 +447,25 @@ void RLoopManager::RunDataSourceMT()
       slotStack.ReturnSlot(slot);
    };
 
+   // Skip the entries that are not selected by Ranges, if all branches of the graph start with one
+   const auto boundaries = GetRangesBoundaries();
+   auto clipRanges = [&boundaries](std::vector<std::pair<ULong64_t, ULong64_t>> &ranges) {
+      if (boundaries.first == 0ull && boundaries.second == 0ull)
+         return;
+      std::vector<std::pair<ULong64_t, ULong64_t>> clipped;
+      for (const auto &range : ranges) {
+         const auto start = std::max(range.first, boundaries.first);
+         const auto end = boundaries.second == 0ull ? range.second : std::min(range.second, boundaries.second);
+         if (start < end)
+            clipped.emplace_back(start, end);
+      }
+      ranges = std::move(clipped);
+   };
+
    fDataSource->Initialise();
    auto ranges = fDataSource->GetEntryRanges();
    while (!ranges.empty()) {
+      clipRanges(ranges);
       pool.Foreach(runOnRange, ranges);
       ranges = fDataSource->GetEntryRanges();
    }
@@ -388,6 +485,22 @@ void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
       callback(slot);
 }
 
+/// Whether the event loop can run the only booked action through RActionBase::RunFused, which processes all entries in
+/// a single call instead of one RunAndCheckFilters call per entry. This is opt-in (`RDataFrame.FusedEventLoop` in
+/// .rootrc) and requires the graph to be made of a single branch: one action, no node with more than one child (so no
+/// named filter outside of the action's chain), and no callback to invoke per entry. Must be called after
+/// EvalChildrenCounts.
+bool RLoopManager::CanRunFused() const
+{
+   if (!gEnv->GetValue("RDataFrame.FusedEventLoop", 0))
+      return false;
+   if (fBookedActions.size() != 1u || !fCallbacks.empty() || fNChildren != 1u)
+      return false;
+   auto hasOneChildAtMost = [](const RNodeBase *node) { return node->GetNChildren() <= 1u; };
+   return std::all_of(fBookedFilters.begin(), fBookedFilters.end(), hasOneChildAtMost) &&
+          std::all_of(fBookedRanges.begin(), fBookedRanges.end(), hasOneChildAtMost);
+}
+
 /// Build TTreeReaderValues for all nodes
 /// This method loops over all filters, actions and other booked objects and
 /// calls their `InitRDFValues` methods. It is called once per node per slot, before
@@ -504,6 +617,7 @@ void RLoopManager::Run()
    Jit();
 
    InitNodes();
+   fRunFused = CanRunFused();
 
    switch (fLoopType) {
    case ELoopType::kNoFilesMT: RunEmptySourceMT(); break;
@@ -564,12 +678,6 @@ void RLoopManager::Deregister(RRangeBase *rangePtr)
    RDFInternal::Erase(rangePtr, fBookedRanges);
 }
 
-// dummy call, end of recursive chain of calls
-bool RLoopManager::CheckFilters(unsigned int, Long64_t)
-{
-   return true;
-}
-
 /// Call `FillReport` on all booked filters
 void RLoopManager::Report(ROOT::RDF::RCutFlowReport &rep) const
 {
@@ -595,6 +703,94 @@ std::vector<std::string> RLoopManager::GetFiltersNames()
    return filters;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// Append to `fingerprint` the name of a file and, if it is a local file, its size and modification time.
+static void AddFileFingerprint(const std::string &fileName, std::string &fingerprint)
+{
+   fingerprint += ':' + fileName;
+   FileStat_t stat;
+   if (gSystem->GetPathInfo(fileName.c_str(), stat) == 0)
+      fingerprint += '@' + std::to_string(stat.fSize) + '@' + std::to_string(stat.fMtime);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Append to `fingerprint` the name, the size and a hash of the entry numbers (and tree numbers) of an entry list.
+static void AddEntryListFingerprint(TEntryList &elist, std::string &fingerprint)
+{
+   // FNV-1a, 64 bits
+   ULong64_t hash = 14695981039346656037ull;
+   auto addToHash = [&hash](Long64_t value) {
+      for (auto i = 0u; i < sizeof(value); ++i) {
+         hash ^= (value >> (8 * i)) & 0xff;
+         hash *= 1099511628211ull;
+      }
+   };
+   const auto n = elist.GetN();
+   for (Long64_t i = 0; i < n; ++i) {
+      Int_t treeNumber = 0;
+      addToHash(elist.GetEntryAndTree(i, treeNumber));
+      addToHash(treeNumber);
+   }
+   fingerprint += std::string(":entrylist:") + elist.GetName() + ':' + std::to_string(n) + ':' + std::to_string(hash);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Append to `fingerprint` the name, the input files, the entry list and the friends of a tree or chain.
+/// Return false if the content of the tree cannot be identified, i.e. if it or one of its friends is in memory.
+static bool AddTreeFingerprint(TTree &t, std::string &fingerprint)
+{
+   bool identified = true;
+   fingerprint += std::string(":tree:") + t.GetName();
+   if (auto ch = dynamic_cast<TChain *>(&t)) {
+      for (auto f : *ch->GetListOfFiles()) {
+         fingerprint += std::string(":") + f->GetName();
+         AddFileFingerprint(f->GetTitle(), fingerprint);
+      }
+   } else if (auto f = t.GetCurrentFile()) {
+      AddFileFingerprint(f->GetName(), fingerprint);
+   } else {
+      // an in-memory tree: two trees with the same name and size may hold different data
+      fingerprint += ':' + std::to_string(t.GetEntries());
+      identified = false;
+   }
+   if (auto elist = t.GetEntryList())
+      AddEntryListFingerprint(*elist, fingerprint);
+   if (auto friends = t.GetListOfFriends()) {
+      for (auto fr : *friends) {
+         auto frElement = static_cast<TFriendElement *>(fr);
+         fingerprint += std::string(":friend:") + frElement->GetName();
+         if (auto frTree = frElement->GetTree())
+            identified = AddTreeFingerprint(*frTree, fingerprint) && identified;
+      }
+   }
+   return identified;
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Head of the recursive chain of calls: describe the input dataset.
+/// For ROOT files, file names, sizes and modification times are taken into account, as well as the entry numbers of
+/// an entry list. The input of a data-source or of an in-memory tree cannot be inspected: two sources with the same
+/// columns, or two trees with the same name and size, may hold different data, so their fingerprint is marked as
+/// unidentified.
+void RLoopManager::AddFingerprint(std::vector<std::string> &fingerprints)
+{
+   std::string fingerprint;
+   if (fDataSource) {
+      fingerprint = RDFInternal::kUnidentifiedFingerprint + ("DataSource:" + fDataSource->GetLabel());
+      for (const auto &c : fDataSource->GetColumnNames())
+         fingerprint += ':' + c + ':' + fDataSource->GetTypeName(c);
+   } else if (fTree) {
+      fingerprint = "Tree";
+      if (!AddTreeFingerprint(*fTree, fingerprint))
+         fingerprint.insert(0, 1, RDFInternal::kUnidentifiedFingerprint);
+   } else {
+      fingerprint = "Empty:" + std::to_string(fNEmptyEntries);
+   }
+   for (const auto &alias : fAliasColumnNameMap)
+      fingerprint += ":alias:" + alias.first + ':' + alias.second;
+   fingerprints.emplace_back(std::move(fingerprint));
+}
+
 std::vector<RDFInternal::RActionBase *> RLoopManager::GetAllActions()
 {
    std::vector<RDFInternal::RActionBase *> actions;
@@ -8,6 +8,7 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 
+#include "ROOT/RDF/RLoopManager.hxx"
 #include "ROOT/RDF/RRangeBase.hxx"
 
 using ROOT::Detail::RDF::RRangeBase;
@@ -17,6 +18,14 @@ RRangeBase::RRangeBase(RLoopManager *implPtr, unsigned int start, unsigned int s
                        const unsigned int nSlots)
    : RNodeBase(implPtr), fStart(start), fStop(stop), fStride(stride), fNSlots(nSlots) { }
 
+void RRangeBase::InitNode()
+{
+   ResetCounters();
+   // in multi-thread event loops entries are not processed in order: Ranges (which are then only allowed directly on
+   // the RLoopManager) select entries according to their number
+   fSelectByEntryNumber = fLoopManager->IsMultiThreaded();
+}
+
 void RRangeBase::ResetCounters()
 {
    fLastCheckedEntry = -1;
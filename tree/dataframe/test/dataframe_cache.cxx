@@ -1,9 +1,12 @@
 #include "ROOT/RDataFrame.hxx"
 #include "ROOT/TSeq.hxx"
 #include "ROOT/RTrivialDS.hxx"
+#include "TEntryList.h"
+#include "TFile.h"
 #include "TH1F.h"
 #include "TRandom.h"
 #include "TSystem.h"
+#include "TTree.h"
 
 #include "gtest/gtest.h"
 
@@ -336,3 +339,161 @@ TEST(Cache, Carrays)
 }
 
 #endif // R__B64
+
+// Remove a persistent cache directory and its content, if any.
+static void RemovePersistentCacheDir(const char *cacheDir)
+{
+   if (auto dir = gSystem->OpenDirectory(cacheDir)) {
+      while (auto entry = gSystem->GetDirEntry(dir))
+         gSystem->Unlink((std::string(cacheDir) + "/" + entry).c_str());
+      gSystem->FreeDirectory(dir);
+   }
+   gSystem->Unlink(cacheDir);
+}
+
+TEST(Cache, Persistent)
+{
+   const auto cacheDir = "PersistentCacheDir";
+   // a leftover cache from a previous run would hide the computations below
+   RemovePersistentCacheDir(cacheDir);
+   auto nCalls = 0U;
+   auto makeCache = [&nCalls, cacheDir](std::string_view cut) {
+      auto d = ROOT::RDataFrame(10).Define("x", [&nCalls](ULong64_t e) {
+         ++nCalls;
+         return double(e);
+      }, {"rdfentry_"});
+      return d.Filter(cut).PersistentCache(cacheDir, {"x"}, "x is the entry number");
+   };
+
+   auto cached = makeCache("x > 4");
+   EXPECT_EQ(10U, nCalls);
+   EXPECT_EQ(5ULL, *cached.Count());
+   EXPECT_DOUBLE_EQ(7., *cached.Mean<double>("x"));
+
+   // same computation graph: the cached columns are read back, nothing is recomputed
+   auto cachedAgain = makeCache("x > 4");
+   EXPECT_EQ(5ULL, *cachedAgain.Count());
+   EXPECT_EQ(10U, nCalls);
+
+   // a different cut invalidates the cache
+   auto cachedOther = makeCache("x > 7");
+   EXPECT_EQ(20U, nCalls);
+   EXPECT_EQ(2ULL, *cachedOther.Count());
+
+   EXPECT_THROW(ROOT::RDataFrame(1).PersistentCache(cacheDir, {}), std::runtime_error);
+
+   RemovePersistentCacheDir(cacheDir);
+}
+
+static bool PersistentCutA(double x)
+{
+   return x > 4;
+}
+
+static bool PersistentCutB(double x)
+{
+   return x > 7;
+}
+
+TEST(Cache, PersistentCompiledCallables)
+{
+   const auto cacheDir = "PersistentCacheCompiledDir";
+   RemovePersistentCacheDir(cacheDir);
+   auto d = ROOT::RDataFrame(10).Define("x", "double(rdfentry_)");
+
+   // two functions of the same type, or the same lambda with different captures, cannot be told apart
+   EXPECT_THROW(d.Filter(PersistentCutA, {"x"}).PersistentCache(cacheDir, {"x"}), std::runtime_error);
+   auto cut = [](double threshold) { return [threshold](double x) { return x > threshold; }; };
+   EXPECT_THROW(d.Filter(cut(4), {"x"}).PersistentCache(cacheDir, {"x"}), std::runtime_error);
+   EXPECT_THROW(d.Define("y", [](double x) { return x; }, {"x"}).PersistentCache(cacheDir, {"y"}),
+                std::runtime_error);
+
+   // with a key, they get separate cache entries
+   auto cachedA = d.Filter(PersistentCutA, {"x"}).PersistentCache(cacheDir, {"x"}, "x > 4");
+   auto cachedB = d.Filter(PersistentCutB, {"x"}).PersistentCache(cacheDir, {"x"}, "x > 7");
+   EXPECT_EQ(5ULL, *cachedA.Count());
+   EXPECT_EQ(2ULL, *cachedB.Count());
+   auto cachedLambda4 = d.Filter(cut(4), {"x"}).PersistentCache(cacheDir, {"x"}, "lambda x > 4");
+   auto cachedLambda8 = d.Filter(cut(8), {"x"}).PersistentCache(cacheDir, {"x"}, "lambda x > 8");
+   EXPECT_EQ(5ULL, *cachedLambda4.Count());
+   EXPECT_EQ(1ULL, *cachedLambda8.Count());
+
+   RemovePersistentCacheDir(cacheDir);
+}
+
+TEST(Cache, PersistentDataSource)
+{
+   const auto cacheDir = "PersistentCacheDataSourceDir";
+   RemovePersistentCacheDir(cacheDir);
+
+   // the input of a data-source cannot be identified
+   auto makeDF = [](ULong64_t size) {
+      std::unique_ptr<RDataSource> tds(new RTrivialDS(size));
+      return ROOT::RDataFrame(std::move(tds));
+   };
+   EXPECT_THROW(makeDF(10).PersistentCache(cacheDir, {"col0"}), std::runtime_error);
+
+   auto cached10 = makeDF(10).PersistentCache(cacheDir, {"col0"}, "10 entries");
+   auto cached20 = makeDF(20).PersistentCache(cacheDir, {"col0"}, "20 entries");
+   EXPECT_EQ(10ULL, *cached10.Count());
+   EXPECT_EQ(20ULL, *cached20.Count());
+
+   RemovePersistentCacheDir(cacheDir);
+}
+
+TEST(Cache, PersistentTree)
+{
+   const auto cacheDir = "PersistentCacheTreeDir";
+   const auto fileName = "PersistentCacheTree.root";
+   RemovePersistentCacheDir(cacheDir);
+   {
+      TFile f(fileName, "RECREATE");
+      TTree t("t", "t");
+      double x = 0.;
+      t.Branch("x", &x);
+      for (auto i : ROOT::TSeqI(10)) {
+         x = i;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   // two entry lists of the same name and size, selecting different entries
+   TFile f(fileName);
+   auto t = f.Get<TTree>("t");
+   ASSERT_NE(t, nullptr);
+   TEntryList low("elist", "elist");
+   TEntryList high("elist", "elist");
+   for (auto i : ROOT::TSeqI(3)) {
+      low.Enter(i, t);
+      high.Enter(7 + i, t);
+   }
+   t->SetEntryList(&low);
+   auto cachedLow = ROOT::RDataFrame(*t).PersistentCache(cacheDir, {"x"});
+   EXPECT_DOUBLE_EQ(1., *cachedLow.Mean<double>("x"));
+   t->SetEntryList(&high);
+   auto cachedHigh = ROOT::RDataFrame(*t).PersistentCache(cacheDir, {"x"});
+   EXPECT_DOUBLE_EQ(8., *cachedHigh.Mean<double>("x"));
+   t->SetEntryList(nullptr);
+
+   // two in-memory trees of the same name and size may hold different data
+   TTree memTree("t", "t");
+   memTree.SetDirectory(nullptr);
+   double x = 0.;
+   memTree.Branch("x", &x);
+   for (auto i : ROOT::TSeqI(10)) {
+      x = i;
+      memTree.Fill();
+   }
+   EXPECT_THROW(ROOT::RDataFrame(memTree).PersistentCache(cacheDir, {"x"}), std::runtime_error);
+   auto cachedMem = ROOT::RDataFrame(memTree).PersistentCache(cacheDir, {"x"}, "entry numbers");
+   EXPECT_EQ(10ULL, *cachedMem.Count());
+
+   // a friend in memory cannot be identified either
+   t->AddFriend(&memTree, "mem");
+   EXPECT_THROW(ROOT::RDataFrame(*t).PersistentCache(cacheDir, {"x"}), std::runtime_error);
+   t->RemoveFriend(&memTree);
+
+   RemovePersistentCacheDir(cacheDir);
+   gSystem->Unlink(fileName);
+}
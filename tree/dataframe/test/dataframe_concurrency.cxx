@@ -1,7 +1,9 @@
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/TThreadExecutor.hxx>
+#include <TEnv.h>
 #include <atomic>
 #include <chrono>
+#include <cmath>
 #include <thread>
 
 #include "gtest/gtest.h"
@@ -42,3 +44,48 @@ TEST(RDFConcurrency, NestedParallelismBetweenDefineCalls)
    ROOT::DisableImplicitMT();
 }
 #endif
+
+#ifdef R__USE_IMT
+TEST(RDFConcurrency, BufferedHistoFilling)
+{
+   const auto nEntries = 100000u;
+   auto fillAll = [&] {
+      auto df = ROOT::RDataFrame(nEntries)
+                   .Define("x", [](ULong64_t e) { return double(e % 1000) / 100.; }, {"rdfentry_"})
+                   .Define("y", [](ULong64_t e) { return double(e % 777) / 77.7; }, {"rdfentry_"});
+      auto h1 = df.Histo1D<double, double>({"h1", "h1", 64, 0., 10.}, "x", "y");
+      auto h2 = df.Histo2D<double, double>({"h2", "h2", 16, 0., 10., 16, 0., 10.}, "x", "y");
+      auto p1 = df.Profile1D<double, double>({"p1", "p1", 16, 0., 10.}, "x", "y");
+      std::vector<std::unique_ptr<TH1>> res;
+      for (TH1 *h : std::initializer_list<TH1 *>{h1.GetPtr(), h2.GetPtr(), p1.GetPtr()}) {
+         res.emplace_back(static_cast<TH1 *>(h->Clone()));
+         res.back()->SetDirectory(nullptr);
+      }
+      return res;
+   };
+   auto checkEqual = [](const TH1 &h, const TH1 &ref) {
+      EXPECT_DOUBLE_EQ(h.GetEntries(), ref.GetEntries());
+      EXPECT_DOUBLE_EQ(h.GetMean(), ref.GetMean());
+      for (auto bin = 0; bin < ref.GetNcells(); ++bin)
+         EXPECT_NEAR(h.GetBinContent(bin), ref.GetBinContent(bin), 1e-9 * std::abs(ref.GetBinContent(bin)));
+   };
+
+   const auto refs = fillAll();
+
+   // one histogram per slot, buffered and merged at the end of the event loop
+   ROOT::EnableImplicitMT(4);
+   const auto clones = fillAll();
+
+   // a single histogram shared by all slots, filled under a lock
+   const auto oldBudget = gEnv->GetValue("RDataFrame.MaxHistoCloneMemory", 1024.);
+   gEnv->SetValue("RDataFrame.MaxHistoCloneMemory", 0.);
+   const auto shared = fillAll();
+   gEnv->SetValue("RDataFrame.MaxHistoCloneMemory", oldBudget);
+   ROOT::DisableImplicitMT();
+
+   for (auto i = 0u; i < refs.size(); ++i) {
+      checkEqual(*clones[i], *refs[i]);
+      checkEqual(*shared[i], *refs[i]);
+   }
+}
+#endif
@@ -1,5 +1,8 @@
 #include "ROOT/RDataFrame.hxx"
 #include <TROOT.h>
+#include <TSystem.h>
+
+#include <algorithm>
 
 #include "gtest/gtest.h"
 
@@ -91,18 +94,60 @@ TEST_F(RDFRanges, NoEarlyStopping)
 }
 
 #ifdef R__USE_IMT
-TEST(RDFRangesMT, ThrowIfIMT)
+TEST(RDFRangesMT, ThrowIfNotOnHead)
 {
-   bool hasThrown = false;
    ROOT::EnableImplicitMT();
    RDataFrame d(0);
+   bool hasThrown = false;
    try {
-      d.Range(0);
+      d.Filter([] { return true; }).Range(0);
    } catch (const std::exception &e) {
       hasThrown = true;
-      EXPECT_STREQ(e.what(), "Range was called with ImplicitMT enabled, but multi-thread is not supported.");
+      EXPECT_STREQ(e.what(), "Range: in multi-thread event loops, Ranges can only be applied directly to the "
+                             "RDataFrame, as entries are not processed in order.");
    }
    EXPECT_TRUE(hasThrown);
+   ROOT::DisableImplicitMT();
+}
+
+TEST(RDFRangesMT, EmptySource)
+{
+   ROOT::EnableImplicitMT(4);
+   RDataFrame d(1000);
+   auto c = d.Range(10).Count();
+   auto m = d.Range(5, 50).Max<ULong64_t>("rdfentry_");
+   auto t = d.Range(5, 10, 3).Take<ULong64_t>("rdfentry_");
+   auto all = d.Count();
+   auto f = d.Range(100, 200).Filter([](ULong64_t e) { return e % 2 == 0; }, {"rdfentry_"}).Count();
+   EXPECT_EQ(*c, 10u);
+   EXPECT_EQ(*m, 49u);
+   auto tv = *t;
+   std::sort(tv.begin(), tv.end());
+   EXPECT_EQ(tv, std::vector<ULong64_t>({5, 8}));
+   EXPECT_EQ(*all, 1000u);
+   EXPECT_EQ(*f, 50u);
+   ROOT::DisableImplicitMT();
+}
+
+TEST(RDFRangesMT, Tree)
+{
+   const auto fileName = "dataframe_ranges_mt.root";
+   const auto treeName = "t";
+   {
+      RDataFrame d(1000);
+      d.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"}).Snapshot<int>(treeName, fileName, {"x"});
+   }
+   ROOT::EnableImplicitMT(4);
+   {
+      RDataFrame d(treeName, fileName);
+      auto c = d.Range(100, 300).Count();
+      auto s = d.Range(100, 300, 2).Sum<int>("x");
+      EXPECT_EQ(*c, 200u);
+      // entries 100, 102, ..., 298
+      EXPECT_EQ(*s, 100 * (100 + 298) / 2);
+   }
+   ROOT::DisableImplicitMT();
+   gSystem->Unlink(fileName);
 }
 #endif
 
@@ -1,10 +1,12 @@
 /****** Run RDataFrame tests both with and without IMT enabled *******/
 #include <gtest/gtest.h>
 #include <ROOT/RDataFrame.hxx>
+#include <ROOT/RTrivialDS.hxx>
 #include <ROOT/TSeq.hxx>
 #include <TFile.h>
 #include <TGraph.h>
 #include <TInterpreter.h>
+#include <TEnv.h>
 #include <TRandom.h>
 #include <TROOT.h>
 #include <TSystem.h>
@@ -1035,6 +1037,106 @@ TEST(RDFSimpleTests, ScalarValuesCollectionWeights)
    EXPECT_ANY_THROW(*h);
 }
 
+// The columns of simple branches of fundamental type are read basket by basket with the bulk API of TBranch
+TEST_P(RDFSimpleTests, BulkReadOfSimpleBranches)
+{
+   const std::vector<std::string> fileNames{"dataframe_simple_bulk0.root", "dataframe_simple_bulk1.root"};
+   const std::vector<int> nEntries{1000, 1500};
+   const std::vector<int> bufSizes{400, 1000};
+   int first = 0;
+   for (auto f : ROOT::TSeqU(fileNames.size())) {
+      TFile file(fileNames[f].c_str(), "RECREATE");
+      TTree t("t", "t");
+      int i;
+      double d;
+      std::vector<float> v;
+      t.Branch("i", &i, bufSizes[f]);
+      t.Branch("d", &d, bufSizes[f]);
+      t.Branch("v", &v, bufSizes[f]);
+      for (i = first; i < first + nEntries[f]; ++i) {
+         d = 0.5 * i;
+         v.assign(i % 3, i);
+         t.Fill();
+      }
+      first = i;
+      t.Write();
+   }
+   const int total = first;
+
+   ROOT::RDataFrame df("t", fileNames);
+   auto sumI = df.Sum<int>("i");
+   auto ds = df.Take<double>("d");
+   auto nBad = df.Filter([](int i, double d, const std::vector<float> &v) {
+                    return d != 0.5 * i || v.size() != std::size_t(i % 3);
+                 }, {"i", "d", "v"})
+                  .Count();
+   EXPECT_EQ(*sumI, total * (total - 1) / 2);
+   EXPECT_EQ(*nBad, 0u);
+   auto dsSorted = *ds;
+   std::sort(dsSorted.begin(), dsSorted.end());
+   ASSERT_EQ(dsSorted.size(), std::size_t(total));
+   for (auto i : ROOT::TSeqI(total))
+      EXPECT_EQ(dsSorted[i], 0.5 * i);
+
+   if (!GetParam()) {
+      // A range starting in the middle of a basket of the first tree and ending in the second tree
+      auto rangeSum = df.Range(17, 1200).Sum<int>("i");
+      EXPECT_EQ(*rangeSum, 1199 * 1200 / 2 - 16 * 17 / 2);
+   }
+
+   for (const auto &fileName : fileNames)
+      gSystem->Unlink(fileName.c_str());
+}
+
+TEST_P(RDFSimpleTests, FusedEventLoop)
+{
+   const auto fileName = "dataframe_simple_fused.root";
+   FillTree(fileName, "t", 100);
+
+   // each entry of the returned vector is the result of one event loop
+   auto runAll = [&]() {
+      std::vector<double> results;
+      // typed single-branch graph on an empty source, with a named filter in the chain
+      ROOT::RDataFrame d(1000);
+      auto x = d.DefineSlotEntry("x", [](unsigned int, ULong64_t e) { return double(e); });
+      auto sel = x.Filter([](double v) { return int(v) % 3 != 0; }, {"x"}, "not3").Define("y", "x * 2");
+      results.emplace_back(*sel.Sum<double>("y"));
+      // the Report action is the only child of the named filter, so this is a single-branch graph too
+      auto report = sel.Report();
+      results.emplace_back((*report)["not3"].GetPass());
+      results.emplace_back((*report)["not3"].GetAll());
+      if (!GetParam()) {
+         // ranges stop the event loop early. Not on d: its named filter would make a second branch
+         ROOT::RDataFrame r(1000);
+         auto even = r.Range(10, 500, 3).Filter([](ULong64_t e) { return e % 2 == 0; }, {"rdfentry_"});
+         results.emplace_back(*even.Sum<ULong64_t>("rdfentry_"));
+      }
+      // data-source
+      auto tds = ROOT::RDF::MakeTrivialDataFrame(200);
+      results.emplace_back(*tds.Filter([](ULong64_t c) { return c % 5 == 0; }, {"col0"}).Sum<ULong64_t>("col0"));
+      // jitted filter and typed action on a TTree
+      ROOT::RDataFrame t("t", fileName);
+      auto tSum = t.Filter("b1 > 20").Sum<int>("b2");
+      results.emplace_back(*tSum);
+      // two branches: run through the usual event loop
+      auto tFiltered = t.Filter([](double b1) { return b1 < 50; }, {"b1"});
+      auto c1 = tFiltered.Count();
+      auto c2 = tFiltered.Filter("b2 % 2 == 0").Count();
+      results.emplace_back(*c1);
+      results.emplace_back(*c2);
+      return results;
+   };
+
+   const auto expected = runAll();
+   const auto oldFused = gEnv->GetValue("RDataFrame.FusedEventLoop", 0);
+   gEnv->SetValue("RDataFrame.FusedEventLoop", 1);
+   const auto fused = runAll();
+   gEnv->SetValue("RDataFrame.FusedEventLoop", oldFused);
+
+   EXPECT_EQ(fused, expected);
+   gSystem->Unlink(fileName);
+}
+
 // run single-thread tests
 INSTANTIATE_TEST_CASE_P(Seq, RDFSimpleTests, ::testing::Values(false));
 
@@ -150,6 +150,44 @@ TEST(RArrowDS, ColumnReadersString)
    }
 }
 
+TEST(RArrowDS, ChunkAlignedEntryRanges)
+{
+   // Two columns with different chunking: the entry ranges must not cross the chunk boundaries of either of them
+   std::vector<int64_t> ages = {64, 50, 40, 30, 2, 0};
+   std::vector<double> heights = {180.0, 200.5, 1.7, 1.9, 1.0, 0.8};
+   std::shared_ptr<Array> ageChunks[2], heightChunks[3];
+   arrow::ArrayFromVector<Int64Type, int64_t>(std::vector<int64_t>(ages.begin(), ages.begin() + 3), &ageChunks[0]);
+   arrow::ArrayFromVector<Int64Type, int64_t>(std::vector<int64_t>(ages.begin() + 3, ages.end()), &ageChunks[1]);
+   arrow::ArrayFromVector<DoubleType, double>(std::vector<double>(heights.begin(), heights.begin() + 2), &heightChunks[0]);
+   arrow::ArrayFromVector<DoubleType, double>(std::vector<double>(heights.begin() + 2, heights.begin() + 4), &heightChunks[1]);
+   arrow::ArrayFromVector<DoubleType, double>(std::vector<double>(heights.begin() + 4, heights.end()), &heightChunks[2]);
+
+   auto schema_ = schema({field("Age", arrow::int64()), field("Height", arrow::float64())});
+   std::vector<std::shared_ptr<Column>> columns_ = {
+      std::make_shared<Column>(schema_->field(0), ArrayVector{ageChunks[0], ageChunks[1]}),
+      std::make_shared<Column>(schema_->field(1), ArrayVector{heightChunks[0], heightChunks[1], heightChunks[2]})};
+
+   RArrowDS tds(Table::Make(schema_, columns_), {});
+   const auto nSlots = 1U;
+   tds.SetNSlots(nSlots);
+   auto valsAge = tds.GetColumnReaders<Long64_t>("Age");
+   auto valsHeight = tds.GetColumnReaders<double>("Height");
+   tds.Initialise();
+   auto ranges = tds.GetEntryRanges();
+
+   const std::vector<std::pair<ULong64_t, ULong64_t>> expectedRanges = {{0, 2}, {2, 3}, {3, 4}, {4, 6}};
+   EXPECT_EQ(expectedRanges, ranges);
+
+   for (auto &&range : ranges) {
+      tds.InitSlot(0U, range.first);
+      for (auto i : ROOT::TSeqU(range.first, range.second)) {
+         tds.SetEntry(0U, i);
+         EXPECT_EQ(ages[i], **valsAge[0]);
+         EXPECT_DOUBLE_EQ(heights[i], **valsHeight[0]);
+      }
+   }
+}
+
 #ifndef NDEBUG
 
 TEST(RArrowDS, SetNSlotsTwice)
@@ -2,9 +2,11 @@
 #include <ROOT/RCsvDS.hxx>
 #include <ROOT/TSeq.hxx>
 #include <TROOT.h>
+#include <TSystem.h>
 
 #include <gtest/gtest.h>
 
+#include <fstream>
 #include <iostream>
 
 using namespace ROOT::RDF;
@@ -289,6 +291,43 @@ TEST(RCsvDS, ProgressiveReadingRDFMT)
    EXPECT_EQ(6U, *c2);
 }
 
+TEST(RCsvDS, ParallelParsingMT)
+{
+   // Large enough for the chunks to be split in several pieces parsed in parallel
+   const auto fileName = "RCsvDS_test_parallelparsing.csv";
+   const auto nLines = 100000LL;
+   {
+      std::ofstream f(fileName);
+      f << "x,y,name,flag\n";
+      for (auto i = 0LL; i < nLines; ++i) {
+         f << i << ',' << i + .5 << ",\"n,\"\"" << i % 10 << "\"\"\"," << (i % 2 ? "true" : "false") << '\n';
+         if (i % 1000 == 0)
+            f << '\n'; // empty lines are skipped
+      }
+   }
+
+   for (auto chunkSize : {-1LL, 30000LL}) {
+      auto df = ROOT::RDF::MakeCsvDataFrame(fileName, true, ',', chunkSize);
+      auto c = df.Count();
+      auto sumX = df.Sum<Long64_t>("x");
+      auto sumY = df.Sum<double>("y");
+      auto nTrue = df.Filter([](bool b) { return b; }, {"flag"}).Count();
+      auto nBadNames = df.Filter([](Long64_t x, const std::string &n) { return n != "n,\"" + std::to_string(x % 10) + "\""; },
+                                 {"x", "name"})
+                          .Count();
+      auto nBadFlags = df.Filter([](Long64_t x, bool b) { return b != bool(x % 2); }, {"x", "flag"}).Count();
+
+      EXPECT_EQ(ULong64_t(nLines), *c);
+      EXPECT_EQ(nLines * (nLines - 1) / 2, *sumX);
+      EXPECT_DOUBLE_EQ(nLines * nLines / 2., *sumY);
+      EXPECT_EQ(ULong64_t(nLines / 2), *nTrue);
+      EXPECT_EQ(0U, *nBadNames);
+      EXPECT_EQ(0U, *nBadFlags);
+   }
+
+   gSystem->Unlink(fileName);
+}
+
 #endif // R__USE_IMT
 
 #endif // R__B64
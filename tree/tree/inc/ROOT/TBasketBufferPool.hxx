@@ -0,0 +1,90 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TBasketBufferPool
+#define ROOT_TBasketBufferPool
+
+#include "TBuffer.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+
+/// A process-wide pool of the I/O buffers of the baskets.
+///
+/// TBasket takes its buffers (the uncompressed one, and the compressed one
+/// when it owns it) from the pool and gives them back when it drops them, so
+/// that reading or writing a cluster of a wide tree reuses the buffers of the
+/// previous one instead of allocating and freeing one pair per branch.
+///
+/// Buffers are sorted in size classes, four per power of two, each with its
+/// own lock: threads reading different branches rarely contend.  The pool
+/// holds at most GetMaxBytes() bytes; buffers given back beyond that are
+/// freed.  The initial limit is taken from the `TTree.BasketBufferPoolSize`
+/// resource (in MB, 64 by default); 0 disables the pool.
+class TBasketBufferPool {
+public:
+   struct Stats {
+      ULong64_t fAcquired = 0;   ///< Number of buffers handed out
+      ULong64_t fReused = 0;     ///< Number of buffers handed out from the pool
+      ULong64_t fReleased = 0;   ///< Number of buffers given back
+      ULong64_t fDiscarded = 0;  ///< Number of buffers given back and freed
+      Long64_t fPooledBytes = 0; ///< Size of the buffers currently in the pool
+      Long64_t fPeakBytes = 0;   ///< Largest value of fPooledBytes
+   };
+
+   static TBasketBufferPool &GetInstance();
+
+   TBuffer *Acquire(Int_t size, TBuffer::EMode mode);
+   void Release(TBuffer *buffer);
+
+   Long64_t GetMaxBytes() const { return fMaxBytes; }
+   void SetMaxBytes(Long64_t maxBytes);
+   Stats GetStats() const;
+   void ResetStats();
+   void Clear();
+   void Print() const;
+
+   static Int_t GetSizeClass(Int_t size);
+   static Int_t GetClassSize(Int_t sizeClass);
+
+   static constexpr Int_t kMinLog2 = 10;  ///< The smallest size class holds 1 kB
+   static constexpr Int_t kMaxLog2 = 28;  ///< The largest size class holds 256 MB
+   static constexpr Int_t kNumClasses = (kMaxLog2 - kMinLog2) * 4 + 1;
+
+private:
+   /// The buffers of a size class, one list for each buffer mode: buffers
+   /// created for writing have some extra space at the end.
+   struct SizeClass {
+      std::mutex fMutex;
+      std::vector<TBuffer *> fBuffers[2];
+   };
+
+   TBasketBufferPool();
+   TBasketBufferPool(const TBasketBufferPool &) = delete;
+   TBasketBufferPool &operator=(const TBasketBufferPool &) = delete;
+
+   SizeClass fClasses[kNumClasses];
+   std::atomic<Long64_t> fMaxBytes{0};
+   std::atomic<Long64_t> fPooledBytes{0};
+   std::atomic<Long64_t> fPeakBytes{0};
+   std::atomic<ULong64_t> fAcquired{0};
+   std::atomic<ULong64_t> fReused{0};
+   std::atomic<ULong64_t> fReleased{0};
+   std::atomic<ULong64_t> fDiscarded{0};
+};
+
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
@@ -44,7 +44,8 @@ namespace Experimental {
 // usage of this mechanism somehow involves baskets currently.
 enum class EIOFeatures {
    kGenerateOffsetMap = BIT(0),
-   kSupported = kGenerateOffsetMap  // Union of all features in this enum.
+   kLittleEndian = BIT(1),  // Store fixed-size numerical branches in little-endian byte order.
+   kSupported = kGenerateOffsetMap | kLittleEndian  // Union of all features in this enum.
 };
 
 
@@ -79,7 +80,7 @@ public:
    void Print() const;
 
    // The number of known, defined IO features (supported / unsupported / experimental).
-   static constexpr int kIOFeatureCount = 1;
+   static constexpr int kIOFeatureCount = 2;
 
 private:
    // These methods allow access to the raw bitset underlying
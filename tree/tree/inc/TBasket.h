@@ -58,6 +58,18 @@ private:
    void   DisownBuffer();
    void   AdoptBuffer(TBuffer *user_buffer);
 
+   // Compress and write the buffer, recording cycle as the key cycle.
+   Int_t  WriteBufferImpl(Int_t cycle);
+
+   // Size of the values of the branch if the basket can be stored in little-endian order, 0 otherwise.
+   Int_t  GetLittleEndianTypeSize() const;
+
+   // Pad the key header of a little-endian basket so that its values are aligned.
+   void   AlignPayload();
+
+   // Swap the byte order of the values of a little-endian basket.
+   void   SwapByteOrder();
+
 protected:
    Int_t       fBufferSize{0};                    ///< fBuffer length in bytes
    Int_t       fNevBufSize{0};                    ///< Length in Int_t of fEntryOffset OR fixed length of each entry if fEntryOffset is null!
@@ -67,6 +79,7 @@ protected:
    UChar_t     fIOBits{0};                        ///<!IO feature flags.  Serialized in custom portion of streamer to avoid forward compat issues unless needed.
    Bool_t      fOwnsCompressedBuffer{kFALSE};     ///<! Whether or not we own the compressed buffer.
    Bool_t      fReadEntryOffset{kFALSE};          ///<!Set to true if offset array was read from a file.
+   Bool_t      fLittleEndian{kFALSE};             ///<!Set to true if the values in fBufferRef are in little-endian order.
    Int_t      *fDisplacement{nullptr};            ///<![fNevBuf] Displacement of entries in fBuffer(TKey)
    Int_t      *fEntryOffset{nullptr};             ///<[fNevBuf] Offset of entries in fBuffer(TKey); generated at runtime.  Special value
                                                   /// of `-1` indicates that the offset generation MUST be performed on first read.
@@ -93,11 +106,12 @@ public:
    // in the fIOBits -- then the zombie flag will be set for this object.
    //
    enum class EIOBits : Char_t {
-      // The following to bits are reserved for now; when supported, set
-      // kSupported = kGenerateOffsetMap | kBasketClassMap
+      // kBasketClassMap is reserved for now; when supported, set
+      // kSupported = kGenerateOffsetMap | kLittleEndian | kBasketClassMap
       kGenerateOffsetMap = BIT(0),
-      // kBasketClassMap = BIT(1),
-      kSupported = kGenerateOffsetMap
+      kLittleEndian = BIT(1),
+      // kBasketClassMap = BIT(2),
+      kSupported = kGenerateOffsetMap | kLittleEndian
    };
    // This enum covers IOBits that are known to this ROOT release but
    // not supported; provides a mechanism for us to have experimental
@@ -106,7 +120,7 @@ public:
    // (kUnsupported | kSupported) should result in the '|' of all IOBits.
    enum class EUnsupportedIOBits : Char_t { kUnsupported = 0 };
    // The number of known, defined IOBits.
-   static constexpr int kIOBitCount = 1;
+   static constexpr int kIOBitCount = 2;
 
    TBasket();
    TBasket(TDirectory *motherDir);
@@ -127,6 +141,7 @@ public:
            Int_t   GetNevBuf() const {return fNevBuf;}
            Int_t   GetNevBufSize() const {return fNevBufSize;}
            Int_t   GetLast() const {return fLast;}
+           Bool_t  IsLittleEndian() const {return fLittleEndian;}
    virtual void    MoveEntries(Int_t dentries);
    virtual void    PrepareBasket(Long64_t /* entry */) {};
            Int_t   ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file);
@@ -24,6 +24,8 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "Compression.h"
 
@@ -66,6 +68,7 @@ class TBranch : public TNamed , public TAttFill {
    using TIOFeatures = ROOT::TIOFeatures;
 
 protected:
+   friend class TBasket;
    friend class TTreeCache;
    friend class TTreeCloner;
    friend class TTree;
@@ -80,7 +83,8 @@ protected:
       // kMapObject    = kBranchObject | kBranchAny;
       kAutoDelete   = BIT(15),
 
-      kDoNotUseBufferMap = BIT(22) // If set, at least one of the entry in the branch will use the buffer's map of classname and objects.
+      kDoNotUseBufferMap = BIT(22), // If set, at least one of the entry in the branch will use the buffer's map of classname and objects.
+      kAutoDeactivated   = BIT(23)  // The branch was deactivated by TTree::Process because it was not read (see TTree::SetAutoBranchActivation).
    };
 
    using BulkObj = ROOT::Experimental::Internal::TBulkBranchRead;
@@ -91,6 +95,7 @@ protected:
    Int_t       fWriteBasket;      ///<  Last basket number written
    Long64_t    fEntryNumber;      ///<  Current entry number (last one filled in this branch)
    TBasket    *fExtraBasket;      ///<! Allocated basket not currently holding any data.
+   TBasket    *fSpareBasket;      ///<! Basket written in the background, ready to be filled again (see TTree::SetAsyncFlush)
    TIOFeatures fIOFeatures;       ///<  IO features for newly-created baskets.
    Int_t       fOffset;           ///<  Offset of this branch
    Int_t       fMaxBaskets;       ///<  Maximum number of Baskets so far
@@ -128,6 +133,17 @@ protected:
    using CacheInfo_t = ROOT::Internal::TBranchCacheInfo;
    CacheInfo_t fCacheInfo;        ///<! Hold info about which basket are in the cache and if they have been retrieved from the cache.
 
+   /// Samples collected from the first baskets to train the compression dictionary.
+   struct DictionaryTraining {
+      Int_t fNBaskets = 0;              ///< Number of baskets to collect before training
+      Int_t fMaxSize = 0;               ///< Maximum size of the dictionary
+      std::vector<char> fSamples;       ///< Contents of the baskets collected so far
+      std::vector<Int_t> fSampleSizes;  ///< Size of each of the collected baskets
+      std::mutex fMutex;                ///< Baskets of a branch may be compressed concurrently
+   };
+   std::vector<char> fCompressionDictionary;           ///<  Dictionary used to compress the baskets, empty if none
+   std::unique_ptr<DictionaryTraining> fDictTraining;  ///<! Training of the compression dictionary, if requested
+
    typedef void (TBranch::*ReadLeaves_t)(TBuffer &b);
    ReadLeaves_t fReadLeaves;      ///<! Pointer to the ReadLeaves implementation to use.
    typedef void (TBranch::*FillLeaves_t)(TBuffer &b);
@@ -139,6 +155,7 @@ protected:
    void     FillLeavesImpl(TBuffer &b);
 
    void     SetSkipZip(Bool_t skip = kTRUE) { fSkipZip = skip; }
+   Bool_t   Reactivate();
    void     Init(const char *name, const char *leaflist, Int_t compress);
 
    TBasket *GetFreshBasket(TBuffer *user_buffer);
@@ -151,10 +168,15 @@ private:
    Int_t    GetBasketAndFirst(TBasket*& basket, Long64_t& first, TBuffer* user_buffer);
    TBasket *GetBasketImpl(Int_t basket, TBuffer* user_buffer);
    Int_t    GetBulkEntries(Long64_t, TBuffer&);
+   Int_t    GetBulkEntries(Long64_t, TBuffer&, std::vector<Int_t>&);
    Int_t    GetEntriesSerialized(Long64_t N, TBuffer& user_buf) {return GetEntriesSerialized(N, user_buf, nullptr);}
    Int_t    GetEntriesSerialized(Long64_t, TBuffer&, TBuffer*);
    Int_t    FillEntryBuffer(TBasket* basket,TBuffer* buf, Int_t& lnew);
    Int_t    WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBranchIMTHelper *);
+   Int_t    WriteBasketAsync(TBasket* basket, Int_t where);
+   void     FinishWriteBasket(TBasket* basket, Int_t where, Int_t nout);
+   const std::vector<char> *PrepareCompressionDictionary(const char *buffer, Int_t size, Int_t algorithm);
+   void     UpdateEntryOffsetLen(Int_t nevbuf);
    TBranch(const TBranch&) = delete;             // not implemented
    TBranch& operator=(const TBranch&) = delete;  // not implemented
 
@@ -190,6 +212,7 @@ public:
            Int_t     GetCompressionAlgorithm() const;
            Int_t     GetCompressionLevel() const;
            Int_t     GetCompressionSettings() const;
+   const std::vector<char> &GetCompressionDictionary() const { return fCompressionDictionary; }
    TDirectory       *GetDirectory() const {return fDirectory;}
    virtual Int_t     GetEntry(Long64_t entry=0, Int_t getall = 0);
    virtual Int_t     GetEntryExport(Long64_t entry, Int_t getall, TClonesArray *list, Int_t n);
@@ -223,6 +246,7 @@ public:
    TBranch          *GetMother() const;
    TBranch          *GetSubBranch(const TBranch *br) const;
    TBuffer          *GetTransientBuffer(Int_t size);
+   Bool_t            IsAutoDeactivated() const;
    Bool_t            IsAutoDelete() const;
    Bool_t            IsFolder() const;
    virtual void      KeepCircular(Long64_t maxEntries);
@@ -237,12 +261,15 @@ public:
    virtual void      ResetReadEntry() {fReadEntry = -1;}
    virtual void      SetAddress(void *add);
    virtual void      SetObject(void *objadd);
+   void              SetAutoDeactivated(Bool_t deactivated = kTRUE);
    virtual void      SetAutoDelete(Bool_t autodel=kTRUE);
    virtual void      SetBasketSize(Int_t buffsize);
    virtual void      SetBufferAddress(TBuffer *entryBuffer);
    void              SetCompressionAlgorithm(Int_t algorithm = ROOT::RCompressionSetting::EAlgorithm::kUseGlobal);
    void              SetCompressionLevel(Int_t level = ROOT::RCompressionSetting::ELevel::kUseMin);
    void              SetCompressionSettings(Int_t settings = ROOT::RCompressionSetting::EDefaults::kUseGeneralPurpose);
+   void              SetCompressionDictionary(const char *dict, Int_t size);
+   void              SetCompressionDictionaryTraining(Int_t nbaskets, Int_t maxsize = 16384);
    virtual void      SetEntries(Long64_t entries);
    virtual void      SetEntryOffsetLen(Int_t len, Bool_t updateSubBranches = kFALSE);
    virtual void      SetFirstEntry( Long64_t entry );
@@ -255,12 +282,13 @@ public:
    virtual void      SetTree(TTree *tree) { fTree = tree;}
    virtual void      SetupAddresses();
            Bool_t    SupportsBulkRead() const;
+           Bool_t    TrainCompressionDictionary(const char *samples, const Int_t *sizes, Int_t nsamples, Int_t maxsize = 16384);
    virtual void      UpdateAddress() {;}
    virtual void      UpdateFile();
 
    static  void      ResetCount();
 
-   ClassDef(TBranch, 13); // Branch descriptor
+   ClassDef(TBranch, 14); // Branch descriptor
 };
 
 //______________________________________________________________________________
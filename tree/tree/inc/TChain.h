@@ -25,11 +25,13 @@
 #include <iosfwd>
 
 class TFile;
+class TFileOpenHandle;
 class TBrowser;
 class TCut;
 class TEntryList;
 class TEventList;
 class TCollection;
+class TFileCollection;
 
 class TChain : public TTree {
 
@@ -44,6 +46,11 @@ protected:
    TObjArray   *fFiles;            ///< -> List of file names containing the trees (TChainElement, owned)
    TList       *fStatus;           ///< -> List of active/inactive branches (TChainElement, owned)
    TChain      *fProofChain;       ///<! chain proxy when going to be processed by PROOF
+   Bool_t       fPrefetchNextFile; ///<! If true, open the next file ahead of time, see SetPrefetchNextFile
+   Int_t        fNextTreeNumber;   ///<! Tree number of the file opened ahead of time, -1 if none
+   TFileOpenHandle *fNextFileHandle; ///<! Pending asynchronous open of the next file
+   TFile       *fNextFile;         ///<! Next file, opened ahead of time (We own the file).
+   Long64_t     fLastClusterStart; ///<! First entry of the last cluster of the current tree, -1 if not computed yet
 
 private:
    TChain(const TChain&);            // not implemented
@@ -53,6 +60,9 @@ private:
 protected:
    void InvalidateCurrentTree();
    void ReleaseChainProof();
+   void PrefetchNextFile(Long64_t treeReadEntry);
+   void ReleaseNextFile();
+   TFile *TakeNextFile(Int_t treenum);
 
 public:
    // TChain constants
@@ -121,6 +131,7 @@ public:
    virtual Int_t     LoadBaskets(Long64_t maxmemory);
    virtual Long64_t  LoadTree(Long64_t entry);
            void      Lookup(Bool_t force = kFALSE);
+   virtual TFileCollection *MakeFileCollection(const char *name = "");
    virtual void      Loop(Option_t *option="", Long64_t nentries=kMaxEntries, Long64_t firstentry=0); // *MENU*
    virtual void      ls(Option_t *option="") const;
    virtual Long64_t  Merge(const char *name, Option_t *option = "");
@@ -138,6 +149,7 @@ public:
    virtual void      ResetBranchAddresses();
    virtual void      SavePrimitive (std::ostream &out, Option_t *option="");
    virtual Long64_t  Scan(const char *varexp="", const char *selection="", Option_t *option="", Long64_t nentries=kMaxEntries, Long64_t firstentry=0); // *MENU*
+           Int_t     ScanEntries();
    virtual void      SetAutoDelete(Bool_t autodel=kTRUE);
    virtual Int_t     SetBranchAddress(const char *bname,void *add, TBranch **ptr = 0);
    virtual Int_t     SetBranchAddress(const char *bname,void *add, TBranch **ptr, TClass *realClass, EDataType datatype, Bool_t isptr);
@@ -155,6 +167,7 @@ public:
 
    virtual void      SetBranchStatus(const char *bname, Bool_t status=1, UInt_t *found=0);
    virtual Int_t     SetCacheSize(Long64_t cacheSize = -1);
+   virtual void      SetPrefetchNextFile(Bool_t prefetch = kTRUE);
    virtual void      SetDirectory(TDirectory *dir);
    virtual void      SetEntryList(TEntryList *elist, Option_t *opt="");
    virtual void      SetEntryListFile(const char *filename="", Option_t *opt="");
@@ -162,6 +175,7 @@ public:
    virtual void      SetMakeClass(Int_t make) { TTree::SetMakeClass(make); if (fTree) fTree->SetMakeClass(make);}
    virtual void      SetName(const char *name);
    virtual void      SetPacketSize(Int_t size = 100);
+   virtual void      SetPerfStats(TVirtualPerfStats *perf) { TTree::SetPerfStats(perf); if (fTree) fTree->SetPerfStats(perf); }
    virtual void      SetProof(Bool_t on = kTRUE, Bool_t refresh = kFALSE, Bool_t gettreeheader = kFALSE);
    virtual void      SetWeight(Double_t w=1, Option_t *option="");
    virtual void      UseCache(Int_t maxCacheSize = 10, Int_t pageSize = 0);
@@ -65,11 +65,13 @@ class TEntryList: public TNamed
    virtual Int_t       Contains(Long64_t entry, TTree *tree = 0);
    virtual void        DirectoryAutoAdd(TDirectory *);
    virtual Bool_t      Enter(Long64_t entry, TTree *tree = 0);
+   virtual Long64_t    EnterRange(Long64_t start, Long64_t end);
    virtual TEntryList *GetCurrentList() const { return fCurrent; };
    virtual TEntryList *GetEntryList(const char *treename, const char *filename, Option_t *opt="");
    virtual Long64_t    GetEntry(Int_t index);
    virtual Long64_t    GetEntryAndTree(Int_t index, Int_t &treenum);
    virtual Long64_t    GetEntriesToProcess() const {return fEntriesToProcess;}
+   virtual void        Intersect(const TEntryList *elist);
    virtual TList      *GetLists() const { return fLists; }
    virtual TDirectory *GetDirectory() const { return fDirectory; }
    virtual Long64_t    GetN() const { return fN; }
@@ -14,12 +14,15 @@
 //
 // Used internally in TEntryList to store the entry numbers.
 //
-// There are 2 ways to represent entry numbers in a TEntryListBlock:
+// There are 3 ways to represent entry numbers in a TEntryListBlock:
 // 1) as bits, where passing entry numbers are assigned 1, not passing - 0
 // 2) as a simple array of entry numbers
-// In both cases, a UShort_t* is used. The second option is better in case
-// less than 1/16 of entries passes the selection, and the representation can be
-// changed by calling OptimizeStorage() function.
+// 3) as runs of consecutive entry numbers, stored as (first, last) pairs
+// In all cases, a UShort_t* is used. The second option is better in case
+// less than 1/16 of entries passes the selection, the third one when the passing
+// entries are clustered, and the representation can be changed by calling
+// OptimizeStorage() function. The third one exists in memory only: such a block
+// is written as bits or as an array.
 // When the block is being filled, it's always stored as bits, and the OptimizeStorage()
 // function is called by TEntryList when it starts filling the next block. If
 // Enter() or Remove() is called after OptimizeStorage(), representation is
@@ -29,6 +32,8 @@
 // - Merge() - adds all entries from one block to the other. If the first block
 //             uses array representation, it's changed to bits representation only
 //             if the total number of passing entries is still less than kBlockSize
+// - Intersect(), Subtract() - keep the entries also in, resp. not in the other block.
+//             Like Merge(), they work on whole words of the bits representation.
 // - GetEntry(n) - returns n-th non-zero entry.
 // - Next()      - return next non-zero entry. In case of representation 1), Next()
 //                 is faster than GetEntry()
@@ -47,7 +52,7 @@ class TEntryListBlock:public TObject
                                 ///< not in the entry list
    Int_t    fN;                 ///< size of fIndices for I/O  =fNPassed for list, fBlockSize for bits
    UShort_t *fIndices;          ///<[fN]
-   Int_t    fType;              ///<0 - bits, 1 - list
+   Int_t    fType;              ///<0 - bits, 1 - list, 2 - runs (in memory only)
    Bool_t   fPassing;           ///<1 - stores entries that belong to the list
                                 ///<0 - stores entries that don't belong to the list
    UShort_t fCurrent;           ///<! to fasten  Contains() in list mode
@@ -55,6 +60,10 @@ class TEntryListBlock:public TObject
    Int_t    fLastIndexReturned; ///<! to optimize GetEntry() in a loop
 
    void Transform(Bool_t dir, UShort_t *indexnew);
+   void ToBits(UShort_t *bits) const;
+   void SetBits(UShort_t *bits);
+   Int_t FindRun(Int_t entry) const;
+   void OptimizeBits();
 
  public:
 
@@ -68,7 +77,10 @@ class TEntryListBlock:public TObject
    Bool_t  Remove(Int_t entry);
    Int_t   Contains(Int_t entry);
    void    OptimizeStorage();
+   Int_t   EnterRange(Int_t first, Int_t last);
    Int_t   Merge(TEntryListBlock *block);
+   Int_t   Intersect(const TEntryListBlock *block);
+   Int_t   Subtract(const TEntryListBlock *block);
    Int_t   Next();
    Int_t   GetEntry(Int_t entry);
    void    ResetIndices() {fLastIndexQueried = -1, fLastIndexReturned = -1;}
@@ -68,6 +68,12 @@ class TTreeCloner;
 class TFileMergeInfo;
 class TVirtualPerfStats;
 
+namespace ROOT {
+namespace Internal {
+class TBasketWritePipeline;
+}
+}
+
 class TTree : public TNamed, public TAttLine, public TAttFill, public TAttMarker {
 
    using TIOFeatures = ROOT::TIOFeatures;
@@ -147,8 +153,11 @@ private:
    mutable Bool_t fIMTFlush{false};               ///<! True if we are doing a multithreaded flush.
    mutable std::atomic<Long64_t> fIMTTotBytes;    ///<! Total bytes for the IMT flush baskets
    mutable std::atomic<Long64_t> fIMTZipBytes;    ///<! Zip bytes for the IMT flush baskets.
+   ROOT::Internal::TBasketWritePipeline *fWritePipeline{nullptr}; ///<! Background compression and writing of the baskets filled by Fill (see SetAsyncFlush)
+   Long64_t fAutoBranchActivation{-1};            ///<! Number of entries after which Process deactivates the branches not read, 0 if never (see SetAutoBranchActivation)
 
    void             InitializeBranchLists(bool checkLeafCount);
+   Int_t            FinishAsyncBaskets(Bool_t wait) const;
    void             SortBranchesByTime();
    Int_t            FlushBasketsImpl() const;
    void             MarkEventCluster();
@@ -192,6 +201,8 @@ protected:
    friend class TChainIndex;
    // So that the TTreeCloner can access the protected interfaces
    friend class TTreeCloner;
+   // So that the branches can hand their baskets to the write pipeline
+   friend class TBranch;
 
    // use to update fFriendLockStatus
    enum ELockStatusBits {
@@ -383,6 +394,8 @@ public:
 #ifdef R__TRACK_BASKET_ALLOC_TIME
    ULong64_t               GetAllocationTime() const { return fAllocationTime; }
 #endif
+   virtual Int_t           GetAsyncFlush() const;
+   virtual Long64_t        GetAutoBranchActivation() const;
    virtual Long64_t        GetAutoFlush() const {return fAutoFlush;}
    virtual Long64_t        GetAutoSave()  const {return fAutoSave;}
    virtual TBranch        *GetBranch(const char* name);
@@ -516,6 +529,8 @@ public:
    virtual Long64_t        Scan(const char* varexp = "", const char* selection = "", Option_t* option = "", Long64_t nentries = kMaxEntries, Long64_t firstentry = 0); // *MENU*
    virtual Bool_t          SetAlias(const char* aliasName, const char* aliasFormula);
    virtual void            SetAutoSave(Long64_t autos = -300000000);
+   virtual void            SetAsyncFlush(Int_t depth = 16);
+   virtual void            SetAutoBranchActivation(Long64_t nentries = 100);
    virtual void            SetAutoFlush(Long64_t autof = -30000000);
    virtual void            SetBasketSize(const char* bname, Int_t buffsize = 16000);
    virtual Int_t           SetBranchAddress(const char *bname,void *add, TBranch **ptr = 0);
@@ -545,6 +560,7 @@ public:
    virtual void            SetChainOffset(Long64_t offset = 0) { fChainOffset=offset; }
    virtual void            SetCircular(Long64_t maxEntries);
    virtual void            SetClusterPrefetch(Bool_t enabled) { fCacheDoClusterPrefetch = enabled; }
+   virtual void            SetCompressionDictionaryTraining(const char *bname, Int_t nbaskets, Int_t maxsize = 16384);
    virtual void            SetDebug(Int_t level = 1, Long64_t min = 0, Long64_t max = 9999999); // *MENU*
    virtual void            SetDefaultEntryOffsetLen(Int_t newdefault, Bool_t updateExisting = kFALSE);
    virtual void            SetDirectory(TDirectory* dir);
@@ -95,7 +95,15 @@ protected:
    // Unzipping related members
    Int_t       fNseekMax;         ///<!  fNseek can change so we need to know its max size
    Int_t       fUnzipGroupSize;   ///<!  Min accumulated size of a group of baskets ready to be unzipped by a IMT task
-   Long64_t    fUnzipBufferSize;  ///<!  Max Size for the ready unzipped blocks (default is 2*fBufferSize)
+   Long64_t    fUnzipBufferSize;  ///<!  Max Size for the ready unzipped blocks (default is fgRelBuffSize*fBufferSize)
+
+   std::atomic<Long64_t> fUnzipBytes;  ///<! Bytes held (or reserved) by unzipped baskets not consumed yet
+   std::atomic<Long64_t> fUnzipBytesPeak; ///<! Largest value of fUnzipBytes reached by the tasks
+   std::atomic<Int_t>    fUnzipNext;   ///<! Next position in fUnzipOrder to be considered by the unzipping tasks
+   std::atomic<Bool_t>   fUnzipParked; ///<! True if a task stopped because fUnzipBufferSize was reached
+   std::vector<Long64_t> fSeekEntry;   ///<! [fNseek] First entry of each basket registered by FillBuffer
+   std::vector<TBranch*> fSeekBranch;  ///<! [fNseek] Branch of each basket registered by FillBuffer
+   std::vector<Int_t>    fUnzipOrder;  ///<! Indices of the registered baskets, in the order they are unzipped
 
    static Double_t fgRelBuffSize; ///< This is the percentage of the TTreeCacheUnzip that will be used
 
@@ -103,7 +111,9 @@ protected:
    Int_t       fNFound;           ///<! number of blocks that were found in the cache
    Int_t       fNMissed;          ///<! number of blocks that were not found in the cache and were unzipped
    Int_t       fNStalls;          ///<! number of hits which caused a stall
-   Int_t       fNUnzip;           ///<! number of blocks that were unzipped
+   std::atomic<Int_t> fNUnzip;    ///<! number of blocks that were unzipped ahead by the tasks
+   std::atomic<Int_t> fNWasted;   ///<! number of blocks that were unzipped ahead but never used
+   std::atomic<Int_t> fNNoDictionary; ///<! number of blocks left to TBasket, their compression dictionary being unknown
 
 private:
    TTreeCacheUnzip(const TTreeCacheUnzip &);            //this class cannot be copied
@@ -114,6 +124,12 @@ private:
 
    // Private methods
    void  Init();
+   void  ReleaseUnzipped(Int_t index);
+   TBranch *GetSeekBranch(Int_t index) const;
+   Int_t UnzipCache(Int_t index, std::vector<char> &scratch);
+#ifdef R__USE_IMT
+   void  WaitUnzipTasks();
+#endif
 
 public:
    TTreeCacheUnzip();
@@ -145,13 +161,18 @@ public:
    void           SetUnzipBufferSize(Long64_t bufferSize);
    void           SetUnzipGroupSize(Int_t groupSize) { fUnzipGroupSize = groupSize; }
    static void    SetUnzipRelBufferSize(Float_t relbufferSize);
-   Int_t          UnzipBuffer(char **dest, char *src);
+   Int_t          UnzipBuffer(char **dest, char *src, TBranch *branch = nullptr);
    Int_t          UnzipCache(Int_t index);
 
    // Methods to get stats
    Int_t  GetNUnzip() { return fNUnzip; }
    Int_t  GetNMissed(){ return fNMissed; }
    Int_t  GetNFound() { return fNFound; }
+   Int_t  GetNStalls() { return fNStalls; }
+   Int_t  GetNWasted() { return fNWasted; }
+   Int_t  GetNNoDictionary() { return fNNoDictionary; }
+   Long64_t GetUnzipBufferSize() const { return fUnzipBufferSize; }
+   Long64_t GetUnzipBytesPeak() const { return fUnzipBytesPeak; }
 
    void Print(Option_t* option = "") const;
 
@@ -17,6 +17,11 @@
 #include "TBranch.h"
 #include "TFile.h"
 #include "TLeaf.h"
+#include "TLeafD.h"
+#include "TLeafF.h"
+#include "TLeafI.h"
+#include "TLeafL.h"
+#include "TLeafS.h"
 #include "TBufferFile.h"
 #include "TMath.h"
 #include "TROOT.h"
@@ -24,6 +29,8 @@
 #include "TVirtualMutex.h"
 #include "TVirtualPerfStats.h"
 #include "TTimeStamp.h"
+#include "ROOT/ByteSwapCopy.hxx"
+#include "ROOT/TBasketBufferPool.hxx"
 #include "ROOT/TIOFeatures.hxx"
 #include "RZip.h"
 
@@ -67,7 +74,7 @@ TBasket::TBasket(const char *name, const char *title, TBranch *branch)
    SetTitle(title);
    fClassName   = "TBasket";
    fBuffer = nullptr;
-   fBufferRef   = new TBufferFile(TBuffer::kWrite, fBufferSize);
+   fBufferRef   = ROOT::Experimental::TBasketBufferPool::GetInstance().Acquire(fBufferSize, TBuffer::kWrite);
    fVersion    += 1000;
    if (branch->GetDirectory()) {
       TFile *file = branch->GetFile();
@@ -81,12 +88,16 @@ TBasket::TBasket(const char *name, const char *title, TBranch *branch)
 #endif
       fOwnsCompressedBuffer = kFALSE;
       if (!fCompressedBufferRef) {
-         fCompressedBufferRef = new TBufferFile(TBuffer::kRead, fBufferSize);
+         fCompressedBufferRef = ROOT::Experimental::TBasketBufferPool::GetInstance().Acquire(fBufferSize, TBuffer::kRead);
          fOwnsCompressedBuffer = kTRUE;
       }
    }
    fBranch = branch;
+   if (!GetLittleEndianTypeSize()) {
+      fIOBits &= ~static_cast<UChar_t>(EIOBits::kLittleEndian);
+   }
    Streamer(*fBufferRef);
+   AlignPayload();
    fKeylen      = fBufferRef->Length();
    fObjlen      = fBufferSize - fKeylen;
    fLast        = fKeylen;
@@ -106,13 +117,14 @@ TBasket::~TBasket()
 {
    if (fDisplacement) delete [] fDisplacement;
    ResetEntryOffset();
-   if (fBufferRef) delete fBufferRef;
+   auto &pool = ROOT::Experimental::TBasketBufferPool::GetInstance();
+   pool.Release(fBufferRef);
    fBufferRef = 0;
    fBuffer = 0;
    fDisplacement= 0;
-   // Note we only delete the compressed buffer if we own it
+   // Note we only give back the compressed buffer if we own it
    if (fCompressedBufferRef && fOwnsCompressedBuffer) {
-      delete fCompressedBufferRef;
+      pool.Release(fCompressedBufferRef);
       fCompressedBufferRef = 0;
    }
 }
@@ -172,8 +184,9 @@ Int_t TBasket::DropBuffers()
 
    if (fDisplacement) delete [] fDisplacement;
    ResetEntryOffset();
-   if (fBufferRef)    delete fBufferRef;
-   if (fCompressedBufferRef && fOwnsCompressedBuffer) delete fCompressedBufferRef;
+   auto &pool = ROOT::Experimental::TBasketBufferPool::GetInstance();
+   pool.Release(fBufferRef);
+   if (fCompressedBufferRef && fOwnsCompressedBuffer) pool.Release(fCompressedBufferRef);
    fBufferRef   = 0;
    fCompressedBufferRef = 0;
    fBuffer      = 0;
@@ -220,6 +233,63 @@ Bool_t TBasket::CanGenerateOffsetArray()
    return leaf->CanGenerateOffsetArray();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the size of the values of the branch if its baskets can be stored in
+/// little-endian order (see EIOBits::kLittleEndian), 0 otherwise: the branch
+/// must hold a single fixed-size leaf of 2, 4 or 8-byte numbers.
+
+Int_t TBasket::GetLittleEndianTypeSize() const
+{
+   if (!fBranch || fBranch->IsA() != TBranch::Class() || fBranch->GetNleaves() != 1 || fBranch->GetEntryOffsetLen()) {
+      return 0;
+   }
+   TLeaf *leaf = static_cast<TLeaf *>((*fBranch->GetListOfLeaves())[0]);
+   if (leaf->GetLeafCount()) {
+      return 0;
+   }
+   TClass *cl = leaf->IsA();
+   if (cl != TLeafS::Class() && cl != TLeafI::Class() && cl != TLeafL::Class() && cl != TLeafF::Class() &&
+       cl != TLeafD::Class()) {
+      return 0;
+   }
+   return leaf->GetLenType();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Pad the key header just written in fBufferRef with zeros, so that the values
+/// of a little-endian basket start on an 8-byte boundary of the buffer and can
+/// be used in place.
+
+void TBasket::AlignPayload()
+{
+   if (!(fIOBits & static_cast<UChar_t>(EIOBits::kLittleEndian))) {
+      return;
+   }
+   static const Char_t zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+   fBufferRef->WriteFastArray(zeros, (8 - fBufferRef->Length() % 8) % 8);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Swap the bytes of the values in fBufferRef, between the big-endian order
+/// written and read by the leaves and the little-endian order stored in the
+/// file for the baskets with EIOBits::kLittleEndian.
+
+void TBasket::SwapByteOrder()
+{
+   const Int_t size = GetLittleEndianTypeSize();
+   char *values = fBufferRef->Buffer() + fKeylen;
+   const Int_t n = size ? (fLast - fKeylen) / size : 0;
+   switch (size) {
+   case 2: ROOT::Internal::ByteSwapCopy16(values, values, n); break;
+   case 4: ROOT::Internal::ByteSwapCopy32(values, values, n); break;
+   case 8: ROOT::Internal::ByteSwapCopy64(values, values, n); break;
+   default:
+      Error("SwapByteOrder", "The basket of branch %s cannot be in little-endian order.", fBranch->GetName());
+      return;
+   }
+   fLittleEndian = !fLittleEndian;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Get pointer to buffer for internal entry.
 
@@ -252,7 +322,7 @@ Int_t TBasket::LoadBasketBuffers(Long64_t pos, Int_t len, TFile *file, TTree *tr
       }
       fBufferRef->SetReadMode();
    } else {
-      fBufferRef = new TBufferFile(TBuffer::kRead, len);
+      fBufferRef = ROOT::Experimental::TBasketBufferPool::GetInstance().Acquire(len, TBuffer::kRead);
    }
    fBufferRef->SetParent(file);
    char *buffer = fBufferRef->Buffer();
@@ -416,7 +486,7 @@ static inline TBuffer* R__InitializeReadBasketBuffer(TBuffer* bufferRef, Int_t l
       bufferRef->Reset();
       result = bufferRef;
    } else {
-      result = new TBufferFile(TBuffer::kRead, len);
+      result = ROOT::Experimental::TBasketBufferPool::GetInstance().Acquire(len, TBuffer::kRead);
    }
    result->SetParent(file);
    return result;
@@ -588,8 +658,9 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       }
 
       // Optional monitor for zip time profiling.
+      TVirtualPerfStats *perfStats = fBranch->GetTree()->GetPerfStats() ? fBranch->GetTree()->GetPerfStats() : gPerfStats;
       Double_t start = 0;
-      if (R__unlikely(gPerfStats)) {
+      if (R__unlikely(perfStats)) {
          start = TTimeStamp();
       }
 
@@ -598,6 +669,7 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       UChar_t *rawCompressedObjectBuffer = (UChar_t*)rawCompressedBuffer+fKeylen;
       Int_t nin, nbuf;
       Int_t nout = 0, noutot = 0, nintot = 0;
+      const std::vector<char> &dict = fBranch->GetCompressionDictionary();
 
       // Unzip all the compressed objects in the compressed object buffer.
       while (1) {
@@ -612,7 +684,8 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
             goto AfterBuffer;
          }
 
-         R__unzip(&nin, rawCompressedObjectBuffer, &nbuf, (unsigned char*) rawUncompressedObjectBuffer, &nout);
+         R__unzipDict(&nin, rawCompressedObjectBuffer, &nbuf, (unsigned char*) rawUncompressedObjectBuffer, &nout,
+                      dict.data(), dict.size());
          if (!nout) break;
          noutot += nout;
          nintot += nin;
@@ -628,12 +701,10 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
          return 1;
       }
       len = fObjlen+fKeylen;
-      TVirtualPerfStats* temp = gPerfStats;
-      if (fBranch->GetTree()->GetPerfStats() != 0) gPerfStats = fBranch->GetTree()->GetPerfStats();
-      if (R__unlikely(gPerfStats)) {
-         gPerfStats->UnzipEvent(fBranch->GetTree(),pos,start,nintot,fObjlen);
+      if (R__unlikely(perfStats)) {
+         perfStats->UnzipEvent(fBranch->GetTree(),pos,start,nintot,fObjlen);
+         perfStats->BranchUnzipEvent(fBranch,start,fNbytes,fObjlen+fKeylen);
       }
-      gPerfStats = temp;
    } else {
       // Nothing is compressed - copy over wholesale.
       memcpy(rawUncompressedBuffer, rawCompressedBuffer, len);
@@ -714,7 +785,7 @@ void TBasket::DisownBuffer()
 /// Adopt a buffer from an external entity
 void TBasket::AdoptBuffer(TBuffer *user_buffer)
 {
-   delete fBufferRef;
+   ROOT::Experimental::TBasketBufferPool::GetInstance().Release(fBufferRef);
    fBufferRef = user_buffer;
 }
 
@@ -825,8 +896,10 @@ void TBasket::Reset()
 
    fHeaderOnly  = kTRUE;
    fLast        = 0;  //Must initialize before calling Streamer()
+   fLittleEndian = kFALSE;
 
    Streamer(*fBufferRef);
+   AlignPayload();
 
    fKeylen      = fBufferRef->Length();
    fObjlen      = fBufferSize - fKeylen;
@@ -906,7 +979,10 @@ void TBasket::Streamer(TBuffer &b)
             fNevBufSize = 0;
             MakeZombie();
          }
+      } else {
+         fIOBits = 0;
       }
+      fLittleEndian = fIOBits & static_cast<UChar_t>(EIOBits::kLittleEndian);
       b >> fNevBuf;
       b >> fLast;
       b >> flag;
@@ -936,7 +1012,7 @@ void TBasket::Streamer(TBuffer &b)
          fEntryOffset = reinterpret_cast<Int_t *>(-1);
       }
       if (flag == 1 || flag > 10) {
-         fBufferRef = new TBufferFile(TBuffer::kRead,fBufferSize);
+         fBufferRef = ROOT::Experimental::TBasketBufferPool::GetInstance().Acquire(fBufferSize, TBuffer::kRead);
          fBufferRef->SetParent(b.GetParent());
          char *buf  = fBufferRef->Buffer();
          if (v > 1) b.ReadFastArray(buf,fLast);
@@ -957,9 +1033,14 @@ void TBasket::Streamer(TBuffer &b)
       if (fLast > fBufferSize) fBufferSize = fLast;
 
       b << fBufferSize;
-      if (fIOBits) {
+      UChar_t ioBits = fIOBits;
+      if (!fHeaderOnly && !fLittleEndian) {
+         // The buffer streamed below is in the big-endian order of the leaves.
+         ioBits &= ~static_cast<UChar_t>(EIOBits::kLittleEndian);
+      }
+      if (ioBits) {
          b << -fNevBufSize;
-         b << fIOBits;
+         b << ioBits;
       } else {
          b << fNevBufSize;
       }
@@ -1050,6 +1131,16 @@ void TBasket::Update(Int_t offset, Int_t skipped)
 /// If no data are written, the number of bytes returned is 0.
 
 Int_t TBasket::WriteBuffer()
+{
+   return WriteBufferImpl(fBranch->GetWriteBasket());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of WriteBuffer(). The cycle of the key is passed by the
+/// caller: when the basket is written in the background (see
+/// TTree::SetAsyncFlush) the branch has already moved on to its next basket.
+
+Int_t TBasket::WriteBufferImpl(Int_t cycle)
 {
    const Int_t kWrite = 1;
 
@@ -1093,6 +1184,9 @@ Int_t TBasket::WriteBuffer()
 
    // Transfer fEntryOffset table at the end of fBuffer.
    fLast = fBufferRef->Length();
+   if ((fIOBits & static_cast<UChar_t>(EIOBits::kLittleEndian)) && !fLittleEndian) {
+      SwapByteOrder();
+   }
    Int_t *entryOffset = GetEntryOffset();
    if (entryOffset) {
       Bool_t hasOffsetBit = fIOBits & static_cast<UChar_t>(TBasket::EIOBits::kGenerateOffsetMap);
@@ -1130,7 +1224,7 @@ Int_t TBasket::WriteBuffer()
    fObjlen    = lbuf - fKeylen;
 
    fHeaderOnly = kTRUE;
-   fCycle = fBranch->GetWriteBasket();
+   fCycle = cycle;
    Int_t cxlevel = fBranch->GetCompressionLevel();
    ROOT::RCompressionSetting::EAlgorithm::EValues cxAlgorithm = static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(fBranch->GetCompressionAlgorithm());
    if (cxlevel > 0) {
@@ -1145,6 +1239,7 @@ Int_t TBasket::WriteBuffer()
       fBuffer = fCompressedBufferRef->Buffer();
       char *objbuf = fBufferRef->Buffer() + fKeylen;
       char *bufcur = &fBuffer[fKeylen];
+      const std::vector<char> *dict = nullptr;
       noutot = 0;
       nzip   = 0;
       for (Int_t i = 0; i < nbuffers; ++i) {
@@ -1159,7 +1254,10 @@ Int_t TBasket::WriteBuffer()
          // NOTE this is declared with C linkage, so it shouldn't except.  Also, when
          // USE_IMT is defined, we are guaranteed that the compression buffer is unique per-branch.
          // (see fCompressedBufferRef in constructor).
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
+         // The dictionary may be trained on this very basket: do it without holding the file lock.
+         if (i == 0) dict = fBranch->PrepareCompressionDictionary(objbuf, fObjlen, cxAlgorithm);
+         R__zipMultipleAlgorithmDict(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm,
+                                     dict ? dict->data() : nullptr, dict ? dict->size() : 0);
 #ifdef R__USE_IMT
          sentry.lock();
 #endif  // R__USE_IMT
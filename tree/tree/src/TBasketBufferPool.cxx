@@ -0,0 +1,232 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TBasketBufferPool.hxx"
+
+#include "TBufferFile.h"
+#include "TEnv.h"
+#include "TStorage.h"
+#include "TString.h"
+
+/**
+ * \class ROOT::Experimental::TBasketBufferPool
+ * \ingroup tree
+ *
+ * Process-wide pool of the I/O buffers of TBasket.  For example, to look at
+ * how many allocations were saved while reading a tree:
+ *
+ * ~~~ {.cpp}
+ * auto &pool = ROOT::Experimental::TBasketBufferPool::GetInstance();
+ * pool.ResetStats();
+ * tree->Draw("x");
+ * pool.Print();
+ * ~~~
+ */
+
+using namespace ROOT::Experimental;
+
+constexpr Int_t TBasketBufferPool::kMinLog2;
+constexpr Int_t TBasketBufferPool::kMaxLog2;
+constexpr Int_t TBasketBufferPool::kNumClasses;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the pool.  It is never deleted, since baskets of static trees may
+/// give back their buffers at the very end of the process.
+
+TBasketBufferPool &TBasketBufferPool::GetInstance()
+{
+   static TBasketBufferPool *gPool = new TBasketBufferPool();
+   return *gPool;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the pool, with the size limit set by the resource `TTree.BasketBufferPoolSize` (in MB).
+
+TBasketBufferPool::TBasketBufferPool()
+{
+   fMaxBytes = Long64_t(gEnv->GetValue("TTree.BasketBufferPoolSize", 64)) * 1024 * 1024;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Index of the smallest size class holding at least `size` bytes, -1 if
+/// the size is beyond the largest class.
+///
+/// The first class holds 2^kMinLog2 bytes; then each power of two is split
+/// in four classes, holding 1.25, 1.5, 1.75 and 2 times the previous power.
+
+Int_t TBasketBufferPool::GetSizeClass(Int_t size)
+{
+   if (size <= (1 << kMinLog2))
+      return 0;
+   if (size > (1 << kMaxLog2))
+      return -1;
+   Int_t log2 = kMinLog2;
+   while ((size - 1) >> (log2 + 1))
+      ++log2;
+   // 2^log2 < size <= 2^(log2+1); the two bits after the leading one give the quarter.
+   const Int_t quarter = ((size - 1) >> (log2 - 2)) & 3;
+   return (log2 - kMinLog2) * 4 + quarter + 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of bytes held by the buffers of a size class.
+
+Int_t TBasketBufferPool::GetClassSize(Int_t sizeClass)
+{
+   if (sizeClass <= 0)
+      return 1 << kMinLog2;
+   const Int_t log2 = kMinLog2 + (sizeClass - 1) / 4;
+   const Int_t quarter = (sizeClass - 1) % 4;
+   return (1 << log2) + (quarter + 1) * (1 << (log2 - 2));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a buffer of at least `size` bytes, in the given mode, and with its
+/// offset at 0.  The buffer should be given back with Release(); it can also
+/// simply be deleted.
+
+TBuffer *TBasketBufferPool::Acquire(Int_t size, TBuffer::EMode mode)
+{
+   ++fAcquired;
+   const Int_t sizeClass = GetSizeClass(size);
+   if (fMaxBytes <= 0 || sizeClass < 0)
+      return new TBufferFile(mode, size);
+
+   TBuffer *buffer = nullptr;
+   {
+      auto &sc = fClasses[sizeClass];
+      std::lock_guard<std::mutex> lock(sc.fMutex);
+      auto &buffers = sc.fBuffers[mode == TBuffer::kWrite];
+      if (!buffers.empty()) {
+         buffer = buffers.back();
+         buffers.pop_back();
+      }
+   }
+   if (!buffer)
+      return new TBufferFile(mode, GetClassSize(sizeClass));
+
+   ++fReused;
+   fPooledBytes -= buffer->BufferSize();
+   if (mode == TBuffer::kWrite)
+      buffer->SetWriteMode();
+   else
+      buffer->SetReadMode();
+   buffer->Reset();
+   return buffer;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Give back a buffer.  It is kept for reuse if it owns its memory and the
+/// pool is not full; otherwise it is deleted.
+
+void TBasketBufferPool::Release(TBuffer *buffer)
+{
+   if (!buffer)
+      return;
+   ++fReleased;
+
+   const Int_t size = buffer->BufferSize();
+   Int_t sizeClass = GetSizeClass(size);
+   // A buffer expanded to an arbitrary size serves the largest class it can hold.
+   if (sizeClass > 0 && GetClassSize(sizeClass) > size)
+      --sizeClass;
+   const Bool_t reusable = fMaxBytes > 0 && sizeClass >= 0 && size >= GetClassSize(0) &&
+                           buffer->IsA() == TBufferFile::Class() && buffer->TestBit(TBuffer::kIsOwner) &&
+                           buffer->GetReAllocFunc() == TStorage::ReAllocChar;
+   if (!reusable || fPooledBytes.fetch_add(size) + size > fMaxBytes) {
+      if (reusable)
+         fPooledBytes -= size;
+      ++fDiscarded;
+      delete buffer;
+      return;
+   }
+
+   Long64_t pooled = fPooledBytes;
+   Long64_t peak = fPeakBytes;
+   while (pooled > peak && !fPeakBytes.compare_exchange_weak(peak, pooled)) {
+   }
+
+   buffer->SetParent(nullptr);
+   buffer->ResetBit(TBufferFile::kNotDecompressed);
+   auto &sc = fClasses[sizeClass];
+   std::lock_guard<std::mutex> lock(sc.fMutex);
+   sc.fBuffers[buffer->IsWriting()].push_back(buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the maximum number of bytes held by the pool; 0 disables the pool.
+/// Buffers beyond the new limit are freed.
+
+void TBasketBufferPool::SetMaxBytes(Long64_t maxBytes)
+{
+   fMaxBytes = maxBytes;
+   if (fPooledBytes > fMaxBytes)
+      Clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the statistics of the pool.
+
+TBasketBufferPool::Stats TBasketBufferPool::GetStats() const
+{
+   Stats stats;
+   stats.fAcquired = fAcquired;
+   stats.fReused = fReused;
+   stats.fReleased = fReleased;
+   stats.fDiscarded = fDiscarded;
+   stats.fPooledBytes = fPooledBytes;
+   stats.fPeakBytes = fPeakBytes;
+   return stats;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reset the counters of the statistics.
+
+void TBasketBufferPool::ResetStats()
+{
+   fAcquired = 0;
+   fReused = 0;
+   fReleased = 0;
+   fDiscarded = 0;
+   fPeakBytes = Long64_t(fPooledBytes);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Free all the buffers held by the pool.
+
+void TBasketBufferPool::Clear()
+{
+   for (auto &sc : fClasses) {
+      std::vector<TBuffer *> buffers;
+      {
+         std::lock_guard<std::mutex> lock(sc.fMutex);
+         for (auto &list : sc.fBuffers) {
+            buffers.insert(buffers.end(), list.begin(), list.end());
+            list.clear();
+         }
+      }
+      for (auto buffer : buffers) {
+         fPooledBytes -= buffer->BufferSize();
+         delete buffer;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the statistics of the pool.
+
+void TBasketBufferPool::Print() const
+{
+   const auto stats = GetStats();
+   Printf("TBasketBufferPool: limit %lld bytes", GetMaxBytes());
+   Printf("  buffers acquired : %llu (%llu reused)", stats.fAcquired, stats.fReused);
+   Printf("  buffers released : %llu (%llu freed)", stats.fReleased, stats.fDiscarded);
+   Printf("  bytes pooled     : %lld (peak %lld)", stats.fPooledBytes, stats.fPeakBytes);
+}
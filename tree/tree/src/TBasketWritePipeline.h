@@ -0,0 +1,109 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TBasketWritePipeline
+#define ROOT_TBasketWritePipeline
+
+#include "Rtypes.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TTaskGroup.hxx"
+#include "TROOT.h"
+#endif
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+
+class TBasket;
+class TBranch;
+
+/// A helper class for the asynchronous write mode of TTree::Fill (see TTree::SetAsyncFlush).
+///
+/// The baskets filled by TTree::Fill are handed to the pipeline, which compresses and writes
+/// them in the ROOT thread pool while the producer goes on filling fresh baskets. At most
+/// GetDepth() baskets are in flight: the producer waits for them when the limit is reached.
+/// The results are collected by the producer thread, in submission order, so that all the
+/// branch bookkeeping stays single-threaded.
+namespace ROOT {
+namespace Internal {
+
+class TBasketWritePipeline {
+
+#ifdef R__USE_IMT
+using TaskGroup_t = ROOT::Experimental::TTaskGroup;
+#endif
+
+public:
+   struct Item {
+      TBranch *fBranch;             // Branch owning the basket.
+      TBasket *fBasket;             // Basket being compressed and written.
+      Int_t fWhere;                 // Index of the basket in the branch.
+      Int_t fNout{0};               // Result of the write: compressed size, or -1 on error.
+      std::atomic<bool> fDone{false}; // True once the write is over.
+
+      Item(TBranch *branch, TBasket *basket, Int_t where) : fBranch(branch), fBasket(basket), fWhere(where) {}
+   };
+
+   explicit TBasketWritePipeline(Int_t depth) : fDepth(depth > 0 ? depth : 1) {}
+   ~TBasketWritePipeline() { Wait(); }
+
+   Int_t GetDepth() const { return fDepth; }
+   Bool_t IsEmpty() const { return fItems.empty(); }
+   Bool_t IsFull() const { return Int_t(fItems.size()) >= fDepth; }
+
+   /// Hand a basket over; `write` performs the compression and the write and returns its result.
+   template<typename FN> void Submit(TBranch *branch, TBasket *basket, Int_t where, const FN &write) {
+      fItems.emplace_back(new Item(branch, basket, where));
+      Item *item = fItems.back().get();
+      auto task = [item, write]() {
+         item->fNout = write();
+         item->fDone = true;
+      };
+#ifdef R__USE_IMT
+      if (ROOT::IsImplicitMTEnabled()) {
+         if (!fGroup) { fGroup.reset(new TaskGroup_t()); }
+         fGroup->Run(task);
+         return;
+      }
+#endif
+      task();
+   }
+
+   /// Hand the finished items to `finish`, oldest first, stopping at the first one still running.
+   /// If `wait` is true, all the items are waited for and finished.
+   template<typename FN> void Finish(Bool_t wait, const FN &finish) {
+      if (wait) Wait();
+      while (!fItems.empty() && fItems.front()->fDone) {
+         std::unique_ptr<Item> item = std::move(fItems.front());
+         fItems.pop_front();
+         finish(*item);
+      }
+   }
+
+   void Wait() {
+#ifdef R__USE_IMT
+      if (fGroup) fGroup->Wait();
+#endif
+   }
+
+private:
+   Int_t fDepth;                              // Maximum number of baskets in flight.
+   std::deque<std::unique_ptr<Item>> fItems;  // Baskets in flight, in submission order.
+#ifdef R__USE_IMT
+   std::unique_ptr<TaskGroup_t> fGroup;
+#endif
+};
+
+} // Internal
+} // ROOT
+
+#endif
@@ -15,8 +15,10 @@
 
 #include "Bytes.h"
 #include "Compression.h"
+#include "RZip.h"
 #include "TBasket.h"
 #include "TBranchBrowsable.h"
+#include "TBranchElement.h"
 #include "TBrowser.h"
 #include "TBuffer.h"
 #include "TClass.h"
@@ -39,18 +41,23 @@
 #include "TROOT.h"
 #include "TSystem.h"
 #include "TMath.h"
+#include "TTimeStamp.h"
 #include "TTree.h"
 #include "TTreeCache.h"
 #include "TTreeCacheUnzip.h"
+#include "TVirtualCollectionProxy.h"
 #include "TVirtualMutex.h"
 #include "TVirtualPad.h"
 #include "TVirtualPerfStats.h"
+#include "TVirtualStreamerInfo.h"
 
+#include "TBasketWritePipeline.h"
 #include "TBranchIMTHelper.h"
 #include "ROOT/TBulkBranchRead.hxx"
 
 #include "ROOT/TIOFeatures.hxx"
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <string.h>
@@ -91,6 +98,7 @@ TBranch::TBranch()
 , fWriteBasket(0)
 , fEntryNumber(0)
 , fExtraBasket(nullptr)
+, fSpareBasket(nullptr)
 , fOffset(0)
 , fMaxBaskets(10)
 , fNBaskets(0)
@@ -201,6 +209,7 @@ TBranch::TBranch(TTree *tree, const char *name, void *address, const char *leafl
 , fWriteBasket(0)
 , fEntryNumber(0)
 , fExtraBasket(nullptr)
+, fSpareBasket(nullptr)
 , fIOFeatures(tree ? tree->GetIOFeatures().GetFeatures() : 0)
 , fOffset(0)
 , fMaxBaskets(10)
@@ -255,6 +264,7 @@ TBranch::TBranch(TBranch *parent, const char *name, void *address, const char *l
 , fWriteBasket(0)
 , fEntryNumber(0)
 , fExtraBasket(nullptr)
+, fSpareBasket(nullptr)
 , fIOFeatures(parent->fIOFeatures)
 , fOffset(0)
 , fMaxBaskets(10)
@@ -455,6 +465,9 @@ TBranch::~TBranch()
    delete [] fBasketBytes;
    fBasketBytes = 0;
 
+   delete fSpareBasket;
+   fSpareBasket = nullptr;
+
    fBaskets.Delete();
    fNBaskets = 0;
    fCurrentBasket = 0;
@@ -900,7 +913,8 @@ Int_t TBranch::FillImpl(ROOT::Internal::TBranchIMTHelper *imtHelper)
    if (noFlushAtCluster && !fTree->TestBit(TTree::kCircular) &&
        ((fSkipZip && (lnew >= TBuffer::kMinimalSize)) || (buf->TestBit(TBufferFile::kNotDecompressed)) ||
         ((lnew + (2 * nsize) + nbytes) >= fBasketSize))) {
-      Int_t nout = WriteBasketImpl(basket, fWriteBasket, imtHelper);
+      Int_t nout = fTree->fWritePipeline ? WriteBasketAsync(basket, fWriteBasket)
+                                         : WriteBasketImpl(basket, fWriteBasket, imtHelper);
       if (nout < 0) Error("TBranch::Fill", "Failed to write out basket.\n");
       return (nout >= 0) ? nbytes : -1;
    }
@@ -1433,7 +1447,7 @@ Int_t TBranch::GetBulkEntries(Long64_t entry, TBuffer &user_buf)
    // Remember which entry we are reading.
    fReadEntry = entry;
 
-   Bool_t enabled = !TestBit(kDoNotProcess);
+   Bool_t enabled = !TestBit(kDoNotProcess) || Reactivate();
    if (R__unlikely(!enabled)) return -1;
    TBasket *basket = nullptr;
    Long64_t first;
@@ -1464,7 +1478,12 @@ Int_t TBranch::GetBulkEntries(Long64_t entry, TBuffer &user_buf)
 
    Int_t N = ((fNextBasketEntry < 0) ? fEntryNumber : fNextBasketEntry) - first;
    //printf("Requesting %d events; fNextBasketEntry=%lld; first=%lld.\n", N, fNextBasketEntry, first);
-   if (R__unlikely(!leaf->ReadBasketFast(*buf, N))) {
+   if (basket->IsLittleEndian()) {
+      // The values are already in the native order of little-endian hosts.
+#ifndef R__BYTESWAP
+      basket->SwapByteOrder();
+#endif
+   } else if (R__unlikely(!leaf->ReadBasketFast(*buf, N))) {
       Error("GetBulkEntries", "Leaf failed to read.\n");
       return -1;
    }
@@ -1493,7 +1512,7 @@ Int_t TBranch::GetEntriesSerialized(Long64_t entry, TBuffer &user_buf, TBuffer *
    // Remember which entry we are reading.
    fReadEntry = entry;
 
-   Bool_t enabled = !TestBit(kDoNotProcess);
+   Bool_t enabled = !TestBit(kDoNotProcess) || Reactivate();
    if (R__unlikely(!enabled)) { return -1; }
    TBasket *basket = nullptr;
    Long64_t first;
@@ -1518,6 +1537,10 @@ Int_t TBranch::GetEntriesSerialized(Long64_t entry, TBuffer &user_buf, TBuffer *
       Error("GetEntriesSerialized", "Basket has displacement.\n");
       return -1;
    }
+   if (basket->IsLittleEndian()) {
+      // Serialized values are in big-endian order.
+      basket->SwapByteOrder();
+   }
 
    Int_t bufbegin = basket->GetKeylen();
    buf->SetBufferOffset(bufbegin);
@@ -1557,6 +1580,211 @@ Int_t TBranch::GetEntriesSerialized(Long64_t entry, TBuffer &user_buf, TBuffer *
    return N;
 }
 
+namespace {
+
+/// How the values of the entries of a branch are laid out in its baskets, as far as bulk IO is concerned.
+enum class EBulkLayout {
+   kUnsupported,      ///< Bulk IO with offsets is not possible
+   kFixed,            ///< The same number of values for each entry, one after the other
+   kCounted,          ///< A variable number of values for each entry, one after the other; boundaries in the entry offsets
+   kVectorWithHeader  ///< A std::vector per entry: byte count, version and size precede the values of each entry
+};
+
+/// Size in bytes of the fundamental types supported by bulk IO, 0 for the others.
+Int_t GetBulkTypeSize(EDataType type)
+{
+   switch (type) {
+   case kChar_t:
+   case kUChar_t:
+   case kBool_t: return 1;
+   case kShort_t:
+   case kUShort_t: return 2;
+   case kInt_t:
+   case kUInt_t:
+   case kFloat_t: return 4;
+   case kDouble_t:
+   case kLong64_t:
+   case kULong64_t: return 8;
+   default: return 0;
+   }
+}
+
+/// Find how the entries of a single-leaf branch are laid out in its baskets and the type of the values.
+EBulkLayout GetBulkLayout(TBranch &branch, TLeaf &leaf, EDataType &type)
+{
+   TClass *cl = nullptr;
+   type = kOther_t;
+   if (branch.GetExpectedType(cl, type))
+      return EBulkLayout::kUnsupported;
+
+   auto element = dynamic_cast<TBranchElement *>(&branch);
+   if (!cl) {
+      if (!GetBulkTypeSize(type))
+         return EBulkLayout::kUnsupported;
+      if (!element)
+         return leaf.GetLeafCount() ? EBulkLayout::kCounted : EBulkLayout::kFixed;
+      // Variable-size arrays of a data member (`//[fN]`) are preceded by a marker byte per entry
+      if (element->GetStreamerType() >= TVirtualStreamerInfo::kOffsetP)
+         return EBulkLayout::kUnsupported;
+      // Data members of the elements of a split TClonesArray or STL collection
+      if (element->GetType() == 31 || element->GetType() == 41)
+         return EBulkLayout::kCounted;
+      return EBulkLayout::kFixed;
+   }
+
+   // A std::vector of a fundamental type, streamed as a whole in each entry
+   auto proxy = cl->GetCollectionProxy();
+   if (!element || element->GetType() != 0 || !proxy || proxy->GetCollectionType() != ROOT::kSTLvector ||
+       proxy->HasPointers() || proxy->GetValueClass())
+      return EBulkLayout::kUnsupported;
+   type = proxy->GetType();
+   return GetBulkTypeSize(type) ? EBulkLayout::kVectorWithHeader : EBulkLayout::kUnsupported;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read all the entries of the basket which starts at the given entry, in
+/// columnar form: a contiguous array of values plus an array of offsets.
+///
+/// Returns -1 in case of a failure.  On success, returns the number N of
+/// entries read.  The caller can then access the values as
+///
+/// static_cast<T*>(buf.GetCurrent())
+///
+/// where T is the fundamental type of the values held by this branch; the
+/// values of entry i are those between the indices offsets[i] and
+/// offsets[i+1] (offsets has N+1 elements).  The values are in native byte
+/// order: they are byte-swapped in place, in a single pass over the basket.
+///
+/// Besides the fixed-size leaves supported by GetBulkEntries(Long64_t, TBuffer&),
+/// this supports variable-size arrays (`x[n]`), data members of split
+/// objects and of split collections, and std::vector of fundamental types.
+/// For the latter, the per-entry headers are removed and the values are
+/// compacted in place.
+
+Int_t TBranch::GetBulkEntries(Long64_t entry, TBuffer &user_buf, std::vector<Int_t> &offsets)
+{
+   if (R__unlikely(fNleaves != 1)) return -1;
+   TLeaf *leaf = static_cast<TLeaf*>(fLeaves.UncheckedAt(0));
+   EDataType type;
+   const auto layout = GetBulkLayout(*this, *leaf, type);
+   if (R__unlikely(layout == EBulkLayout::kUnsupported)) return -1;
+   const Int_t typeSize = GetBulkTypeSize(type);
+
+   // Remember which entry we are reading.
+   fReadEntry = entry;
+
+   Bool_t enabled = !TestBit(kDoNotProcess) || Reactivate();
+   if (R__unlikely(!enabled)) return -1;
+   TBasket *basket = nullptr;
+   Long64_t first;
+   Int_t result = GetBasketAndFirst(basket, first, &user_buf);
+   if (R__unlikely(result <= 0)) return -1;
+   // Only support reading from full clusters.
+   if (R__unlikely(entry != first)) {
+      return -1;
+   }
+
+   basket->PrepareBasket(entry);
+   TBuffer* buf = basket->GetBufferRef();
+
+   // Test for very old ROOT files.
+   if (R__unlikely(!buf)) {
+      Error("GetBulkEntries", "Failed to get a new buffer.\n");
+      return -1;
+   }
+   // Test for displacements, which aren't supported in fast mode.
+   if (R__unlikely(basket->GetDisplacement())) {
+      Error("GetBulkEntries", "Basket has displacement.\n");
+      return -1;
+   }
+
+   const Int_t bufbegin = basket->GetKeylen();
+   const Int_t bufend = basket->GetLast();
+   const Int_t N = ((fNextBasketEntry < 0) ? fEntryNumber : fNextBasketEntry) - first;
+   offsets.resize(N + 1);
+   offsets[0] = 0;
+
+   Int_t *entryOffset = layout == EBulkLayout::kFixed ? nullptr : basket->GetEntryOffset();
+   if (R__unlikely(layout != EBulkLayout::kFixed && !entryOffset)) {
+      Error("GetBulkEntries", "Basket of a variable-size branch has no entry offsets.\n");
+      return -1;
+   }
+   auto entryEnd = [&](Int_t i) { return i + 1 < N ? entryOffset[i + 1] : bufend; };
+
+   char *values = buf->Buffer() + bufbegin;
+   switch (layout) {
+   case EBulkLayout::kFixed: {
+      const Int_t len = leaf->GetLenStatic();
+      if (R__unlikely(Long64_t(N) * len * typeSize != bufend - bufbegin)) {
+         Error("GetBulkEntries", "Unexpected size of the basket of a fixed-size branch.\n");
+         return -1;
+      }
+      for (Int_t i = 0; i < N; ++i)
+         offsets[i + 1] = offsets[i] + len;
+      break;
+   }
+   case EBulkLayout::kCounted: {
+      for (Int_t i = 0; i < N; ++i) {
+         const Int_t nbytes = entryEnd(i) - entryOffset[i];
+         if (R__unlikely(nbytes < 0 || nbytes % typeSize)) {
+            Error("GetBulkEntries", "Unexpected size of entry %lld.\n", first + i);
+            return -1;
+         }
+         offsets[i + 1] = offsets[i] + nbytes / typeSize;
+      }
+      break;
+   }
+   case EBulkLayout::kVectorWithHeader: {
+      // Each entry is: byte count (with kByteCountMask), version, number of values, values.
+      // Drop the headers, moving the values of each entry right after those of the previous one.
+      const UInt_t kByteCountMask = 0x40000000;  // OR the byte count with this
+      constexpr Int_t headerSize = sizeof(UInt_t) + sizeof(Version_t) + sizeof(Int_t);
+      char *dest = values;
+      for (Int_t i = 0; i < N; ++i) {
+         char *src = buf->Buffer() + entryOffset[i];
+         const Int_t nbytes = entryEnd(i) - entryOffset[i];
+         UInt_t byteCount;
+         Version_t version;
+         Int_t nValues;
+         frombuf(src, &byteCount);
+         frombuf(src, &version);
+         frombuf(src, &nValues);
+         if (R__unlikely(nbytes < headerSize || !(byteCount & kByteCountMask) ||
+                         Int_t(byteCount & ~kByteCountMask) != nbytes - Int_t(sizeof(UInt_t)) || nValues < 0 ||
+                         Long64_t(nValues) * typeSize != nbytes - headerSize)) {
+            Error("GetBulkEntries", "Unexpected layout of entry %lld.\n", first + i);
+            return -1;
+         }
+         memmove(dest, src, nbytes - headerSize);
+         dest += nbytes - headerSize;
+         offsets[i + 1] = offsets[i] + nValues;
+      }
+      break;
+   }
+   case EBulkLayout::kUnsupported: return -1;
+   }
+
+   buf->SetBufferOffset(bufbegin);
+   if (basket->IsLittleEndian()) {
+#ifndef R__BYTESWAP
+      basket->SwapByteOrder();
+#endif
+   } else if (typeSize > 1 && R__unlikely(!buf->ByteSwapBuffer(offsets[N], type))) {
+      Error("GetBulkEntries", "Failed to byte-swap the values.\n");
+      return -1;
+   }
+   user_buf.SetBufferOffset(bufbegin);
+
+   fCurrentBasket = nullptr;
+   fBaskets[fReadBasket] = nullptr;
+   fExtraBasket = basket;
+   basket->DisownBuffer();
+
+   return N;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read all leaves of entry and return total number of bytes read.
 ///
@@ -1581,7 +1809,7 @@ Int_t TBranch::GetEntry(Long64_t entry, Int_t getall)
    // Remember which entry we are reading.
    fReadEntry = entry;
 
-   if (R__unlikely(TestBit(kDoNotProcess) && !getall)) { return 0; }
+   if (R__unlikely(TestBit(kDoNotProcess) && !getall && !Reactivate())) { return 0; }
 
    TBasket *basket; // will be initialized in the if/then clauses.
    Long64_t first;
@@ -1599,6 +1827,10 @@ Int_t TBranch::GetEntry(Long64_t entry, Int_t getall)
       basket->ReadBasketBuffers(fBasketSeek[fReadBasket], fBasketBytes[fReadBasket], file);
       buf = basket->GetBufferRef();
    }
+   if (R__unlikely(basket->IsLittleEndian())) {
+      // The leaves read values in big-endian order.
+      basket->SwapByteOrder();
+   }
 
    // Set entry offset in buffer.
    if (!TestBit(kDoNotUseBufferMap)) {
@@ -1623,10 +1855,33 @@ Int_t TBranch::GetEntry(Long64_t entry, Int_t getall)
    }
 
    // Int_t bufbegin = buf->Length();
-   (this->*fReadLeaves)(*buf);
+   if (R__unlikely(fTree->GetPerfStats())) {
+      // Optional monitor for deserialization time profiling.
+      Double_t start = TTimeStamp();
+      (this->*fReadLeaves)(*buf);
+      fTree->GetPerfStats()->BranchReadEvent(this, start);
+   } else {
+      (this->*fReadLeaves)(*buf);
+   }
    return buf->Length() - bufbegin;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Reactivate a branch that TTree::Process deactivated because it was not
+/// read in the first entries (see TTree::SetAutoBranchActivation), now that
+/// it is read after all.  Return kFALSE if the branch was deactivated by the
+/// user.
+
+Bool_t TBranch::Reactivate()
+{
+   if (!TestBit(kAutoDeactivated))
+      return kFALSE;
+   SetAutoDeactivated(kFALSE);
+   if (gDebug > 0)
+      Info("Reactivate", "Branch %s was read after its automatic deactivation", GetName());
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read all leaves of an entry and export buffers to real objects in a TClonesArray list.
 ///
@@ -1637,7 +1892,7 @@ Int_t TBranch::GetEntryExport(Long64_t entry, Int_t /*getall*/, TClonesArray* li
    // Remember which entry we are reading.
    fReadEntry = entry;
 
-   if (TestBit(kDoNotProcess)) {
+   if (TestBit(kDoNotProcess) && !Reactivate()) {
       return 0;
    }
    if ((entry < 0) || (entry >= fEntryNumber)) {
@@ -1672,6 +1927,9 @@ Int_t TBranch::GetEntryExport(Long64_t entry, Int_t /*getall*/, TClonesArray* li
       return 0;
    }
    TBuffer* buf = basket->GetBufferRef();
+   if (R__unlikely(basket->IsLittleEndian())) {
+      basket->SwapByteOrder();
+   }
    // Set entry offset in buffer and read data from all leaves.
    if (!TestBit(kDoNotUseBufferMap)) {
       buf->ResetMap();
@@ -2068,6 +2326,15 @@ ROOT::TIOFeatures TBranch::GetIOFeatures() const
    return fIOFeatures;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the branch was deactivated by TTree::Process because it
+/// was not read (see TTree::SetAutoBranchActivation).
+
+Bool_t TBranch::IsAutoDeactivated() const
+{
+   return TestBit(kAutoDeactivated);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return kTRUE if an existing object in a TBranchObject must be deleted.
 
@@ -2510,6 +2777,17 @@ void TBranch::SetAddress(void* addr)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Deactivate the branch on behalf of TTree::Process, or reactivate it.
+/// Unlike a branch deactivated with TTree::SetBranchStatus, such a branch is
+/// reactivated as soon as it is read (see TTree::SetAutoBranchActivation).
+
+void TBranch::SetAutoDeactivated(Bool_t deactivated)
+{
+   SetBit(kDoNotProcess, deactivated);
+   SetBit(kAutoDeactivated, deactivated);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the automatic delete bit.
 ///
@@ -2624,6 +2902,114 @@ void TBranch::SetCompressionSettings(Int_t settings)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the dictionary used to compress the baskets written from now on, for
+/// instance one obtained from the same branch of another tree.  An empty
+/// dictionary stops its use.
+///
+/// Only the ZSTD algorithm compresses with a dictionary: it helps most for
+/// small baskets, which do not give the compression enough data to learn
+/// from.  The dictionary is stored with the branch metadata; the baskets
+/// compressed with it cannot be read without it.  The unzipping tasks of
+/// TTreeCacheUnzip use it as well; a basket they cannot attribute to its
+/// branch is unzipped serially by TBasket (see
+/// TTreeCacheUnzip::GetNNoDictionary()).
+
+void TBranch::SetCompressionDictionary(const char *dict, Int_t size)
+{
+   if (dict && size > 0)
+      fCompressionDictionary.assign(dict, dict + size);
+   else
+      fCompressionDictionary.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Train the compression dictionary of the branch and of its sub-branches on
+/// the first `nbaskets` baskets they write.  These are compressed without
+/// dictionary; the following ones with the trained dictionary, of at most
+/// `maxsize` bytes.  If the training fails (for instance because the branch
+/// is not compressed with ZSTD), the branch keeps writing without dictionary.
+/// A value of `nbaskets` of 0 or less cancels the training.
+///
+/// See SetCompressionDictionary().
+
+void TBranch::SetCompressionDictionaryTraining(Int_t nbaskets, Int_t maxsize)
+{
+   if (nbaskets > 0) {
+      fDictTraining.reset(new DictionaryTraining);
+      fDictTraining->fNBaskets = nbaskets;
+      fDictTraining->fMaxSize = maxsize;
+   } else {
+      fDictTraining.reset();
+   }
+
+   Int_t nb = fBranches.GetEntriesFast();
+   for (Int_t i=0;i<nb;i++) {
+      TBranch *branch = (TBranch*)fBranches.UncheckedAt(i);
+      branch->SetCompressionDictionaryTraining(nbaskets, maxsize);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Train the compression dictionary of the branch, of at most `maxsize` bytes,
+/// on `nsamples` buffers representative of the content of its baskets, stored
+/// one after the other in `samples`.  Return false if the training failed, in
+/// which case the dictionary is left unchanged.
+///
+/// See SetCompressionDictionary().
+
+Bool_t TBranch::TrainCompressionDictionary(const char *samples, const Int_t *sizes, Int_t nsamples, Int_t maxsize)
+{
+   auto algorithm = static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(GetCompressionAlgorithm());
+   std::vector<char> dict(maxsize > 0 ? maxsize : 0);
+   Int_t size = R__zipTrainDictionary(algorithm, samples, sizes, nsamples, dict.data(), dict.size());
+   if (size <= 0)
+      return kFALSE;
+   dict.resize(size);
+   fCompressionDictionary.swap(dict);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the dictionary to compress a basket with, nullptr if none.
+///
+/// While the dictionary is trained (see SetCompressionDictionaryTraining()),
+/// the content of the basket is kept as a sample; when enough samples are
+/// collected, the dictionary is trained and used from this basket onwards.
+
+const std::vector<char> *TBranch::PrepareCompressionDictionary(const char *buffer, Int_t size, Int_t algorithm)
+{
+   if (fDictTraining) {
+      auto &training = *fDictTraining;
+      std::lock_guard<std::mutex> lock(training.fMutex);
+      if (training.fNBaskets > 0) {
+         // The training gains little from the part of a sample beyond 128 kB.
+         const Int_t len = std::min(size, 128 * 1024);
+         training.fSamples.insert(training.fSamples.end(), buffer, buffer + len);
+         training.fSampleSizes.push_back(len);
+         if ((Int_t)training.fSampleSizes.size() < training.fNBaskets)
+            return nullptr;
+
+         std::vector<char> dict(training.fMaxSize > 0 ? training.fMaxSize : 0);
+         Int_t dictsize =
+            R__zipTrainDictionary(static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(algorithm),
+                                  training.fSamples.data(), training.fSampleSizes.data(),
+                                  training.fSampleSizes.size(), dict.data(), dict.size());
+         if (dictsize > 0) {
+            dict.resize(dictsize);
+            fCompressionDictionary.swap(dict);
+         } else {
+            Warning("PrepareCompressionDictionary",
+                    "Could not train a compression dictionary for the branch %s, it is written without", GetName());
+         }
+         training.fNBaskets = 0;
+         std::vector<char>().swap(training.fSamples);
+         std::vector<Int_t>().swap(training.fSampleSizes);
+      }
+   }
+   return fCompressionDictionary.empty() ? nullptr : &fCompressionDictionary;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Update the default value for the branch's fEntryOffsetLen if and only if
 /// it was already non zero (and the new value is not zero)
@@ -3009,14 +3395,7 @@ void TBranch::Streamer(TBuffer& b)
 
 Int_t TBranch::WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBranchIMTHelper *imtHelper)
 {
-   Int_t nevbuf = basket->GetNevBuf();
-   if (fEntryOffsetLen > 10 &&  (4*nevbuf) < fEntryOffsetLen ) {
-      // Make sure that the fEntryOffset array does not stay large unnecessarily.
-      fEntryOffsetLen = nevbuf < 3 ? 10 : 4*nevbuf; // assume some fluctuations.
-   } else if (fEntryOffsetLen && nevbuf > fEntryOffsetLen) {
-      // Increase the array ...
-      fEntryOffsetLen = 2*nevbuf; // assume some fluctuations.
-   }
+   UpdateEntryOffsetLen(basket->GetNevBuf());
 
    // Note: captures `basket`, `where`, and `this` by value; modifies the TBranch and basket,
    // as we make a copy of the pointer.  We cannot capture `basket` by reference as the pointer
@@ -3080,6 +3459,110 @@ Int_t TBranch::WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBr
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Adapt the length of the fEntryOffset table of the next baskets to the number
+/// of entries of the basket being written.
+
+void TBranch::UpdateEntryOffsetLen(Int_t nevbuf)
+{
+   if (fEntryOffsetLen > 10 &&  (4*nevbuf) < fEntryOffsetLen ) {
+      // Make sure that the fEntryOffset array does not stay large unnecessarily.
+      fEntryOffsetLen = nevbuf < 3 ? 10 : 4*nevbuf; // assume some fluctuations.
+   } else if (fEntryOffsetLen && nevbuf > fEntryOffsetLen) {
+      // Increase the array ...
+      fEntryOffsetLen = 2*nevbuf; // assume some fluctuations.
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Hand the full write basket over to the tree's background write pipeline
+/// (see TTree::SetAsyncFlush) and move on to a fresh basket, without waiting
+/// for the compression and the write.
+///
+/// The basket's location on file is recorded by FinishWriteBasket, called by
+/// the tree once the write is over. Returns 0, or -1 on error.
+
+Int_t TBranch::WriteBasketAsync(TBasket* basket, Int_t where)
+{
+   auto pipeline = fTree->fWritePipeline;
+
+   // Collect the baskets already written; wait for the oldest ones if too many are in flight.
+   fTree->FinishAsyncBaskets(pipeline->IsFull());
+
+   UpdateEntryOffsetLen(basket->GetNevBuf());
+
+   // Several baskets of this branch may be compressed at the same time: each of them needs
+   // its own compression buffer instead of the one shared by the branch.
+   if (!basket->fOwnsCompressedBuffer) {
+      basket->fCompressedBufferRef = new TBufferFile(TBuffer::kRead, fBasketSize);
+      basket->fOwnsCompressedBuffer = kTRUE;
+   }
+
+   const Int_t cycle = fWriteBasket;
+   fBaskets[where] = 0;
+   --fNBaskets;
+   if (basket == fCurrentBasket) {
+      fCurrentBasket    = 0;
+      fFirstBasketEntry = -1;
+      fNextBasketEntry  = -1;
+   }
+
+   ++fWriteBasket;
+   if (fWriteBasket >= fMaxBaskets) {
+      ExpandBasketArrays();
+   }
+   // Continue with a basket written earlier if there is one, otherwise FillImpl creates a new one.
+   if (fSpareBasket) {
+      fBaskets.AddAtAndExpand(fSpareBasket, fWriteBasket);
+      fSpareBasket = nullptr;
+      ++fNBaskets;
+   }
+   fBasketEntry[fWriteBasket] = fEntryNumber;
+
+   pipeline->Submit(this, basket, where, [basket, cycle]() { return basket->WriteBufferImpl(cycle); });
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record the result of the background write of the basket number where,
+/// submitted by WriteBasketAsync. The basket is kept for reuse, or deleted
+/// if this branch already has one in reserve. If the write failed, the
+/// basket goes back to the list of baskets in memory, as done by WriteBasketImpl.
+
+void TBranch::FinishWriteBasket(TBasket* basket, Int_t where, Int_t nout)
+{
+   if (nout < 0) Error("TBranch::WriteBasketAsync", "basket's WriteBuffer failed.\n");
+   fBasketBytes[where]  = basket->GetNbytes();
+   fBasketSeek[where]   = basket->GetSeekKey();
+   if (nout <= 0) {
+      fBaskets.AddAtAndExpand(basket, where);
+      ++fNBaskets;
+      return;
+   }
+
+   Int_t addbytes = basket->GetObjlen() + basket->GetKeylen();
+   basket->Reset();
+   fZipBytes += nout;
+   fTotBytes += addbytes;
+   fTree->AddTotBytes(addbytes);
+   fTree->AddZipBytes(nout);
+#ifdef R__TRACK_BASKET_ALLOC_TIME
+   fTree->AddAllocationTime(basket->GetResetAllocationTime());
+#endif
+   fTree->AddAllocationCount(basket->GetResetAllocationCount());
+
+   if (!fSpareBasket && (fWriteBasket >= fBaskets.GetSize() || !fBaskets.UncheckedAt(fWriteBasket))) {
+      // FillImpl did not need a fresh basket yet: give this one back right away.
+      fBaskets.AddAtAndExpand(basket, fWriteBasket);
+      ++fNBaskets;
+   } else if (!fSpareBasket) {
+      fSpareBasket = basket;
+   } else {
+      basket->DropBuffers();
+      delete basket;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///set the first entry number (case of TBranchSTL)
 
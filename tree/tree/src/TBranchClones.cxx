@@ -262,7 +262,7 @@ Int_t TBranchClones::FillImpl(ROOT::Internal::TBranchIMTHelper *imtHelper)
 
 Int_t TBranchClones::GetEntry(Long64_t entry, Int_t getall)
 {
-   if (TestBit(kDoNotProcess) && !getall) {
+   if (TestBit(kDoNotProcess) && !getall && !Reactivate()) {
       return 0;
    }
    Int_t nbytes = fBranchCount->GetEntry(entry, getall);
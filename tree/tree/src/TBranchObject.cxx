@@ -205,7 +205,7 @@ Int_t TBranchObject::FillImpl(ROOT::Internal::TBranchIMTHelper *imtHelper)
 
 Int_t TBranchObject::GetEntry(Long64_t entry, Int_t getall)
 {
-   if (TestBit(kDoNotProcess) && !getall) {
+   if (TestBit(kDoNotProcess) && !getall && !Reactivate()) {
       return 0;
    }
    Int_t nbytes;
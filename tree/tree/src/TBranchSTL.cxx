@@ -348,7 +348,7 @@ Int_t TBranchSTL::GetEntry( Long64_t entry, Int_t getall )
    //---------------------------------------------------------------------------
    // Check if we should be doing this at all
    //---------------------------------------------------------------------------
-   if( TestBit( kDoNotProcess ) && !getall )
+   if( TestBit( kDoNotProcess ) && !getall && !Reactivate() )
       return 0;
 
    if ( (entry < fFirstEntry) || (entry >= fEntryNumber) )
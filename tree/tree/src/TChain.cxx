@@ -32,10 +32,12 @@ the trees in the chain.
 #include "TClass.h"
 #include "TColor.h"
 #include "TCut.h"
+#include "TEnv.h"
 #include "TError.h"
 #include "TMath.h"
 #include "TFile.h"
 #include "TFileInfo.h"
+#include "TFileCollection.h"
 #include "TFriendElement.h"
 #include "TLeaf.h"
 #include "TList.h"
@@ -55,6 +57,12 @@ the trees in the chain.
 #include "TFileStager.h"
 #include "TFilePrefetch.h"
 #include "TVirtualMutex.h"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <memory>
+#include <vector>
 
 ClassImp(TChain);
 
@@ -73,6 +81,11 @@ TChain::TChain()
 , fFiles(0)
 , fStatus(0)
 , fProofChain(0)
+, fPrefetchNextFile(gEnv->GetValue("TChain.PrefetchNextFile", 0) != 0)
+, fNextTreeNumber(-1)
+, fNextFileHandle(0)
+, fNextFile(0)
+, fLastClusterStart(-1)
 {
    fTreeOffset = new Long64_t[fTreeOffsetLen];
    fFiles = new TObjArray(fTreeOffsetLen);
@@ -147,6 +160,11 @@ TChain::TChain(const char* name, const char* title)
 , fFiles(0)
 , fStatus(0)
 , fProofChain(0)
+, fPrefetchNextFile(gEnv->GetValue("TChain.PrefetchNextFile", 0) != 0)
+, fNextTreeNumber(-1)
+, fNextFileHandle(0)
+, fNextFile(0)
+, fLastClusterStart(-1)
 {
    //
    //*-*
@@ -198,6 +216,7 @@ TChain::~TChain()
       fFile->SetCacheRead(0, fTree);
    }
 
+   ReleaseNextFile();
    delete fFile;
    fFile = 0;
    // Note: We do *not* own the tree.
@@ -558,12 +577,17 @@ Int_t TChain::AddFileInfoList(TCollection* filelist, Long64_t nfiles /* = TTree:
       return 0;
    TIter next(filelist);
 
+   // Name of the meta data holding the number of entries of our tree
+   TString metaname = GetName();
+   if (!metaname.BeginsWith("/")) metaname.Prepend("/");
+
    TObject *o = 0;
    Long64_t cnt=0;
    while ((o = next())) {
       // Get the url
       TString cn = o->ClassName();
       const char *url = 0;
+      Long64_t nentries = TTree::kMaxEntries;
       if (cn == "TFileInfo") {
          TFileInfo *fi = (TFileInfo *)o;
          url = (fi->GetCurrentUrl()) ? fi->GetCurrentUrl()->GetUrl() : 0;
@@ -571,6 +595,11 @@ Int_t TChain::AddFileInfoList(TCollection* filelist, Long64_t nfiles /* = TTree:
             Warning("AddFileInfoList", "found TFileInfo with empty Url - ignoring");
             continue;
          }
+         // Use the number of entries recorded in the meta data, if any,
+         // so that the file does not have to be opened to get it
+         TFileInfoMeta *meta = fi->GetMetaData(metaname);
+         if (meta && meta->GetEntries() > 0)
+            nentries = meta->GetEntries();
       } else if (cn == "TUrl") {
          url = ((TUrl*)o)->GetUrl();
       } else if (cn == "TObjString") {
@@ -583,7 +612,7 @@ Int_t TChain::AddFileInfoList(TCollection* filelist, Long64_t nfiles /* = TTree:
       }
       // Good entry
       cnt++;
-      AddFile(url);
+      AddFile(url, nentries);
       if (cnt >= nfiles)
          break;
    }
@@ -935,7 +964,8 @@ Long64_t TChain::GetChainEntryNumber(Long64_t entry) const
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the total number of entries in the chain.
 /// In case the number of entries in each tree is not yet known,
-/// the offset table is computed.
+/// the offset table is computed. If implicit multi-threading is
+/// enabled, the files are scanned in parallel (see ScanEntries).
 
 Long64_t TChain::GetEntries() const
 {
@@ -946,6 +976,9 @@ Long64_t TChain::GetEntries() const
                                " run TChain::SetProof(kTRUE, kTRUE) first");
       return fProofChain->GetEntries();
    }
+   if (fEntries == TTree::kMaxEntries && ROOT::IsImplicitMTEnabled()) {
+      const_cast<TChain*>(this)->ScanEntries();
+   }
    if (fEntries == TTree::kMaxEntries) {
       const_cast<TChain*>(this)->LoadTree(TTree::kMaxEntries-1);
    }
@@ -1241,6 +1274,161 @@ void TChain::InvalidateCurrentTree()
    fTree = 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Open the next file of the chain ahead of time, while the last cluster of
+/// the current tree is being processed. Called by LoadTree when
+/// SetPrefetchNextFile is active.
+///
+/// At the beginning of the last cluster an asynchronous open of the next file
+/// is requested (see TFile::AsyncOpen; where the protocol does not support it,
+/// the file is opened later, synchronously). Half-way through the last
+/// cluster, the open is completed, the tree is read from the file and the
+/// baskets of its first cluster are requested, for the branches the
+/// TTreeCache of the current tree has learned, through the asynchronous
+/// read-ahead of the file (see TFile::ReadBufferAsync). When LoadTree then
+/// switches to the next tree, it uses this file instead of opening it.
+
+void TChain::PrefetchNextFile(Long64_t treeReadEntry)
+{
+   const Int_t nextTreeNumber = fTreeNumber + 1;
+   if (!fTree || nextTreeNumber >= fNtrees) {
+      return;
+   }
+   if (fNextTreeNumber == nextTreeNumber && !fNextFileHandle) {
+      // Already opened (or failed to open) ahead of time.
+      return;
+   }
+
+   const Long64_t nentries = fTree->GetEntries();
+   if (fLastClusterStart < 0) {
+      if (nentries <= 0) {
+         return;
+      }
+      TTree::TClusterIterator clusterIter = fTree->GetClusterIterator(nentries - 1);
+      fLastClusterStart = clusterIter.Next();
+   }
+   if (treeReadEntry < fLastClusterStart) {
+      return;
+   }
+
+   TChainElement *element = (TChainElement *)fFiles->At(nextTreeNumber);
+   if (!element) {
+      return;
+   }
+
+   if (fNextTreeNumber != nextTreeNumber) {
+      ReleaseNextFile();
+      fNextTreeNumber = nextTreeNumber;
+      TDirectory::TContext ctxt;
+      fNextFileHandle = TFile::AsyncOpen(element->GetTitle());
+      if (!fNextFileHandle) {
+         return;
+      }
+   }
+
+   if (treeReadEntry < (fLastClusterStart + nentries) / 2) {
+      return;
+   }
+
+   // Complete the open and prefetch the first cluster of the next tree.
+   {
+      TDirectory::TContext ctxt;
+      fNextFile = TFile::Open(fNextFileHandle);
+      fNextFileHandle = 0;
+   }
+   if (!fNextFile || fNextFile->IsZombie()) {
+      // LoadTree will try again, and report the error.
+      delete fNextFile;
+      fNextFile = 0;
+      return;
+   }
+   fNextFile->SetBit(kMustCleanup);
+
+   TTree *nextTree = dynamic_cast<TTree *>(fNextFile->Get(element->GetName()));
+   TTreeCache *cache = fTree->GetReadCache(fFile);
+   if (!nextTree || !cache || cache->IsLearning() || !cache->GetCachedBranches()) {
+      return;
+   }
+
+   TTree::TClusterIterator clusterIter = nextTree->GetClusterIterator(0);
+   clusterIter.Next();
+   const Long64_t firstClusterEnd = clusterIter.GetNextEntry();
+
+   TIter next(cache->GetCachedBranches());
+   while (TBranch *branch = (TBranch *)next()) {
+      TBranch *nextBranch = nextTree->GetBranch(branch->GetName());
+      if (!nextBranch) {
+         continue;
+      }
+      const Long64_t *basketEntry = nextBranch->GetBasketEntry();
+      const Int_t *basketBytes = nextBranch->GetBasketBytes();
+      for (Int_t i = 0; i < nextBranch->GetWriteBasket() && basketEntry[i] < firstClusterEnd; ++i) {
+         if (nextBranch->GetBasketSeek(i) && basketBytes[i] > 0) {
+            // ReadBufferAsync returns kTRUE if read-ahead is not supported by this kind of file.
+            if (fNextFile->ReadBufferAsync(nextBranch->GetBasketSeek(i), basketBytes[i])) {
+               return;
+            }
+         }
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Close the file opened ahead of time by PrefetchNextFile, if any.
+
+void TChain::ReleaseNextFile()
+{
+   if (fNextFileHandle) {
+      // Complete the pending request so that the handle is released.
+      TDirectory::TContext ctxt;
+      delete TFile::Open(fNextFileHandle);
+      fNextFileHandle = 0;
+   }
+   delete fNextFile;
+   fNextFile = 0;
+   fNextTreeNumber = -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the file of the tree number treenum if it was opened ahead of time by
+/// PrefetchNextFile, transferring its ownership to the caller. Otherwise,
+/// close the file opened ahead of time, if any, and return 0.
+
+TFile *TChain::TakeNextFile(Int_t treenum)
+{
+   if (treenum != fNextTreeNumber) {
+      ReleaseNextFile();
+      return 0;
+   }
+   TFile *file = fNextFile;
+   if (!file && fNextFileHandle) {
+      file = TFile::Open(fNextFileHandle);
+   }
+   fNextFileHandle = 0;
+   fNextFile = 0;
+   fNextTreeNumber = -1;
+   return file;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the opening of the next file of the chain ahead of time.
+///
+/// When enabled, while the last cluster of a file is being processed, the
+/// next file is opened (asynchronously, if the protocol supports it), its tree
+/// is read and the first cluster of the branches learned by the TTreeCache is
+/// requested through the asynchronous read-ahead of the file. This hides the
+/// latency of switching files, which dominates chains of many small remote
+/// files. The default is taken from the `TChain.PrefetchNextFile` resource
+/// (default 0, i.e. disabled).
+
+void TChain::SetPrefetchNextFile(Bool_t prefetch)
+{
+   fPrefetchNextFile = prefetch;
+   if (!prefetch) {
+      ReleaseNextFile();
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Dummy function.
 /// It could be implemented and load all baskets of all trees in the chain.
@@ -1408,6 +1596,9 @@ Long64_t TChain::LoadTree(Long64_t entry)
             }
          }
       }
+      if (fPrefetchNextFile) {
+         PrefetchNextFile(treeReadEntry);
+      }
       return treeReadEntry;
    }
 
@@ -1480,7 +1671,8 @@ Long64_t TChain::LoadTree(Long64_t entry)
    //        if we did not delete it above.
    {
       TDirectory::TContext ctxt;
-      fFile = TFile::Open(element->GetTitle());
+      fFile = TakeNextFile(treenum);
+      if (!fFile) fFile = TFile::Open(element->GetTitle());
       if (fFile) fFile->SetBit(kMustCleanup);
    }
 
@@ -1509,6 +1701,7 @@ Long64_t TChain::LoadTree(Long64_t entry)
    }
 
    fTreeNumber = treenum;
+   fLastClusterStart = -1;
    // FIXME: We own fFile, we must be careful giving away a pointer to it!
    // FIXME: We may set fDirectory to zero here!
    fDirectory = fFile;
@@ -1633,6 +1826,7 @@ Long64_t TChain::LoadTree(Long64_t entry)
 
    fTree->SetMakeClass(fMakeClass);
    fTree->SetMaxVirtualSize(fMaxVirtualSize);
+   fTree->SetPerfStats(GetPerfStats());
 
    SetChainOffset(fTreeOffset[fTreeNumber]);
 
@@ -1818,6 +2012,42 @@ void TChain::ls(Option_t* option) const
    TROOT::DecreaseDirLevel();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return a new TFileCollection describing the files of this chain.
+///
+/// The number of entries of each tree is computed, in parallel if implicit
+/// multi-threading is enabled (see ScanEntries), and recorded in the meta data
+/// of the TFileInfo objects. The collection can be saved, e.g. next to the
+/// data, and used in later sessions to build the chain without opening the
+/// files to count their entries:
+/// ~~~{.cpp}
+///   // First session
+///   TChain ch("T");
+///   ch.Add("/data/run*.root");
+///   TFile f("run_files.root", "RECREATE");
+///   ch.MakeFileCollection("run_files")->Write();
+///   // Later sessions
+///   TFile f("run_files.root");
+///   TChain ch("T");
+///   ch.AddFileInfoList(f.Get<TFileCollection>("run_files")->GetList());
+/// ~~~
+/// The caller owns the returned collection.
+
+TFileCollection *TChain::MakeFileCollection(const char *name)
+{
+   ScanEntries();
+   TFileCollection *collection = new TFileCollection(name, GetTitle());
+   for (Int_t i = 0; i < fNtrees; i++) {
+      TChainElement *element = (TChainElement*) fFiles->UncheckedAt(i);
+      TFileInfo *info = new TFileInfo(element->GetTitle());
+      if (element->GetEntries() != TTree::kMaxEntries)
+         info->AddMetaData(new TFileInfoMeta(element->GetName(), "TTree", element->GetEntries()));
+      collection->Add(info);
+   }
+   collection->Update();
+   return collection;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Merge all the entries in the chain into a new tree in a new file.
 ///
@@ -2245,6 +2475,10 @@ void TChain::RecursiveRemove(TObject *obj)
    if (fTree == obj) {
       fTree = 0;
    }
+   if (fNextFile == obj) {
+      fNextFile = 0;
+      fNextTreeNumber = -1;
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2275,6 +2509,7 @@ void TChain::RemoveFriend(TTree* oldFriend)
 
 void TChain::Reset(Option_t*)
 {
+   ReleaseNextFile();
    delete fFile;
    fFile = 0;
    fNtrees         = 0;
@@ -2297,6 +2532,7 @@ void TChain::Reset(Option_t*)
 
 void TChain::ResetAfterMerge(TFileMergeInfo *info)
 {
+   ReleaseNextFile();
    fNtrees         = 0;
    fTreeNumber     = -1;
    fTree           = 0;
@@ -2389,6 +2625,74 @@ Long64_t TChain::Scan(const char* varexp, const char* selection, Option_t* optio
    return TTree::Scan(varexp, selection, option, nentries, firstentry);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the number of entries of the trees of the chain that are not yet
+/// known, and the tree offset table.
+///
+/// The files are opened only to read the tree headers, without changing the
+/// current tree of the chain. If implicit multi-threading is enabled, they are
+/// opened concurrently in the ROOT thread pool, which makes a big difference for
+/// chains of many files on high latency storage. The files that cannot be
+/// opened, or do not contain the tree, are left to LoadTree, which will report
+/// the problem when reaching them.
+///
+/// Returns the number of trees whose number of entries is still unknown.
+
+Int_t TChain::ScanEntries()
+{
+   if (fProofChain && !(fProofChain->TestBit(kProofLite)))
+      return 0;
+   std::vector<Long64_t> nentries(fNtrees, TTree::kMaxEntries);
+   std::vector<Int_t> toscan;
+   for (Int_t i = 0; i < fNtrees; i++) {
+      TChainElement *element = (TChainElement*) fFiles->UncheckedAt(i);
+      nentries[i] = element->GetEntries();
+      if (nentries[i] == TTree::kMaxEntries)
+         toscan.push_back(i);
+   }
+
+   auto scan = [&](Int_t i) {
+      TChainElement *element = (TChainElement*) fFiles->UncheckedAt(i);
+      std::unique_ptr<TFile> file;
+      {
+         TDirectory::TContext ctxt;
+         file.reset(TFile::Open(element->GetTitle()));
+      }
+      if (!file || file->IsZombie())
+         return;
+      TTree *tree = dynamic_cast<TTree*>(file->Get(element->GetName()));
+      if (tree)
+         nentries[i] = tree->GetEntries();
+   };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && toscan.size() > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(scan, toscan);
+   } else
+#endif
+   {
+      for (auto i : toscan)
+         scan(i);
+   }
+
+   // The offsets are known up to the first tree that could not be scanned.
+   Int_t nunknown = 0;
+   for (Int_t i = 0; i < fNtrees; i++) {
+      if (nentries[i] == TTree::kMaxEntries) {
+         nunknown++;
+      } else {
+         ((TChainElement*) fFiles->UncheckedAt(i))->SetNumberEntries(nentries[i]);
+      }
+      if (nunknown)
+         fTreeOffset[i+1] = TTree::kMaxEntries;
+      else
+         fTreeOffset[i+1] = fTreeOffset[i] + nentries[i];
+   }
+   if (!nunknown)
+      fEntries = fTreeOffset[fNtrees];
+   return nunknown;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the global branch kAutoDelete bit.
 ///
@@ -55,6 +55,10 @@ End_Macro
 - __Subtract__() - if the lists are for the same TTree, removes the entries of the second
                list from the first list. If the lists are for TChains, loops over all
                sub-lists
+- __Intersect__() - keeps only the entries of the first list that are also in the second
+               list. If the lists are for TChains, loops over all sub-lists; entries of
+               trees missing from the second list are removed
+- __EnterRange(start, end)__ - adds all the entries in [start, end)
 - __GetEntry(n)__ - returns the n-th entry number
 - __Next__()      - returns next entry number. Note, that this function is
                 much faster than GetEntry, and it's called when GetEntry() is called
@@ -605,6 +609,44 @@ Bool_t TEntryList::Enter(Long64_t entry, TTree *tree)
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add the entries [start, end) to the current list.
+/// The blocks are filled word by word and stored in their most compact
+/// representation, typically a single run for a fully covered block.
+/// Returns the number of entries that were not already in the list.
+
+Long64_t TEntryList::EnterRange(Long64_t start, Long64_t end)
+{
+   if (start < 0) start = 0;
+   if (start >= end) return 0;
+   if (fLists) {
+      if (!fCurrent) fCurrent = (TEntryList*)fLists->First();
+      Long64_t nnew = fCurrent->EnterRange(start, end);
+      fN += nnew;
+      return nnew;
+   }
+   if (!fBlocks) fBlocks = new TObjArray();
+   TEntryListBlock *block = 0;
+   Long64_t lastblock = (end-1)/kBlockSize;
+   for (Int_t i=fNBlocks; i<=lastblock; i++){
+      block = new TEntryListBlock();
+      fBlocks->Add(block);
+   }
+   if (lastblock >= fNBlocks) fNBlocks = lastblock+1;
+   Long64_t nnew = 0;
+   for (Long64_t i=start/kBlockSize; i<=lastblock; i++){
+      block = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+      Long64_t first = TMath::Max(start - i*kBlockSize, (Long64_t)0);
+      Long64_t last = TMath::Min(end - i*kBlockSize, (Long64_t)kBlockSize);
+      nnew += block->EnterRange(first, last);
+      block->OptimizeStorage();
+   }
+   fN += nnew;
+   fLastIndexQueried = -1;
+   fLastIndexReturned = 0;
+   return nnew;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Remove entry \#entry from the list
 /// - When tree = 0, removes from the current list
@@ -1229,13 +1271,20 @@ void TEntryList::Subtract(const TEntryList *elist)
          //second list is also only for 1 tree
          if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
              !strcmp(elist->fFileName.Data(),fFileName.Data())){
-            //same tree
-            Long64_t n2 = elist->GetN();
-            Long64_t entry;
-            for (Int_t i=0; i<n2; i++){
-               entry = (const_cast<TEntryList*>(elist))->GetEntry(i);
-               Remove(entry);
+            //same tree, subtract block by block
+            if (!elist->fBlocks) return;
+            TEntryListBlock *block1 = 0;
+            TEntryListBlock *block2 = 0;
+            Int_t nmin = TMath::Min(fNBlocks, elist->fNBlocks);
+            Long64_t nold;
+            for (Int_t i=0; i<nmin; i++){
+               block1 = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+               block2 = (TEntryListBlock*)elist->fBlocks->UncheckedAt(i);
+               nold = block1->GetNPassed();
+               fN = fN - nold + block1->Subtract(block2);
             }
+            fLastIndexQueried = -1;
+            fLastIndexReturned = 0;
          } else {
             //different trees
             return;
@@ -1270,6 +1319,58 @@ void TEntryList::Subtract(const TEntryList *elist)
    return;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Keep only the entries of this entry list that are also contained in elist.
+/// Entries of trees for which elist has no list are removed.
+
+void TEntryList::Intersect(const TEntryList *elist)
+{
+   if (!fLists){
+      if (!fBlocks) return;
+      //find the list of elist for the same tree as this list
+      const TEntryList *other = 0;
+      if (!elist->fLists){
+         if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
+             !strcmp(elist->fFileName.Data(),fFileName.Data()))
+            other = elist;
+      } else {
+         TIter next1(elist->GetLists());
+         TEntryList *templist = 0;
+         while ((templist = (TEntryList*)next1())){
+            if (!strcmp(templist->fTreeName.Data(),fTreeName.Data()) &&
+                !strcmp(templist->fFileName.Data(),fFileName.Data())){
+               other = templist;
+               break;
+            }
+         }
+      }
+      //intersect block by block, blocks missing in elist are empty
+      TEntryListBlock empty;
+      TEntryListBlock *block1 = 0;
+      const TEntryListBlock *block2 = 0;
+      fN = 0;
+      for (Int_t i=0; i<fNBlocks; i++){
+         block1 = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+         block2 = &empty;
+         if (other && other->fBlocks && i < other->fNBlocks)
+            block2 = (TEntryListBlock*)other->fBlocks->UncheckedAt(i);
+         fN += block1->Intersect(block2);
+      }
+      fLastIndexQueried = -1;
+      fLastIndexReturned = 0;
+   } else {
+      //this list has sublists
+      TIter next2(fLists);
+      TEntryList *templist = 0;
+      Long64_t oldn=0;
+      while ((templist = (TEntryList*)next2())){
+         oldn = templist->GetN();
+         templist->Intersect(elist);
+         fN = fN - oldn + templist->GetN();
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 TEntryList operator||(TEntryList &elist1, TEntryList &elist2)
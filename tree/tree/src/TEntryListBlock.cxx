@@ -14,16 +14,18 @@
 
 Used by TEntryList to store the entry numbers.
 
-There are 2 ways to represent entry numbers in a TEntryListBlock:
+There are 3 ways to represent entry numbers in a TEntryListBlock:
 
  1. as bits, where passing entry numbers are assigned 1, not passing - 0
  2. as a simple array of entry numbers
   - storing the numbers of entries that pass
   - storing the numbers of entries that don't pass
+ 3. as runs of consecutive passing entries, each stored as the pair (first, last)
 
-In both cases, a UShort_t* is used. The second option is better in case
-less than 1/16 or more than 15/16 of entries pass the selection, and the representation can be
-changed by calling OptimizeStorage() function.
+In all cases, a UShort_t* is used. The second option is better in case
+less than 1/16 or more than 15/16 of entries pass the selection, the third one
+when the passing entries come in long runs (e.g. skims of contiguous ranges), and
+OptimizeStorage() picks the most compact representation.
 When the block is being filled, it's always stored as bits, and the OptimizeStorage()
 function is called by TEntryList when it starts filling the next block. If
 Enter() or Remove() is called after OptimizeStorage(), representation is
@@ -41,13 +43,61 @@ End_Macro
  - __GetEntry(n)__ - returns n-th non-zero entry.
  - __Next__()      - return next non-zero entry. In case of representation 1), Next()
                  is faster than GetEntry()
+ - __Intersect__(), __Subtract__() - keep only the entries that are also, resp. not,
+                 in the other block.
+
+Merge(), Intersect() and Subtract() operate on whole words of the bits representation,
+in loops the compiler vectorizes. Contains() is a lookup in representation 1) and a
+binary search in representations 2) and 3).
 */
 
 #include "TEntryListBlock.h"
+#include "TBuffer.h"
 #include "TString.h"
 
+#include <algorithm>
+#include <cstring>
+
 ClassImp(TEntryListBlock);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of bits set in a word of the bits representation.
+
+inline Int_t CountBits(UShort_t word)
+{
+#if defined(__GNUC__)
+   return __builtin_popcount(word);
+#else
+   Int_t n = 0;
+   for (; word; word &= word - 1)
+      n++;
+   return n;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the bits of the entries [first, last) in the bits representation `bits`.
+
+void SetBitRange(UShort_t *bits, Int_t first, Int_t last)
+{
+   while (first < last && (first & 15)) {
+      bits[first >> 4] |= 1 << (first & 15);
+      first++;
+   }
+   while (first + 16 <= last) {
+      bits[first >> 4] = 0xFFFF;
+      first += 16;
+   }
+   while (first < last) {
+      bits[first >> 4] |= 1 << (first & 15);
+      first++;
+   }
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default c-tor
 
@@ -122,7 +172,7 @@ TEntryListBlock &TEntryListBlock::operator=(const TEntryListBlock &eblock)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// If the block has already been optimized and the entries
-/// are stored as a list and not as bits, trying to enter a new entry
+/// are stored as a list or as runs and not as bits, trying to enter a new entry
 /// will make the block switch to bits representation
 
 Bool_t TEntryListBlock::Enter(Int_t entry)
@@ -153,14 +203,13 @@ Bool_t TEntryListBlock::Enter(Int_t entry)
    //change to bits
    UShort_t *bits = new UShort_t[kBlockSize];
    Transform(1, bits);
-   Enter(entry);
-   return 0;
+   return Enter(entry);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Remove entry \#entry
 /// If the block has already been optimized and the entries
-/// are stored as a list and not as bits, trying to remove a new entry
+/// are stored as a list or as runs and not as bits, trying to remove a new entry
 /// will make the block switch to bits representation
 
 Bool_t TEntryListBlock::Remove(Int_t entry)
@@ -206,34 +255,38 @@ Int_t TEntryListBlock::Contains(Int_t entry)
       Bool_t result = (fIndices[i] & (1<<j))!=0;
       return result;
    }
+   if (fType==2){
+      //runs
+      Int_t irun = FindRun(entry);
+      return irun < fN/2 && fIndices[2*irun] <= entry;
+   }
    //list
-   if (entry < fCurrent) fCurrent = 0;
    if (fPassing && fIndices){
-      for (Int_t i = fCurrent; i<fNPassed; i++){
-         if (fIndices[i]==entry){
-            fCurrent = i;
-            return kTRUE;
-         }
-      }
+      return std::binary_search(fIndices, fIndices + fNPassed, (UShort_t)entry);
    } else {
       if (!fIndices || fNPassed==0){
          //all entries pass
          return kTRUE;
       }
-      if (entry > fIndices[fNPassed-1])
-         return kTRUE;
-      for (Int_t i= fCurrent; i<fNPassed; i++){
-         if (fIndices[i]==entry){
-            fCurrent = i;
-            return kFALSE;
-         }
-         if (fIndices[i]>entry){
-            fCurrent = i;
-            return kTRUE;
-         }
-      }
+      return !std::binary_search(fIndices, fIndices + fNPassed, (UShort_t)entry);
    }
-   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enter the entries [first, last) in the block.
+/// Returns the number of entries that were not already in the block.
+
+Int_t TEntryListBlock::EnterRange(Int_t first, Int_t last)
+{
+   if (first < 0) first = 0;
+   if (last > kBlockSize*16) last = kBlockSize*16;
+   if (first >= last) return 0;
+   Int_t nold = GetNPassed();
+   UShort_t *bits = new UShort_t[kBlockSize];
+   ToBits(bits);
+   SetBitRange(bits, first, last);
+   SetBits(bits);
+   return GetNPassed() - nold;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -242,10 +295,12 @@ Int_t TEntryListBlock::Contains(Int_t entry)
 
 Int_t TEntryListBlock::Merge(TEntryListBlock *block)
 {
-   Int_t i, j;
+   Int_t i;
    if (block->GetNPassed() == 0) return GetNPassed();
    if (GetNPassed() == 0){
       //this block is empty
+      if (fIndices)
+         delete [] fIndices;
       fN = block->fN;
       fIndices = new UShort_t[fN];
       for (i=0; i<fN; i++)
@@ -258,104 +313,44 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
       fLastIndexQueried = -1;
       return fNPassed;
    }
-   if (fType==0){
-      //stored as bits
-      if (block->fType == 0){
-         for (i=0; i<kBlockSize*16; i++){
-            if (block->Contains(i))
-               Enter(i);
-         }
-      } else {
-         if (block->fPassing){
-            //the other block stores entries that pass
-            for (i=0; i<block->fNPassed; i++){
-               Enter(block->fIndices[i]);
-            }
-         } else {
-            //the other block stores entries that don't pass
-            if (block->fNPassed==0){
-               for (i=0; i<kBlockSize*16; i++){
-                  Enter(i);
-               }
-            }
-            for (j=0; j<block->fIndices[0]; j++)
-               Enter(j);
-            for (i=0; i<block->fNPassed-1; i++){
-               for (j=block->fIndices[i]+1; j<block->fIndices[i+1]; j++){
-                  Enter(j);
-               }
-            }
-            for (j=block->fIndices[block->fNPassed-1]+1; j<kBlockSize*16; j++)
-               Enter(j);
+   if (fType==1 && block->fType==1 && fPassing && block->fPassing &&
+       GetNPassed() + block->GetNPassed() <= kBlockSize){
+      //both blocks are short lists of passing entries
+      //make a bigger list
+      Int_t en = block->fNPassed;
+      Int_t newsize = fNPassed + en;
+      UShort_t *newlist = new UShort_t[newsize];
+      UShort_t *elst = block->fIndices;
+      Int_t newpos, elpos;
+      newpos = elpos = 0;
+      for (i=0; i<fNPassed; i++) {
+         while (elpos < en && fIndices[i] > elst[elpos]) {
+            newlist[newpos] = elst[elpos];
+            newpos++;
+            elpos++;
          }
+         if (elpos < en && fIndices[i] == elst[elpos]) elpos++;
+         newlist[newpos] = fIndices[i];
+         newpos++;
       }
-   } else {
-      //stored as a list
-      if (GetNPassed() + block->GetNPassed() > kBlockSize){
-         //change to bits
-         UShort_t *bits = new UShort_t[kBlockSize];
-         Transform(1, bits);
-         Merge(block);
-      } else {
-         //this is only possible if fPassing=1 in both blocks
-         if (block->fType==1){
-            //second block stored as a list
-            //make a bigger list
-            Int_t en = block->fNPassed;
-            Int_t newsize = fNPassed + en;
-            UShort_t *newlist = new UShort_t[newsize];
-            UShort_t *elst = block->fIndices;
-            Int_t newpos, elpos;
-            newpos = elpos = 0;
-            for (i=0; i<fNPassed; i++) {
-               while (elpos < en && fIndices[i] > elst[elpos]) {
-                  newlist[newpos] = elst[elpos];
-                  newpos++;
-                  elpos++;
-               }
-               if (fIndices[i] == elst[elpos]) elpos++;
-               newlist[newpos] = fIndices[i];
-               newpos++;
-            }
-            while (elpos < en) {
-               newlist[newpos] = elst[elpos];
-               newpos++;
-               elpos++;
-            }
-            delete [] fIndices;
-            fIndices = newlist;
-            fNPassed = newpos;
-            fN = fNPassed;
-         } else {
-            //second block is stored as bits
-
-            Int_t en = block->fNPassed;
-            Int_t newsize = fNPassed + en;
-            UShort_t *newlist = new UShort_t[newsize];
-            Int_t newpos, current;
-            newpos = current = 0;
-            for (i=0; i<kBlockSize*16; i++){
-               if (!block->Contains(i)) continue;
-               while(current < fNPassed && fIndices[current]<i){
-                  newlist[newpos] = fIndices[current];
-                  current++;
-                  newpos++;
-               }
-               if (fIndices[current]==i) current++;
-               newlist[newpos] = i;
-               newpos++;
-            }
-            while(current<fNPassed){
-               newlist[newpos] = fIndices[current];
-               newpos++;
-               current++;
-            }
-            delete [] fIndices;
-            fIndices = newlist;
-            fNPassed = newpos;
-            fN = fNPassed;
-         }
+      while (elpos < en) {
+         newlist[newpos] = elst[elpos];
+         newpos++;
+         elpos++;
       }
+      delete [] fIndices;
+      fIndices = newlist;
+      fNPassed = newpos;
+      fN = fNPassed;
+   } else {
+      //union of the bits representations, word by word
+      UShort_t *bits = new UShort_t[kBlockSize];
+      ToBits(bits);
+      UShort_t other[kBlockSize];
+      block->ToBits(other);
+      for (i=0; i<kBlockSize; i++)
+         bits[i] |= other[i];
+      SetBits(bits);
    }
    fLastIndexQueried = -1;
    fLastIndexReturned = -1;
@@ -363,6 +358,42 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
    return GetNPassed();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Keep only the entries that are also in the other block
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Intersect(const TEntryListBlock *block)
+{
+   if (GetNPassed() == 0) return 0;
+   UShort_t *bits = new UShort_t[kBlockSize];
+   ToBits(bits);
+   UShort_t other[kBlockSize];
+   block->ToBits(other);
+   for (Int_t i=0; i<kBlockSize; i++)
+      bits[i] &= other[i];
+   SetBits(bits);
+   OptimizeStorage();
+   return GetNPassed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the entries that are in the other block
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Subtract(const TEntryListBlock *block)
+{
+   if (GetNPassed() == 0) return 0;
+   UShort_t *bits = new UShort_t[kBlockSize];
+   ToBits(bits);
+   UShort_t other[kBlockSize];
+   block->ToBits(other);
+   for (Int_t i=0; i<kBlockSize; i++)
+      bits[i] &= ~other[i];
+   SetBits(bits);
+   OptimizeStorage();
+   return GetNPassed();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the number of entries, passing the selection.
 /// In case, when the block stores entries that pass (fPassing=1) returns fNPassed
@@ -399,6 +430,20 @@ Int_t TEntryListBlock::GetEntry(Int_t entry)
          fLastIndexReturned = i*16+j;
          return fLastIndexReturned;
       }
+      if (fType==2){
+         //runs
+         Int_t nleft = entry;
+         for (i=0; i<fN/2; i++){
+            Int_t len = fIndices[2*i+1] - fIndices[2*i] + 1;
+            if (nleft < len){
+               fLastIndexQueried = entry;
+               fLastIndexReturned = fIndices[2*i] + nleft;
+               return fLastIndexReturned;
+            }
+            nleft -= len;
+         }
+         return -1;
+      }
       if (fType==1){
          if (fPassing){
             fLastIndexQueried = entry;
@@ -470,6 +515,15 @@ Int_t TEntryListBlock::Next()
       return fLastIndexReturned;
 
    }
+   if (fType==2) {
+      //runs
+      fLastIndexReturned++;
+      Int_t irun = FindRun(fLastIndexReturned);
+      if (fIndices[2*irun] > fLastIndexReturned)
+         fLastIndexReturned = fIndices[2*irun];
+      fLastIndexQueried++;
+      return fLastIndexReturned;
+   }
    if (fType==1) {
       fLastIndexQueried++;
       if (fPassing){
@@ -514,6 +568,11 @@ void TEntryListBlock::PrintWithShift(Int_t shift) const
          if (result)
             printf("%d\n", i+shift);
       }
+   } else if (fType==2){
+      for (i=0; i<fN/2; i++){
+         for (Int_t j=fIndices[2*i]; j<=fIndices[2*i+1]; j++)
+            printf("%d\n", j+shift);
+      }
    } else {
       if (fPassing){
          for (i=0; i<fNPassed; i++){
@@ -541,10 +600,51 @@ void TEntryListBlock::PrintWithShift(Int_t shift) const
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// If there are < kBlockSize or >kBlockSize*15 entries, change to an array
-/// representation
+/// If the passing entries form few enough runs, change to a runs representation.
+/// Otherwise, if there are < kBlockSize or >kBlockSize*15 entries, change to
+/// an array representation
 
 void TEntryListBlock::OptimizeStorage()
+{
+   if (fType!=0) return;
+   //count the runs: a run starts at each bit set whose predecessor is not set
+   Int_t nruns = 0;
+   UShort_t carry = 0;
+   for (Int_t i=0; i<kBlockSize; i++){
+      UShort_t prev = (UShort_t)((fIndices[i] << 1) | carry);
+      nruns += CountBits(fIndices[i] & ~prev);
+      carry = fIndices[i] >> 15;
+   }
+   Int_t nlist = fNPassed > kBlockSize*15 ? kBlockSize*16 - fNPassed : fNPassed;
+   if (nruns > 0 && 2*nruns < nlist && 2*nruns < kBlockSize){
+      UShort_t *runs = new UShort_t[2*nruns];
+      Int_t irun = 0;
+      Int_t i = 0;
+      while (i < kBlockSize*16){
+         if ((fIndices[i>>4] & (1<<(i&15))) == 0){
+            i += ((i&15)==0 && fIndices[i>>4]==0) ? 16 : 1;
+            continue;
+         }
+         runs[2*irun] = i;
+         while (i < kBlockSize*16 && (fIndices[i>>4] & (1<<(i&15))) != 0)
+            i += ((i&15)==0 && fIndices[i>>4]==0xFFFF) ? 16 : 1;
+         runs[2*irun+1] = i-1;
+         irun++;
+      }
+      delete [] fIndices;
+      fIndices = runs;
+      fN = 2*nruns;
+      fType = 2;
+      return;
+   }
+   OptimizeBits();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// If there are < kBlockSize or >kBlockSize*15 entries, change from the bits
+/// representation to an array representation
+
+void TEntryListBlock::OptimizeBits()
 {
    if (fType!=0) return;
    if (fNPassed > kBlockSize*15)
@@ -592,29 +692,98 @@ void TEntryListBlock::Transform(Bool_t dir, UShort_t *indexnew)
       return;
    }
 
-   if (fPassing){
-      for (i=0; i<kBlockSize; i++)
-         indexnew[i] = 0;
+   ToBits(indexnew);
+   SetBits(indexnew);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill `bits` (kBlockSize words) with the bits representation of this block,
+/// whatever the current representation
+
+void TEntryListBlock::ToBits(UShort_t *bits) const
+{
+   Int_t i, ibite, ibit;
+   if (!fIndices){
+      //empty block: nothing passes, unless it lists the entries that don't pass
+      std::fill(bits, bits + kBlockSize, fPassing ? 0 : 0xFFFF);
+      return;
+   }
+   if (fType==0){
+      std::memcpy(bits, fIndices, kBlockSize*sizeof(UShort_t));
+   } else if (fType==2){
+      std::fill(bits, bits + kBlockSize, 0);
+      for (i=0; i<fN/2; i++)
+         SetBitRange(bits, fIndices[2*i], fIndices[2*i+1]+1);
+   } else if (fPassing){
+      std::fill(bits, bits + kBlockSize, 0);
       for (i=0; i<fNPassed; i++){
          ibite = fIndices[i]>>4;
          ibit = fIndices[i] & 15;
-         indexnew[ibite] |= 1<<ibit;
+         bits[ibite] |= 1<<ibit;
       }
    } else {
-      for (i=0; i<kBlockSize; i++)
-         indexnew[i] = 65535;
+      std::fill(bits, bits + kBlockSize, 0xFFFF);
       for (i=0; i<fNPassed; i++){
          ibite = fIndices[i]>>4;
          ibit = fIndices[i] & 15;
-         indexnew[ibite] ^= 1<<ibit;
+         bits[ibite] ^= 1<<ibit;
       }
-      fNPassed = kBlockSize*16-fNPassed;
    }
-   if (fIndices)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Adopt `bits` (kBlockSize words) as the bits representation of this block
+
+void TEntryListBlock::SetBits(UShort_t *bits)
+{
+   if (fIndices && fIndices != bits)
       delete [] fIndices;
-   fIndices = indexnew;
+   fIndices = bits;
+   fNPassed = 0;
+   for (Int_t i=0; i<kBlockSize; i++)
+      fNPassed += CountBits(bits[i]);
    fType = 0;
    fN = kBlockSize;
    fPassing = 1;
-   return;
+   fCurrent = 0;
+   fLastIndexQueried = -1;
+   fLastIndexReturned = -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// In the runs representation, return the index of the first run ending at or
+/// after `entry` (fN/2 if there is none)
+
+Int_t TEntryListBlock::FindRun(Int_t entry) const
+{
+   Int_t lo = 0;
+   Int_t hi = fN/2;
+   while (lo < hi){
+      Int_t mid = (lo + hi)/2;
+      if (fIndices[2*mid+1] < entry)
+         lo = mid + 1;
+      else
+         hi = mid;
+   }
+   return lo;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Custom streamer for class TEntryListBlock: the runs representation is not
+/// written, such a block is written in the bits or array representation.
+
+void TEntryListBlock::Streamer(TBuffer &b)
+{
+   if (b.IsReading()) {
+      b.ReadClassBuffer(TEntryListBlock::Class(), this);
+   } else if (fType==2) {
+      TEntryListBlock written(*this);
+      UShort_t *bits = new UShort_t[kBlockSize];
+      written.ToBits(bits);
+      written.SetBits(bits);
+      written.OptimizeBits();
+      b.WriteClassBuffer(TEntryListBlock::Class(), &written);
+   } else {
+      b.WriteClassBuffer(TEntryListBlock::Class(), this);
+   }
 }
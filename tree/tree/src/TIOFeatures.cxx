@@ -42,6 +42,13 @@ using namespace ROOT;
  * ttree_ref.SetIOFeatures(features);
  * ~~~
  *
+ * The available features are:
+ *  - `kGenerateOffsetMap`: do not store the offsets of the entries of the baskets
+ *    when they can be computed while reading.
+ *  - `kLittleEndian`: store the baskets of the branches of fixed-size numbers
+ *    in little-endian order, so that the bulk API can use them without conversion
+ *    on little-endian hosts.
+ *
  * The method `TTree::SetIOFeatures` creates a copy of the feature set; subsequent changes
  * to the `TIOFeatures` object do not propogate to the `TTree`.
  */
@@ -0,0 +1,51 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TPerfStatsTaskScope
+#define ROOT_TPerfStatsTaskScope
+
+#include "TTimeStamp.h"
+#include "TTree.h"
+#include "TVirtualPerfStats.h"
+
+namespace ROOT {
+namespace Internal {
+
+/// Report the time spent in a scope to the perf stats of a tree, if any, as
+/// a task of the timeline of the current thread (see TVirtualPerfStats::TaskEvent).
+/// The name must outlive the scope.
+class TPerfStatsTaskScope {
+   TVirtualPerfStats *fPerfStats;
+   TObject *fTree;
+   const char *fName;
+   Double_t fStart = 0;
+
+public:
+   TPerfStatsTaskScope(TTree *tree, const char *name)
+      : fPerfStats(tree ? tree->GetPerfStats() : nullptr), fTree(tree), fName(name)
+   {
+      if (R__unlikely(fPerfStats))
+         fStart = TTimeStamp();
+   }
+
+   ~TPerfStatsTaskScope()
+   {
+      if (R__unlikely(fPerfStats))
+         fPerfStats->TaskEvent(fTree, fName, fStart);
+   }
+
+   TPerfStatsTaskScope(const TPerfStatsTaskScope &) = delete;
+   TPerfStatsTaskScope &operator=(const TPerfStatsTaskScope &) = delete;
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
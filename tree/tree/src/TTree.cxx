@@ -413,8 +413,10 @@ End_Macro
 #include "ROOT/StringConv.hxx"
 #include "TVirtualMutex.h"
 
+#include "TBasketWritePipeline.h"
 #include "TBranchIMTHelper.h"
 #include "TNotifyLink.h"
+#include "TPerfStatsTaskScope.h"
 
 #include <chrono>
 #include <cstddef>
@@ -911,6 +913,12 @@ TTree::~TTree()
 #endif
    }
 
+   if (fWritePipeline) {
+      FinishAsyncBaskets(kTRUE);
+      delete fWritePipeline;
+      fWritePipeline = nullptr;
+   }
+
    if (fDirectory) {
       // We are in a directory, which may possibly be a file.
       if (fDirectory->GetList()) {
@@ -4445,7 +4453,8 @@ Int_t TTree::Fill()
 #ifndef R__USE_IMT
       nwrite = branch->FillImpl(nullptr);
 #else
-      nwrite = branch->FillImpl(useIMT ? &imtHelper : nullptr);
+      // In the asynchronous write mode, the full baskets go to fWritePipeline instead.
+      nwrite = branch->FillImpl(useIMT && !fWritePipeline ? &imtHelper : nullptr);
 #endif
       if (nwrite < 0) {
          if (nerror < 2) {
@@ -4949,7 +4958,7 @@ Int_t TTree::FlushBasketsImpl() const
 {
    if (!fDirectory) return 0;
    Int_t nbytes = 0;
-   Int_t nerror = 0;
+   Int_t nerror = fWritePipeline ? FinishAsyncBaskets(kTRUE) : 0;
    TObjArray *lb = const_cast<TTree*>(this)->GetListOfBranches();
    Int_t nb = lb->GetEntriesFast();
 
@@ -5001,7 +5010,7 @@ Int_t TTree::FlushBasketsImpl() const
       const_cast<TTree*>(this)->AddTotBytes(fIMTTotBytes);
       const_cast<TTree*>(this)->AddZipBytes(fIMTZipBytes);
 
-      return nerrpar ? -1 : nbpar.load();
+      return (nerrpar || nerror) ? -1 : nbpar.load();
    }
 #endif
    for (Int_t j = 0; j < nb; j++) {
@@ -5425,6 +5434,10 @@ Int_t TTree::GetEntry(Long64_t entry, Int_t getall)
    Int_t nbytes = 0;
    fReadEntry = entry;
 
+   // Baskets still being written in the background cannot be read back yet.
+   if (R__unlikely(fWritePipeline))
+      FinishAsyncBaskets(kTRUE);
+
    // create cache if wanted
    if (fCacheDoAutoInit)
       SetCacheSizeAux();
@@ -5483,7 +5496,10 @@ Int_t TTree::GetEntry(Long64_t entry, Int_t getall)
             std::chrono::time_point<std::chrono::system_clock> start, end;
 
             start = std::chrono::system_clock::now();
-            nbtask = branch->GetEntry(entry, getall);
+            {
+               ROOT::Internal::TPerfStatsTaskScope perfScope(this, branch->GetName());
+               nbtask = branch->GetEntry(entry, getall);
+            }
             end = std::chrono::system_clock::now();
 
             Long64_t tasktime = (Long64_t)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
@@ -7702,6 +7718,9 @@ void TTree::RemoveFriend(TTree* oldFriend)
 
 void TTree::Reset(Option_t* option)
 {
+   if (fWritePipeline)
+      FinishAsyncBaskets(kTRUE);
+
    fNotify        = 0;
    fEntries       = 0;
    fNClusterRange = 0;
@@ -7733,6 +7752,9 @@ void TTree::Reset(Option_t* option)
 
 void TTree::ResetAfterMerge(TFileMergeInfo *info)
 {
+   if (fWritePipeline)
+      FinishAsyncBaskets(kTRUE);
+
    fEntries       = 0;
    fNClusterRange = 0;
    fTotBytes      = 0;
@@ -7855,6 +7877,98 @@ Bool_t TTree::SetAlias(const char* aliasName, const char* aliasFormula)
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Let Process deactivate the branches that the selector does not read.
+///
+/// Selectors written for TTree::MakeClass or TTree::MakeSelector often only
+/// read some of the branches they set up, with TBranch::GetEntry, but the
+/// tree cache has no way to know it and prefetches the baskets of all the
+/// active branches.  With this mode, Process watches which branches are read
+/// during the first `nentries` entries, then deactivates all the other ones
+/// (as SetBranchStatus would) so that they are neither read nor prefetched.
+/// A deactivated branch which is read after all, e.g. for a rare kind of
+/// entry, is reactivated on the spot: the results of the selector do not
+/// depend on this mode.  The branches are reactivated at the end of Process.
+///
+/// A selector calling TTree::GetEntry reads all the active branches: it gains
+/// nothing from this mode.  `nentries = 0` disables the mode; a negative value
+/// takes the number of entries from the resource `TTree.AutoBranchActivation`,
+/// which is 0 by default.
+
+void TTree::SetAutoBranchActivation(Long64_t nentries /* = 100 */)
+{
+   fAutoBranchActivation = nentries;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of entries after which Process deactivates the branches
+/// not read, or 0 if it never does (see SetAutoBranchActivation).
+
+Long64_t TTree::GetAutoBranchActivation() const
+{
+   if (fAutoBranchActivation < 0)
+      return gEnv->GetValue("TTree.AutoBranchActivation", 0);
+   return fAutoBranchActivation;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enable the asynchronous write mode of Fill.
+///
+/// When a basket is full, Fill normally compresses it and writes it to the
+/// file before returning (in parallel across branches if implicit
+/// multi-threading is enabled). In the asynchronous mode the full basket is
+/// handed to a pipeline which compresses and writes it in the ROOT thread
+/// pool, while Fill continues with a fresh basket, reused from an earlier
+/// write when possible. At most `depth` baskets are in flight: when the limit
+/// is reached Fill waits for them. The pipeline is drained by FlushBaskets
+/// (hence by AutoFlush, AutoSave and Write), by GetEntry and by Reset.
+///
+/// The compression overlaps with the filling only if implicit multi-threading
+/// is enabled (see ROOT::EnableImplicitMT()); otherwise the baskets are written
+/// synchronously as usual. Calling this function with `depth <= 0` waits for
+/// the pending baskets and restores the synchronous mode.
+///
+/// Note that the number of compressed bytes (GetZipBytes) only accounts for the
+/// baskets whose write is over: when fAutoFlush is a number of bytes, the first
+/// flush may thus happen slightly later than in the synchronous mode.
+
+void TTree::SetAsyncFlush(Int_t depth /* = 16 */)
+{
+   if (fWritePipeline) {
+      FinishAsyncBaskets(kTRUE);
+      delete fWritePipeline;
+      fWritePipeline = nullptr;
+   }
+   if (depth > 0)
+      fWritePipeline = new ROOT::Internal::TBasketWritePipeline(depth);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the maximum number of baskets compressed and written in the
+/// background by Fill, or 0 if the asynchronous write mode is off (see
+/// SetAsyncFlush).
+
+Int_t TTree::GetAsyncFlush() const
+{
+   return fWritePipeline ? fWritePipeline->GetDepth() : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record the baskets whose background write (see SetAsyncFlush) is over in
+/// their branch. If wait is true, first wait for all the pending writes.
+/// Returns the number of failed writes.
+
+Int_t TTree::FinishAsyncBaskets(Bool_t wait) const
+{
+   Int_t nerror = 0;
+   fWritePipeline->Finish(wait, [&nerror](ROOT::Internal::TBasketWritePipeline::Item &item) {
+      if (item.fNout < 0)
+         ++nerror;
+      item.fBranch->FinishWriteBasket(item.fBasket, item.fWhere, item.fNout);
+   });
+   return nerror;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This function may be called at the start of a program to change
 /// the default value for fAutoFlush.
@@ -8568,6 +8682,38 @@ void TTree::SetCircular(Long64_t maxEntries)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Train the compression dictionaries of the branches matching bname on the
+/// first nbaskets baskets each of them writes, see
+/// TBranch::SetCompressionDictionaryTraining.  bname is interpreted as a
+/// wildcarded TRegexp (see TRegexp::MakeWildcard), e.g. "*" for all branches.
+///
+/// Dictionaries are only used with the ZSTD compression algorithm: they mostly
+/// help branches with small baskets, e.g. in trees with many branches.
+/// ~~~ {.cpp}
+///     tree->SetCompressionDictionaryTraining("*", 10);
+/// ~~~
+
+void TTree::SetCompressionDictionaryTraining(const char *bname, Int_t nbaskets, Int_t maxsize)
+{
+   Int_t nleaves = fLeaves.GetEntriesFast();
+   TRegexp re(bname, kTRUE);
+   Int_t nb = 0;
+   for (Int_t i = 0; i < nleaves; i++)  {
+      TLeaf* leaf = (TLeaf*) fLeaves.UncheckedAt(i);
+      TBranch* branch = (TBranch*) leaf->GetBranch();
+      TString s = branch->GetName();
+      if (strcmp(bname, branch->GetName()) && (s.Index(re) == kNPOS)) {
+         continue;
+      }
+      nb++;
+      branch->SetCompressionDictionaryTraining(nbaskets, maxsize);
+   }
+   if (!nb) {
+      Error("SetCompressionDictionaryTraining", "unknown branch -> '%s'", bname);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the debug level and the debug range.
 ///
@@ -9249,6 +9395,10 @@ void TTree::Streamer(TBuffer& b)
       b.CheckByteCount(R__s, R__c, TTree::IsA());
       //====end of old versions
    } else {
+      // The location of the baskets still being written in the background is not known yet.
+      if (fWritePipeline) {
+         FinishAsyncBaskets(kTRUE);
+      }
       if (fBranchRef) {
          fBranchRef->Clear();
       }
@@ -292,6 +292,7 @@ myTreeOrChain.GetTree()->PrintCacheStats();
 #include "TFile.h"
 #include "TMath.h"
 #include "TBranchCacheInfo.h"
+#include "TPerfStatsTaskScope.h"
 #include "TVirtualPerfStats.h"
 #include <limits.h>
 
@@ -1226,6 +1227,8 @@ Bool_t TTreeCache::FillBuffer()
    if (entry == -1)
       entry = 0;
 
+   ROOT::Internal::TPerfStatsTaskScope perfScope(fTree, "TTreeCache::FillBuffer");
+
    Bool_t resetBranchInfo = kFALSE;
    if (entry < fCurrentClusterStart || fNextClusterStart <= entry) {
       // We are moving on to another set of clusters.
@@ -16,6 +16,14 @@
 
 A TTreeCache which exploits parallelized decompression of its own content.
 
+When implicit multi-threading is enabled, the baskets of the cache are unzipped
+ahead of time by tasks running in the ROOT thread pool, in the order of the
+entries they contain: the baskets needed first are unzipped first. The memory
+held by the unzipped baskets which were not used yet is bounded by
+SetUnzipBufferSize(); when the limit is reached the tasks stop and are resumed
+once the baskets have been consumed. The number of baskets unzipped ahead,
+wasted and waited for is reported by Print() and by TTreePerfStats.
+
 */
 
 #include "TTreeCacheUnzip.h"
@@ -26,15 +34,21 @@ A TTreeCache which exploits parallelized decompression of its own content.
 #include "TFile.h"
 #include "TMath.h"
 #include "TMutex.h"
+#include "TPerfStatsTaskScope.h"
 #include "ROOT/RMakeUnique.hxx"
 
 #ifdef R__USE_IMT
-#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
 #include "ROOT/TTaskGroup.hxx"
 #endif
 
-extern "C" void R__unzip(Int_t *nin, UChar_t *bufin, Int_t *lout, char *bufout, Int_t *nout);
+#include <algorithm>
+#include <numeric>
+
+extern "C" void R__unzipDict(Int_t *nin, UChar_t *bufin, Int_t *lout, UChar_t *bufout, Int_t *nout,
+                             const char *dict, Int_t dictsize);
 extern "C" int R__unzip_header(Int_t *nin, UChar_t *bufin, Int_t *lout);
+extern "C" unsigned int R__unzip_dictionary_id(UChar_t *src, Int_t srcsize);
 
 TTreeCacheUnzip::EParUnzipMode TTreeCacheUnzip::fgParallel = TTreeCacheUnzip::kDisable;
 
@@ -112,6 +126,14 @@ void TTreeCacheUnzip::UnzipState::Reset(Int_t oldSize, Int_t newSize) {
    fUnzipStatus = aUnzipStatus;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Give the basket back to the pool of baskets to be unzipped, e.g. because the
+/// task which picked it ran out of byte budget.
+
+void TTreeCacheUnzip::UnzipState::SetUntouched(Int_t index) {
+   fUnzipStatus[index].store((Byte_t)kUntouched);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set cache as finished. 
 /// There are three scenarios that a basket is set as finished:
@@ -161,10 +183,16 @@ TTreeCacheUnzip::TTreeCacheUnzip() : TTreeCache(),
    fNseekMax(0),
    fUnzipGroupSize(0),
    fUnzipBufferSize(0),
+   fUnzipBytes(0),
+   fUnzipBytesPeak(0),
+   fUnzipNext(0),
+   fUnzipParked(kFALSE),
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
-   fNUnzip(0)
+   fNUnzip(0),
+   fNWasted(0),
+   fNNoDictionary(0)
 {
    // Default Constructor.
    Init();
@@ -180,10 +208,16 @@ TTreeCacheUnzip::TTreeCacheUnzip(TTree *tree, Int_t buffersize) : TTreeCache(tre
    fNseekMax(0),
    fUnzipGroupSize(0),
    fUnzipBufferSize(0),
+   fUnzipBytes(0),
+   fUnzipBytesPeak(0),
+   fUnzipNext(0),
+   fUnzipParked(kFALSE),
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
-   fNUnzip(0)
+   fNUnzip(0),
+   fNWasted(0),
+   fNNoDictionary(0)
 {
    Init();
 }
@@ -232,6 +266,9 @@ void TTreeCacheUnzip::Init()
 
 TTreeCacheUnzip::~TTreeCacheUnzip()
 {
+#ifdef R__USE_IMT
+   WaitUnzipTasks();
+#endif
    ResetCache();
    fUnzipState.Clear(fNseekMax);
 }
@@ -267,6 +304,11 @@ Bool_t TTreeCacheUnzip::FillBuffer()
 
    if (fNbranches <= 0) return kFALSE;
 
+#ifdef R__USE_IMT
+   // The cache is about to be refilled: the tasks must be done with its content.
+   WaitUnzipTasks();
+#endif
+
    // Fill the cache buffer with the branches in the cache.
    fIsTransferred = kFALSE;
 
@@ -305,6 +347,8 @@ Bool_t TTreeCacheUnzip::FillBuffer()
 
    //clear cache buffer
    TFileCacheRead::Prefetch(0,0);
+   fSeekEntry.clear();
+   fSeekBranch.clear();
 
    //store baskets
    for (Int_t i = 0; i < fNbranches; i++) {
@@ -336,6 +380,8 @@ Bool_t TTreeCacheUnzip::FillBuffer()
          fNReadPref++;
 
          TFileCacheRead::Prefetch(pos, len);
+         fSeekEntry.push_back(entries[j]);
+         fSeekBranch.push_back(b);
       }
       if (gDebug > 0) printf("Entry: %lld, registering baskets branch %s, fEntryNext=%lld, fNseek=%d, fNtot=%d\n", entry, ((TBranch*)fBranches->UncheckedAt(i))->GetName(), fEntryNext, fNseek, fNtot);
    }
@@ -344,6 +390,15 @@ Bool_t TTreeCacheUnzip::FillBuffer()
    ResetCache();
    fIsLearning = kFALSE;
 
+   // The baskets are unzipped in the order the entries will be read, whatever
+   // branch they belong to: the ones closest to the current entry come first.
+   fUnzipOrder.resize(fNseek);
+   std::iota(fUnzipOrder.begin(), fUnzipOrder.end(), 0);
+   if ((Int_t)fSeekEntry.size() == fNseek) {
+      std::stable_sort(fUnzipOrder.begin(), fUnzipOrder.end(),
+                       [this](Int_t a, Int_t b) { return fSeekEntry[a] < fSeekEntry[b]; });
+   }
+
    return kTRUE;
 }
 
@@ -389,6 +444,11 @@ void TTreeCacheUnzip::StopLearningPhase()
 
 void TTreeCacheUnzip::UpdateBranches(TTree *tree)
 {
+#ifdef R__USE_IMT
+   // The tasks may be using the branches of the previous tree.
+   WaitUnzipTasks();
+#endif
+   fSeekBranch.clear();
    TTreeCache::UpdateBranches(tree);
 }
 
@@ -500,7 +560,14 @@ void TTreeCacheUnzip::ResetCache()
 {
    // Reset all the lists and wipe all the chunks
    fCycle++;
+   for (Int_t i = 0; i < fNseekMax; ++i) {
+      if (fUnzipState.IsUnzipped(i))
+         fNWasted++;
+   }
    fUnzipState.Clear(fNseekMax);
+   fUnzipBytes = 0;
+   fUnzipNext = 0;
+   fUnzipParked = kFALSE;
 
    if(fNseekMax < fNseek){
       if (gDebug > 0)
@@ -512,6 +579,26 @@ void TTreeCacheUnzip::ResetCache()
    fEmpty = kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Account for the consumption of the unzipped basket at index: its bytes no
+/// longer count against fUnzipBufferSize.
+
+void TTreeCacheUnzip::ReleaseUnzipped(Int_t index)
+{
+   fUnzipBytes -= fUnzipState.fUnzipLen[index];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the branch of the basket registered at index by FillBuffer, nullptr
+/// if it is not known.
+
+TBranch *TTreeCacheUnzip::GetSeekBranch(Int_t index) const
+{
+   if (index < 0 || index >= (Int_t)fSeekBranch.size() || (Int_t)fSeekBranch.size() != fNseek)
+      return nullptr;
+   return fSeekBranch[index];
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This inflates a basket in the cache.. passing the data to a new
 /// buffer that will only wait there to be read...
@@ -522,6 +609,19 @@ void TTreeCacheUnzip::ResetCache()
 /// and fUnzipLen are ready before main thread fetch the data.
 
 Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
+{
+   std::vector<char> scratch;
+   return UnzipCache(index, scratch);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Same as UnzipCache(Int_t), using scratch as buffer for the compressed basket
+/// so that it can be reused from one basket to the next.
+/// Returns 0 on success, 1 if the basket has been left to the main thread,
+/// -1 on read error and 2 if the byte budget fUnzipBufferSize is exhausted: the
+/// basket is then left untouched to be unzipped later.
+
+Int_t TTreeCacheUnzip::UnzipCache(Int_t index, std::vector<char> &scratch)
 {
    Int_t myCycle;
    const Int_t hlen = 128;
@@ -547,21 +647,21 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
       return 1;
    }
 
-   // Prepare a memory buffer of adequate size
-   char* locbuff = 0;
-   if (rdlen > 16384) {
-      locbuff = new char[rdlen];
-   } else if (rdlen * 3 < 16384) {
-      locbuff = new char[rdlen * 2];
-   } else {
-      locbuff = new char[16384];
+   // Do not even read the basket if there is no room left for it
+   if (fUnzipBytes >= fUnzipBufferSize) {
+      fUnzipState.SetUntouched(index);
+      return 2;
    }
 
+   // Prepare a memory buffer of adequate size
+   if ((Int_t)scratch.size() < rdlen)
+      scratch.resize(rdlen);
+   char *locbuff = scratch.data();
+
    readbuf = ReadBufferExt(locbuff, rdoffs, rdlen, loc);
 
    if (readbuf <= 0) {
       fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-      if (locbuff) delete [] locbuff;
       return -1;
    }
 
@@ -577,78 +677,100 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
                    Info("UnzipCache", "Block %d is too big, skipping.", index);
 
            fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-           if (locbuff) delete [] locbuff;
            return 0;
    }
 
+   // Reserve the room for the unzipped basket. A basket is always accepted if
+   // nothing else is held, so that a single large basket cannot stall the tasks.
+   Long64_t held = fUnzipBytes.fetch_add(len);
+   if (held > 0 && held + len > fUnzipBufferSize) {
+      fUnzipBytes -= len;
+      fUnzipState.SetUntouched(index);
+      return 2;
+   }
+   Long64_t peak = fUnzipBytesPeak;
+   while (held + len > peak && !fUnzipBytesPeak.compare_exchange_weak(peak, held + len)) {}
+
    // Unzip it into a new blk
    char *ptr = 0;
-   Int_t loclen = UnzipBuffer(&ptr, locbuff);
+   Int_t loclen = UnzipBuffer(&ptr, locbuff, GetSeekBranch(index));
    if ((loclen > 0) && (loclen == objlen + keylen)) {
       if ((myCycle != fCycle) || !fIsTransferred) {
+         fUnzipBytes -= len;
          fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-         if (locbuff) delete [] locbuff;
+         delete [] ptr;
          return 1;
       }
+      fUnzipBytes += loclen - len;
       fUnzipState.SetUnzipped(index, ptr, loclen); // Set it as done
       fNUnzip++;
    } else {
+      fUnzipBytes -= len;
       fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
+      delete [] ptr;
    }
 
-   if (locbuff) delete [] locbuff;
    return 0;
 }
 
 #ifdef R__USE_IMT
 ////////////////////////////////////////////////////////////////////////////////
-/// We create a TTaskGroup and asynchronously maps each group of baskets(> 100 kB in total)
-/// to a task. In TTaskGroup, we use TThreadExecutor to do the actually work of unzipping 
-/// a group of basket. The purpose of creating TTaskGroup is to avoid competing with main thread.
+/// Start the tasks unzipping the baskets of the cache ahead of their use.
+/// The tasks run in the ROOT thread pool: there is one per fUnzipGroupSize bytes of
+/// compressed baskets, but never more than the threads of the pool, so that the
+/// unzipping does not crowd out the other tasks (e.g. the ones of TTreeProcessorMT).
+/// Each task picks the next basket in the order of the entries (see fUnzipOrder)
+/// until none is left or until fUnzipBufferSize bytes are held by unzipped baskets
+/// which were not consumed yet. In that case the tasks are started again by
+/// GetUnzipBuffer once enough of them have been used.
 
 Int_t TTreeCacheUnzip::CreateTasks()
 {
-   auto mapFunction = [&]() {
-      auto unzipFunction = [&](const std::vector<Int_t> &indices) {
-         // If cache is invalidated and we should return immediately.
-         if (!fIsTransferred) return nullptr;
-
-         for (auto ii : indices) {
-            if(fUnzipState.TryUnzipping(ii)) {
-               Int_t res = UnzipCache(ii);
-               if(res)
-                  if (gDebug > 0)
-                     Info("UnzipCache", "Unzipping failed or cache is in learning state");
-            }
+   auto unzipFunction = [this]() {
+      ROOT::Internal::TPerfStatsTaskScope perfScope(fTree, "TTreeCacheUnzip::UnzipCache");
+      std::vector<char> scratch;
+      const Int_t norder = fUnzipOrder.size();
+      while (fIsTransferred) {
+         const Int_t next = fUnzipNext++;
+         if (next >= norder)
+            break;
+         const Int_t ii = fUnzipOrder[next];
+         if (ii >= fNseek || !fUnzipState.TryUnzipping(ii))
+            continue;
+         Int_t res = UnzipCache(ii, scratch);
+         if (res == 2) {
+            fUnzipParked = kTRUE;
+            break;
          }
-         return nullptr;
-      };
-
-      Int_t accusz = 0;
-      std::vector<std::vector<Int_t>> basketIndices;
-      std::vector<Int_t> indices;
-      if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
-      for (Int_t i = 0; i < fNseek; i++) {
-         while (accusz < fUnzipGroupSize) {
-            accusz += fSeekLen[i];
-            indices.push_back(i);
-            i++;
-            if (i >= fNseek) break;
-         }
-         if (i < fNseek) i--;
-         basketIndices.push_back(indices);
-         indices.clear();
-         accusz = 0;
+         if (res && gDebug > 0)
+            Info("UnzipCache", "Unzipping failed or cache is in learning state");
       }
-      ROOT::TThreadExecutor pool;
-      pool.Foreach(unzipFunction, basketIndices);
    };
 
-   fUnzipTaskGroup.reset(new ROOT::Experimental::TTaskGroup());
-   fUnzipTaskGroup->Run(mapFunction);
+   if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
+   Int_t ntasks = (fNtot + fUnzipGroupSize - 1) / fUnzipGroupSize;
+   ntasks = std::max(1, std::min(ntasks, (Int_t)ROOT::GetImplicitMTPoolSize()));
+
+   fUnzipNext = 0;
+   fUnzipParked = kFALSE;
+   if (!fUnzipTaskGroup)
+      fUnzipTaskGroup.reset(new ROOT::Experimental::TTaskGroup());
+   for (Int_t i = 0; i < ntasks; ++i)
+      fUnzipTaskGroup->Run(unzipFunction);
 
    return 0;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stop the unzipping tasks and wait for the ones which are running.
+
+void TTreeCacheUnzip::WaitUnzipTasks()
+{
+   if (fUnzipTaskGroup) {
+      fUnzipTaskGroup->Cancel();
+      fUnzipTaskGroup.reset();
+   }
+}
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -665,6 +787,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
 {
    Int_t res = 0;
    Int_t loc = -1;
+   TBranch *branch = nullptr;
 
    // We go straight to TTreeCache/TfileCacheRead, in order to get the info we need
    //  pointer to the original zipped chunk
@@ -687,12 +810,19 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
          fNseekMax = fNseek;
       }
 
+#ifdef R__USE_IMT
+      // Resume the tasks stopped by the byte budget once half of it is available again.
+      if (fUnzipParked && fIsTransferred && 2 * fUnzipBytes <= fUnzipBufferSize && ROOT::IsImplicitMTEnabled())
+         CreateTasks();
+#endif
+
       loc = (Int_t)TMath::BinarySearch(fNseek, fSeekSort, pos);
       if ((fCycle == myCycle) && (loc >= 0) && (loc < fNseek) && (pos == fSeekSort[loc])) {
 
          // The buffer is, at minimum, in the file cache. We must know its index in the requests list
          // In order to get its info
          Int_t seekidx = fSeekIndex[loc];
+         branch = GetSeekBranch(seekidx);
 
          do {
 
@@ -700,6 +830,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
             // And also we don't have to alloc the blks. This is supposed to be
             // the main thread of the app.
             if (fUnzipState.IsUnzipped(seekidx)) {
+               ReleaseUnzipped(seekidx);
                if(!(*buf)) {
                   *buf = fUnzipState.fUnzipChunks[seekidx].get();
                   fUnzipState.fUnzipChunks[seekidx].release();
@@ -728,10 +859,8 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                         }
                      }
                   }
-                  if (reqi < 0) {
+                  if (reqi < 0 || UnzipCache(reqi) == 2) {
                      fEmpty = kFALSE;
-                  } else {
-                     UnzipCache(reqi);
                   }
                }
  
@@ -749,6 +878,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
 
          // Here the block is not pending. It could be done or aborted or not yet being processed.
          if ( (seekidx >= 0) && (fUnzipState.IsUnzipped(seekidx)) ) {
+            ReleaseUnzipped(seekidx);
             if(!(*buf)) {
               *buf = fUnzipState.fUnzipChunks[seekidx].get();
                fUnzipState.fUnzipChunks[seekidx].release();
@@ -769,6 +899,10 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
       } else {
          loc = -1;
          fIsTransferred = kFALSE;
+#ifdef R__USE_IMT
+         // The cache is about to be refilled: the tasks must be done with its content.
+         WaitUnzipTasks();
+#endif
       }
    }
 
@@ -788,10 +922,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
    if (!ReadBufferExt(fCompBuffer, pos, len, loc)) {
       // Cache is invalidated and we need to wait for all unzipping tasks to befinished before fill new baskets in cache.
 #ifdef R__USE_IMT
-      if(ROOT::IsImplicitMTEnabled() && fUnzipTaskGroup) {
-         fUnzipTaskGroup->Cancel();
-         fUnzipTaskGroup.reset();
-      }
+      WaitUnzipTasks();
 #endif
       {
          // Fill new baskets into cache.
@@ -809,11 +940,12 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
    if (res) res = -1;
 
    if (!res) {
-      res = UnzipBuffer(buf, fCompBuffer);
+      res = UnzipBuffer(buf, fCompBuffer, branch);
       *free = kTRUE;
    }
 
-   if (!fIsLearning) {
+   // A basket whose dictionary is not known was not missed by the cache.
+   if (!fIsLearning && res != -2) {
       fNMissed++;
    }
    
@@ -839,14 +971,17 @@ void TTreeCacheUnzip::SetUnzipBufferSize(Long64_t bufferSize)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Unzips a ROOT specific buffer... by reading the header at the beginning.
-/// returns the size of the inflated buffer or -1 if error
+/// returns the size of the inflated buffer, -1 if error or -2 if the basket
+/// needs a compression dictionary which is not known (TBasket then unzips it)
 /// Note!! : If *dest == 0 we will allocate the buffer and it will be the
 /// responsability of the caller to free it... it is useful for example
 /// to pass it to the creator of TBuffer
 /// src is the original buffer with the record (header+compressed data)
 /// *dest is the inflated buffer (including the header)
+/// branch is the branch of the basket, whose compression dictionary is used
+/// for the baskets compressed with one.
 
-Int_t TTreeCacheUnzip::UnzipBuffer(char **dest, char *src)
+Int_t TTreeCacheUnzip::UnzipBuffer(char **dest, char *src, TBranch *branch)
 {
    Int_t  uzlen = 0;
    Bool_t alloc = kFALSE;
@@ -856,6 +991,14 @@ Int_t TTreeCacheUnzip::UnzipBuffer(char **dest, char *src)
    Int_t nbytes = 0, objlen = 0, keylen = 0;
    GetRecordHeader(src, hlen, nbytes, objlen, keylen);
 
+   // The dictionary of a basket compressed with one is held by its branch: without it, leave it to TBasket.
+   static const std::vector<char> noDictionary;
+   const std::vector<char> &dict = branch ? branch->GetCompressionDictionary() : noDictionary;
+   if (dict.empty() && objlen > nbytes - keylen && R__unzip_dictionary_id((UChar_t *)(src + keylen), nbytes - keylen)) {
+      fNNoDictionary++;
+      return -2;
+   }
+
    if (!(*dest)) {
       /* early consistency check */
       UChar_t *bufcur = (UChar_t *) (src + keylen);
@@ -907,10 +1050,10 @@ Int_t TTreeCacheUnzip::UnzipBuffer(char **dest, char *src)
             return uzlen;
          }
 
-         R__unzip(&nin, bufcur, &nbuf, objbuf, &nout);
+         R__unzipDict(&nin, bufcur, &nbuf, (UChar_t *)objbuf, &nout, dict.data(), dict.size());
 
          if (gDebug > 2)
-            Info("UnzipBuffer", "R__unzip nin:%d, bufcur:%p, nbuf:%d, objbuf:%p, nout:%d",
+            Info("UnzipBuffer", "R__unzipDict nin:%d, bufcur:%p, nbuf:%d, objbuf:%p, nout:%d",
                  nin, bufcur, nbuf, objbuf, nout);
 
          if (!nout) break;
@@ -944,10 +1087,13 @@ void  TTreeCacheUnzip::Print(Option_t* option) const {
 
    printf("******TreeCacheUnzip statistics for file: %s ******\n",fFile->GetName());
    printf("Max allowed mem for pending buffers: %lld\n", fUnzipBufferSize);
-   printf("Number of blocks unzipped by threads: %d\n", fNUnzip);
+   printf("Max mem used by pending buffers: %lld\n", fUnzipBytesPeak.load());
+   printf("Number of blocks unzipped by threads: %d\n", fNUnzip.load());
    printf("Number of hits: %d\n", fNFound);
    printf("Number of stalls: %d\n", fNStalls);
    printf("Number of misses: %d\n", fNMissed);
+   printf("Number of blocks unzipped but not used: %d\n", fNWasted.load());
+   printf("Number of blocks left to TBasket for lack of dictionary: %d\n", fNNoDictionary.load());
 
    TTreeCache::Print(option);
 }
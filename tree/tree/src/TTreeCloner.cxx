@@ -313,6 +313,18 @@ UInt_t TTreeCloner::CollectBranches(TBranch *from, TBranch *to) {
 
    }
 
+   if (from->GetCompressionDictionary() != to->GetCompressionDictionary()) {
+      // The baskets can only be decompressed with the dictionary of the branch they were written with.
+      fWarningMsg.Form("The export branch and the import branch (%s) do not have the same compression dictionary",
+                       from->GetName());
+      if (! (fOptions & kNoWarnings) ) {
+         Warning("TTreeCloner::CollectBranches", "%s", fWarningMsg.Data());
+      }
+      fIsValid = kFALSE;
+      fNeedConversion = kTRUE;
+      return 0;
+   }
+
    fFromBranches.AddLast(from);
    if (!from->TestBit(TBranch::kDoNotUseBufferMap)) {
       // Make sure that we reset the Buffer's map if needed.
@@ -6,9 +6,11 @@
 #include "TFile.h"
 #include "TTree.h"
 #include "TStopwatch.h"
+#include "TSystem.h"
 #include "TTreeReader.h"
 #include "TTreeReaderValue.h"
 #include "TTreeReaderArray.h"
+#include "ROOT/TTreeReaderArrayFast.hxx"
 #include "ROOT/TTreeReaderFast.hxx"
 #include "ROOT/TTreeReaderValueFast.hxx"
 #include "ROOT/TBulkBranchRead.hxx"
@@ -16,6 +18,8 @@
 
 #include "gtest/gtest.h"
 
+#include <vector>
+
 class BulkApiVariableTest : public ::testing::Test {
 public:
    static constexpr Long64_t fClusterSize = 1e5;
@@ -236,3 +240,147 @@ TEST_F(BulkApiVariableTest, serializedRead)
    printf("Bulk Serialized API: Successful read of all events.\n");
    printf("Bulk Serialized API: Total elapsed time (seconds) for API: %.2f\n", sw.RealTime());
 }
+
+TEST_F(BulkApiVariableTest, offsetsRead)
+{
+   auto hfile = TFile::Open(fFileName.c_str());
+   auto tree = dynamic_cast<TTree*>(hfile->Get("T"));
+   ASSERT_TRUE(tree);
+   auto branchLen = tree->GetBranch("myLen");
+   ASSERT_TRUE(branchLen);
+   auto branchFloat = tree->GetBranch("f");
+   ASSERT_TRUE(branchFloat);
+
+   float idx_f = 0;
+   Long64_t evt_idx = 0;
+   TBufferFile floatBuf(TBuffer::kWrite, 32*1024);
+   TBufferFile lenBuf(TBuffer::kWrite, 32*1024);
+   std::vector<Int_t> floatOffsets, lenOffsets;
+
+   while (evt_idx < fEventCount) {
+      auto count = branchFloat->GetBulkRead().GetBulkEntries(evt_idx, floatBuf, floatOffsets);
+      ASSERT_EQ(count, fClusterSize);
+      ASSERT_EQ(count, branchLen->GetBulkRead().GetBulkEntries(evt_idx, lenBuf, lenOffsets));
+      ASSERT_EQ(static_cast<size_t>(count + 1), floatOffsets.size());
+
+      // Values are already in native byte order
+      auto floats = reinterpret_cast<float*>(floatBuf.GetCurrent());
+      auto lens = reinterpret_cast<int*>(lenBuf.GetCurrent());
+      for (Int_t idx = 0; idx < count; idx++) {
+         ASSERT_EQ(idx, lenOffsets[idx]);
+         ASSERT_EQ((evt_idx + idx + 1) % 10, lens[idx]);
+         ASSERT_EQ(lens[idx], floatOffsets[idx + 1] - floatOffsets[idx]);
+         for (auto i = floatOffsets[idx]; i < floatOffsets[idx + 1]; i++) {
+            ASSERT_EQ(idx_f, floats[i]);
+            idx_f++;
+         }
+      }
+      evt_idx += count;
+   }
+   ASSERT_EQ(evt_idx, fEventCount);
+}
+
+TEST_F(BulkApiVariableTest, fastReaderArray)
+{
+   auto hfile = TFile::Open(fFileName.c_str());
+   ROOT::Experimental::TTreeReaderFast myReader("T", hfile);
+   ROOT::Experimental::TTreeReaderArrayFast<float> myF(myReader, "f");
+   ROOT::Experimental::TTreeReaderValueFast<Int_t> myLen(myReader, "myLen");
+   myReader.SetEntry(0);
+   ASSERT_EQ(TTreeReader::kEntryValid, myReader.GetEntryStatus());
+
+   float idx_f = 0;
+   Long64_t ev = 0;
+   for (auto entry : myReader) {
+      ASSERT_EQ(ev, entry);
+      ASSERT_EQ((ev + 1) % 10, *myLen);
+      ASSERT_EQ(static_cast<size_t>(*myLen), myF.GetSize());
+      for (auto value : myF) {
+         ASSERT_EQ(idx_f, value);
+         idx_f++;
+      }
+      ev++;
+   }
+   ASSERT_EQ(fEventCount, ev);
+}
+
+static void WriteVectorTree(const char *fileName, Long64_t clusterSize, Long64_t eventCount)
+{
+   TFile f(fileName, "RECREATE");
+   TTree tree("T", "A ROOT tree with a std::vector<double> branch.");
+   tree.SetBit(TTree::kOnlyFlushAtCluster);
+   tree.SetAutoFlush(clusterSize);
+   std::vector<double> v;
+   tree.Branch("v", &v);
+   for (Long64_t ev = 0; ev < eventCount; ev++) {
+      v.resize(ev % 7);
+      for (size_t i = 0; i < v.size(); i++)
+         v[i] = ev + 0.5 * i;
+      tree.Fill();
+   }
+   tree.Write();
+}
+
+TEST(BulkApiVector, offsetsRead)
+{
+   const auto fileName = "BulkApiTestVector.root";
+   const Long64_t clusterSize = 1000;
+   const Long64_t eventCount = 10000;
+   WriteVectorTree(fileName, clusterSize, eventCount);
+
+   TFile f(fileName);
+   auto tree = dynamic_cast<TTree*>(f.Get("T"));
+   ASSERT_TRUE(tree);
+   auto branch = tree->GetBranch("v");
+   ASSERT_TRUE(branch);
+
+   TBufferFile buf(TBuffer::kWrite, 32*1024);
+   std::vector<Int_t> offsets;
+   Long64_t evt_idx = 0;
+   while (evt_idx < eventCount) {
+      auto count = branch->GetBulkRead().GetBulkEntries(evt_idx, buf, offsets);
+      ASSERT_EQ(count, clusterSize);
+      auto values = reinterpret_cast<double*>(buf.GetCurrent());
+      for (Int_t idx = 0; idx < count; idx++) {
+         const auto ev = evt_idx + idx;
+         ASSERT_EQ(ev % 7, offsets[idx + 1] - offsets[idx]);
+         for (auto i = offsets[idx]; i < offsets[idx + 1]; i++)
+            ASSERT_EQ(ev + 0.5 * (i - offsets[idx]), values[i]);
+      }
+      evt_idx += count;
+   }
+   gSystem->Unlink(fileName);
+}
+
+TEST(BulkApiVector, fastReaderBatch)
+{
+   const auto fileName = "BulkApiTestVectorBatch.root";
+   const Long64_t clusterSize = 1000;
+   const Long64_t eventCount = 10000;
+   WriteVectorTree(fileName, clusterSize, eventCount);
+
+   {
+      TFile f(fileName);
+      ROOT::Experimental::TTreeReaderFast reader("T", &f);
+      ROOT::Experimental::TTreeReaderArrayFast<double> v(reader, "v");
+      Long64_t ev = 0;
+      Int_t n;
+      while ((n = reader.NextBatch()) > 0) {
+         ASSERT_EQ(ev, reader.GetBatchFirstEntry());
+         ASSERT_EQ(clusterSize, n);
+         const Int_t *offsets = v.GetBatchOffsets();
+         const double *values = v.GetBatchValues();
+         for (Int_t idx = 0; idx < n; idx++, ev++) {
+            reader.SetBatchIndex(idx);
+            ASSERT_EQ(static_cast<size_t>(ev % 7), v.GetSize());
+            for (size_t i = 0; i < v.GetSize(); i++) {
+               ASSERT_EQ(ev + 0.5 * i, v[i]);
+               ASSERT_EQ(v[i], values[offsets[idx] + i]);
+            }
+         }
+      }
+      ASSERT_EQ(0, n);
+      ASSERT_EQ(eventCount, ev);
+   }
+   gSystem->Unlink(fileName);
+}
@@ -2,9 +2,12 @@
 #include "TROOT.h"
 #include "TSystem.h"
 #include "TTree.h"
+#include "TTreeCacheUnzip.h"
 
 #include "gtest/gtest.h"
 
+#include <vector>
+
 #ifdef R__USE_IMT
 
 // ROOT-9668
@@ -28,4 +31,140 @@ TEST(TTreeImplicitMT, flushBaskets)
    gSystem->Unlink(ofileName);
 }
 
+TEST(TTreeImplicitMT, asyncFlush)
+{
+   ROOT::EnableImplicitMT();
+   const auto ofileName = "asyncFlushMT.root";
+   const int nEntries = 100000;
+   {
+      TFile f(ofileName, "RECREATE");
+      TTree t("t", "t");
+      t.SetAsyncFlush(4);
+      EXPECT_EQ(t.GetAsyncFlush(), 4);
+      double b1 = 0.;
+      int b2 = 0;
+      std::vector<float> b3;
+      t.Branch("branch1", &b1, 1000);
+      t.Branch("branch2", &b2, 1000);
+      t.Branch("branch3", &b3, 1000);
+      for (int i = 0; i < nEntries; ++i) {
+         b1 = i * 0.5;
+         b2 = i;
+         b3.assign(i % 5, i);
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TFile f(ofileName);
+   auto t = f.Get<TTree>("t");
+   ASSERT_EQ(t->GetEntries(), nEntries);
+   double b1 = -1.;
+   int b2 = -1;
+   std::vector<float> *b3 = nullptr;
+   t->SetBranchAddress("branch1", &b1);
+   t->SetBranchAddress("branch2", &b2);
+   t->SetBranchAddress("branch3", &b3);
+   for (int i = 0; i < nEntries; ++i) {
+      t->GetEntry(i);
+      ASSERT_EQ(b1, i * 0.5);
+      ASSERT_EQ(b2, i);
+      ASSERT_EQ(b3->size(), std::size_t(i % 5));
+   }
+   t->ResetBranchAddresses();
+   delete b3;
+   gSystem->Unlink(ofileName);
+}
+
+TEST(TTreeImplicitMT, parallelUnzipBoundedMemory)
+{
+   ROOT::EnableImplicitMT();
+   const auto ofileName = "parallelUnzipMT.root";
+   const int nEntries = 20000;
+   {
+      TFile f(ofileName, "RECREATE");
+      TTree t("t", "t");
+      t.SetAutoFlush(5000);
+      double b1 = 0.;
+      int b2 = 0;
+      t.Branch("branch1", &b1, 3200);
+      t.Branch("branch2", &b2, 3200);
+      for (int i = 0; i < nEntries; ++i) {
+         b1 = i * 0.5;
+         b2 = i;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+   {
+      TFile f(ofileName);
+      auto t = f.Get<TTree>("t");
+      t->SetCacheSize(1000000);
+      auto cache = dynamic_cast<TTreeCacheUnzip *>(f.GetCacheRead(t));
+      ASSERT_NE(cache, nullptr);
+      // Room for a few baskets only: the tasks have to stop and resume while reading.
+      cache->SetUnzipBufferSize(20000);
+
+      double b1 = -1.;
+      int b2 = -1;
+      t->SetBranchAddress("branch1", &b1);
+      t->SetBranchAddress("branch2", &b2);
+      for (int i = 0; i < nEntries; ++i) {
+         t->GetEntry(i);
+         ASSERT_EQ(b1, i * 0.5);
+         ASSERT_EQ(b2, i);
+      }
+      EXPECT_LE(cache->GetNWasted(), cache->GetNUnzip());
+      // The budget may only be exceeded by a single basket (its unzipped bytes and its key).
+      EXPECT_LE(cache->GetUnzipBytesPeak(), 20000 + 3200 + 200);
+   }
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kDisable);
+   gSystem->Unlink(ofileName);
+}
+
+TEST(TTreeImplicitMT, parallelUnzipCompressionDictionary)
+{
+   ROOT::EnableImplicitMT();
+   const auto ofileName = "parallelUnzipDictionaryMT.root";
+   const int nEntries = 20000;
+   {
+      // ZSTD, level 5.
+      TFile f(ofileName, "RECREATE", "", 505);
+      TTree t("t", "t");
+      t.SetAutoFlush(5000);
+      int b1 = 0;
+      t.Branch("branch1", &b1, 3200);
+      t.SetCompressionDictionaryTraining("branch1", 2, 4096);
+      for (int i = 0; i < nEntries; ++i) {
+         b1 = i % 100;
+         t.Fill();
+      }
+      t.Write();
+      ASSERT_FALSE(t.GetBranch("branch1")->GetCompressionDictionary().empty());
+   }
+
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+   {
+      TFile f(ofileName);
+      auto t = f.Get<TTree>("t");
+      t->SetCacheSize(1000000);
+      auto cache = dynamic_cast<TTreeCacheUnzip *>(f.GetCacheRead(t));
+      ASSERT_NE(cache, nullptr);
+
+      int b1 = -1;
+      t->SetBranchAddress("branch1", &b1);
+      for (int i = 0; i < nEntries; ++i) {
+         t->GetEntry(i);
+         ASSERT_EQ(b1, i % 100);
+      }
+      // The baskets compressed with the dictionary are unzipped by the tasks too.
+      EXPECT_GT(cache->GetNUnzip(), 0);
+      EXPECT_EQ(cache->GetNNoDictionary(), 0);
+   }
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kDisable);
+   gSystem->Unlink(ofileName);
+}
+
 #endif // R__USE_IMT
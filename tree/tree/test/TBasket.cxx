@@ -1,7 +1,9 @@
 
+#include "ROOT/TBasketBufferPool.hxx"
 #include "ROOT/TIOFeatures.hxx"
 #include "TBasket.h"
 #include "TBranch.h"
+#include "TBufferFile.h"
 #include "TEnum.h"
 #include "TEnumConstant.h"
 #include "TMemFile.h"
@@ -403,3 +405,209 @@ TEST(TBasket, TestSettingIOBits)
    readEntryOffset = reinterpret_cast<Bool_t *>(reinterpret_cast<char *>(basket2) + offset);
    EXPECT_EQ(*readEntryOffset, kTRUE);
 }
+
+TEST(TBasket, BufferPoolSizeClasses)
+{
+   using Pool = ROOT::Experimental::TBasketBufferPool;
+   EXPECT_EQ(Pool::GetClassSize(0), 1024);
+   for (Int_t size = 1; size < (1 << 24); size = size * 9 / 8 + 1) {
+      const Int_t sizeClass = Pool::GetSizeClass(size);
+      ASSERT_GE(sizeClass, 0);
+      EXPECT_GE(Pool::GetClassSize(sizeClass), size);
+      if (sizeClass > 0)
+         EXPECT_LT(Pool::GetClassSize(sizeClass - 1), size);
+   }
+   EXPECT_EQ(Pool::GetSizeClass(Pool::GetClassSize(Pool::kNumClasses - 1)), Pool::kNumClasses - 1);
+   EXPECT_EQ(Pool::GetSizeClass(Pool::GetClassSize(Pool::kNumClasses - 1) + 1), -1);
+}
+
+TEST(TBasket, BufferPoolReuse)
+{
+   auto &pool = ROOT::Experimental::TBasketBufferPool::GetInstance();
+   const auto maxBytes = pool.GetMaxBytes();
+   pool.SetMaxBytes(16 * 1024 * 1024);
+   pool.ResetStats();
+
+   TBuffer *buffer = pool.Acquire(3000, TBuffer::kRead);
+   EXPECT_GE(buffer->BufferSize(), 3000);
+   buffer->SetBufferOffset(100);
+   pool.Release(buffer);
+   // Same size class and mode: the buffer is reused and reset
+   EXPECT_EQ(pool.Acquire(2900, TBuffer::kRead), buffer);
+   EXPECT_EQ(buffer->Length(), 0);
+   pool.Release(buffer);
+   TBuffer *writeBuffer = pool.Acquire(2900, TBuffer::kWrite);
+   EXPECT_NE(writeBuffer, buffer);
+   EXPECT_TRUE(writeBuffer->IsWriting());
+   pool.Release(writeBuffer);
+
+   // Baskets of a tree read again reuse the buffers of the first reading.
+   TMemFile *f = nullptr;
+   CreateSampleFile(f);
+   for (int i = 0; i < 2; ++i) {
+      TTree *tree = nullptr;
+      f->GetObject("t1", tree);
+      ASSERT_NE(tree, nullptr);
+      EXPECT_GT(tree->GetEntry(0), 0);
+      delete tree;
+   }
+   auto stats = pool.GetStats();
+   EXPECT_GT(stats.fReused, 1u);
+   EXPECT_GT(stats.fPooledBytes, 0);
+
+   // Above the limit, buffers are freed
+   pool.SetMaxBytes(4096);
+   EXPECT_EQ(pool.GetStats().fPooledBytes, 0);
+   pool.Release(pool.Acquire(8192, TBuffer::kRead));
+   EXPECT_EQ(pool.GetStats().fPooledBytes, 0);
+   EXPECT_EQ(pool.GetStats().fDiscarded, stats.fDiscarded + 1);
+
+   pool.SetMaxBytes(maxBytes);
+   delete f;
+}
+
+TEST(TBasket, LittleEndian)
+{
+   TMemFile *f = new TMemFile("tbasket_test.root", "CREATE");
+   ASSERT_FALSE(f->IsZombie());
+
+   TTree t1("t1", "Tree with little-endian baskets.");
+   ROOT::TIOFeatures settings;
+   settings.Set(ROOT::Experimental::EIOFeatures::kLittleEndian);
+   t1.SetIOFeatures(settings);
+   Int_t idx, elem;
+   Double_t x;
+   Float_t triple[3];
+   Int_t sample[10];
+   t1.Branch("idx", &idx, "idx/I");
+   t1.Branch("x", &x, "x/D");
+   t1.Branch("triple", triple, "triple[3]/F");
+   t1.Branch("elem", &elem, "elem/I");
+   t1.Branch("sample", sample, "sample[elem]/I");
+   for (idx = 0; idx < gSampleEvents; idx++) {
+      x = idx + 0.5;
+      for (Int_t i = 0; i < 3; i++)
+         triple[i] = idx * 3 + i;
+      elem = idx % 9;
+      for (Int_t i = 0; i < 10; i++)
+         sample[i] = idx + i;
+      t1.Fill();
+   }
+   t1.Write();
+   f->Close();
+   std::vector<char> memBuffer(f->GetSize());
+   f->CopyTo(&memBuffer[0], memBuffer.size());
+   delete f;
+
+   TMemFile f2("tbasket_test.root", &memBuffer[0], memBuffer.size(), "READ");
+   TTree *saved_t1 = nullptr;
+   f2.GetObject("t1", saved_t1);
+   ASSERT_NE(saved_t1, nullptr);
+
+   // Only the branches of fixed-size numbers are stored in little-endian order.
+   for (auto name : {"idx", "x", "triple"}) {
+      TBasket *basket = saved_t1->GetBranch(name)->GetBasket(0);
+      ASSERT_NE(basket, nullptr);
+      EXPECT_TRUE(basket->IsLittleEndian()) << name;
+      EXPECT_EQ(basket->GetKeylen() % 8, 0) << name;
+   }
+   EXPECT_FALSE(saved_t1->GetBranch("sample")->GetBasket(0)->IsLittleEndian());
+
+   Double_t saved_x;
+   Float_t saved_triple[3];
+   Int_t saved_idx, saved_elem;
+   Int_t saved_sample[10];
+   saved_t1->SetBranchAddress("idx", &saved_idx);
+   saved_t1->SetBranchAddress("x", &saved_x);
+   saved_t1->SetBranchAddress("triple", saved_triple);
+   saved_t1->SetBranchAddress("elem", &saved_elem);
+   saved_t1->SetBranchAddress("sample", saved_sample);
+   for (idx = 0; idx < saved_t1->GetEntries(); idx++) {
+      saved_t1->GetEntry(idx);
+      EXPECT_EQ(idx, saved_idx);
+      EXPECT_EQ(idx + 0.5, saved_x);
+      for (Int_t i = 0; i < 3; i++)
+         EXPECT_EQ(idx * 3 + i, saved_triple[i]);
+      EXPECT_EQ(idx % 9, saved_elem);
+      for (Int_t i = 0; i < saved_elem; i++)
+         EXPECT_EQ(idx + i, saved_sample[i]);
+   }
+
+   // The bulk API gives the values in native order, with or without conversion.
+   TTree *bulk_t1 = nullptr;
+   f2.GetObject("t1", bulk_t1);
+   ASSERT_NE(bulk_t1, nullptr);
+   TBufferFile xBuf(TBuffer::kWrite, 1024);
+   TBufferFile tripleBuf(TBuffer::kWrite, 1024);
+   std::vector<Int_t> offsets;
+   Long64_t evt_idx = 0;
+   while (evt_idx < bulk_t1->GetEntries()) {
+      auto count = bulk_t1->GetBranch("x")->GetBulkRead().GetBulkEntries(evt_idx, xBuf);
+      ASSERT_GT(count, 0);
+      ASSERT_EQ(count, bulk_t1->GetBranch("triple")->GetBulkRead().GetBulkEntries(evt_idx, tripleBuf, offsets));
+      auto xs = reinterpret_cast<Double_t *>(xBuf.GetCurrent());
+      auto triples = reinterpret_cast<Float_t *>(tripleBuf.GetCurrent());
+      for (Int_t i = 0; i < count; i++) {
+         EXPECT_EQ(evt_idx + i + 0.5, xs[i]);
+         EXPECT_EQ(3, offsets[i + 1] - offsets[i]);
+         for (auto j = offsets[i]; j < offsets[i + 1]; j++)
+            EXPECT_EQ(3 * evt_idx + j, triples[j]);
+      }
+      evt_idx += count;
+   }
+}
+
+TEST(TBasket, CompressionDictionary)
+{
+   const char *words[] = {"electron", "muon", "photon", "pion", "kaon", "proton", "neutron", "jet"};
+   const Int_t nEvents = 10000;
+   auto makeLabel = [&](Int_t idx, char *label) {
+      UInt_t r = (idx * 2654435761u) >> 7;
+      snprintf(label, 64, "%s_%s_%d", words[r % 8], words[(r >> 3) % 8], (r >> 6) % 100);
+   };
+
+   // ZSTD, level 5.
+   TMemFile *f = new TMemFile("tbasket_test.root", "CREATE", "", 505);
+   ASSERT_FALSE(f->IsZombie());
+
+   // Small baskets of text: the compression has little to learn from in each one of them.
+   char label[64];
+   TTree plain("plain", "Tree compressed without dictionary.");
+   plain.Branch("label", label, "label/C", 2000);
+   TTree trained("trained", "Tree compressed with a trained dictionary.");
+   trained.Branch("label", label, "label/C", 2000);
+   trained.SetCompressionDictionaryTraining("label", 10, 4096);
+   for (Int_t idx = 0; idx < nEvents; idx++) {
+      makeLabel(idx, label);
+      plain.Fill();
+      trained.Fill();
+   }
+   plain.Write();
+   trained.Write();
+
+   EXPECT_TRUE(plain.GetBranch("label")->GetCompressionDictionary().empty());
+   EXPECT_FALSE(trained.GetBranch("label")->GetCompressionDictionary().empty());
+   EXPECT_LE(trained.GetBranch("label")->GetCompressionDictionary().size(), 4096u);
+   EXPECT_LT(trained.GetZipBytes(), plain.GetZipBytes());
+
+   f->Close();
+   std::vector<char> memBuffer(f->GetSize());
+   f->CopyTo(&memBuffer[0], memBuffer.size());
+   delete f;
+
+   // The dictionary is read back with the branch.
+   TMemFile f2("tbasket_test.root", &memBuffer[0], memBuffer.size(), "READ");
+   TTree *saved = nullptr;
+   f2.GetObject("trained", saved);
+   ASSERT_NE(saved, nullptr);
+   EXPECT_FALSE(saved->GetBranch("label")->GetCompressionDictionary().empty());
+
+   char saved_label[64];
+   saved->SetBranchAddress("label", saved_label);
+   ASSERT_EQ(saved->GetEntries(), nEvents);
+   for (Int_t idx = 0; idx < nEvents; idx++) {
+      saved->GetEntry(idx);
+      makeLabel(idx, label);
+      EXPECT_STREQ(label, saved_label);
+   }
+}
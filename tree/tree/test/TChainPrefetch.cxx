@@ -0,0 +1,46 @@
+#include "TFile.h"
+#include "TTree.h"
+#include "TChain.h"
+#include "TSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+// Chain of several files, each with more than one cluster, read with the next-file prefetching enabled.
+TEST(TChainPrefetch, ReadAllEntries)
+{
+   const int nFiles = 4;
+   const int nEntries = 1000;
+
+   for (int f = 0; f < nFiles; ++f) {
+      const std::string fname = "chainprefetch" + std::to_string(f) + ".root";
+      TFile file(fname.c_str(), "RECREATE");
+      TTree tree("t", "t");
+      tree.SetAutoFlush(100);
+      int x = 0;
+      tree.Branch("x", &x);
+      for (int i = 0; i < nEntries; ++i) {
+         x = f * nEntries + i;
+         tree.Fill();
+      }
+      file.Write();
+   }
+
+   TChain chain("t");
+   chain.Add("chainprefetch*.root");
+   chain.SetPrefetchNextFile();
+   chain.SetCacheSize(10000000);
+
+   int x = -1;
+   chain.SetBranchAddress("x", &x);
+   const Long64_t n = chain.GetEntries();
+   EXPECT_EQ(n, nFiles * nEntries);
+   for (Long64_t i = 0; i < n; ++i) {
+      ASSERT_GT(chain.GetEntry(i), 0);
+      EXPECT_EQ(x, i);
+   }
+
+   for (int f = 0; f < nFiles; ++f)
+      gSystem->Unlink(("chainprefetch" + std::to_string(f) + ".root").c_str());
+}
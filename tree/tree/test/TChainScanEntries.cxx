@@ -0,0 +1,92 @@
+#include "TChain.h"
+#include "TChainElement.h"
+#include "TFile.h"
+#include "TFileCollection.h"
+#include "THashList.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+
+class TChainScanEntries : public ::testing::Test {
+protected:
+   static const int kNFiles = 6;
+
+   static std::string FileName(int f) { return "chainscanentries" + std::to_string(f) + ".root"; }
+   static Long64_t NEntries(int f) { return 100 * (f + 1); }
+
+   static void SetUpTestCase()
+   {
+      for (int f = 0; f < kNFiles; ++f) {
+         TFile file(FileName(f).c_str(), "RECREATE");
+         TTree tree("t", "t");
+         int x = 0;
+         tree.Branch("x", &x);
+         for (Long64_t i = 0; i < NEntries(f); ++i)
+            tree.Fill();
+         file.Write();
+      }
+#ifdef R__USE_IMT
+      ROOT::EnableImplicitMT(4);
+#endif
+   }
+
+   static void TearDownTestCase()
+   {
+#ifdef R__USE_IMT
+      ROOT::DisableImplicitMT();
+#endif
+      for (int f = 0; f < kNFiles; ++f)
+         gSystem->Unlink(FileName(f).c_str());
+   }
+};
+
+TEST_F(TChainScanEntries, OffsetsAndEntries)
+{
+   TChain chain("t");
+   for (int f = 0; f < kNFiles; ++f)
+      chain.Add(FileName(f).c_str());
+   EXPECT_EQ(chain.ScanEntries(), 0);
+   EXPECT_EQ(chain.GetTreeNumber(), -1); // no tree was loaded
+
+   Long64_t offset = 0;
+   for (int f = 0; f < kNFiles; ++f) {
+      EXPECT_EQ(chain.GetTreeOffset()[f], offset);
+      EXPECT_EQ(static_cast<TChainElement *>(chain.GetListOfFiles()->At(f))->GetEntries(), NEntries(f));
+      offset += NEntries(f);
+   }
+   EXPECT_EQ(chain.GetEntries(), offset);
+   EXPECT_EQ(chain.LoadTree(offset - 1), NEntries(kNFiles - 1) - 1);
+   EXPECT_EQ(chain.GetTreeNumber(), kNFiles - 1);
+}
+
+TEST_F(TChainScanEntries, MissingFile)
+{
+   TChain chain("t");
+   chain.Add(FileName(0).c_str());
+   chain.Add("chainscanentries_missing.root");
+   chain.Add(FileName(1).c_str());
+   EXPECT_EQ(chain.ScanEntries(), 1);
+   EXPECT_EQ(chain.GetTreeOffset()[1], NEntries(0));
+   EXPECT_EQ(chain.GetTreeOffset()[2], TTree::kMaxEntries);
+   EXPECT_EQ(static_cast<TChainElement *>(chain.GetListOfFiles()->At(2))->GetEntries(), NEntries(1));
+}
+
+TEST_F(TChainScanEntries, FileCollection)
+{
+   TChain chain("t");
+   for (int f = 0; f < kNFiles; ++f)
+      chain.Add(FileName(f).c_str());
+   std::unique_ptr<TFileCollection> collection(chain.MakeFileCollection("files"));
+   ASSERT_EQ(collection->GetNFiles(), kNFiles);
+
+   // The entries are taken from the collection: no file needs to be opened.
+   TChain chain2("t");
+   chain2.AddFileInfoList(collection->GetList());
+   EXPECT_EQ(chain2.GetEntriesFast(), chain.GetEntries());
+   EXPECT_EQ(chain2.GetTreeOffset()[kNFiles - 1], chain.GetTreeOffset()[kNFiles - 1]);
+}
@@ -0,0 +1,173 @@
+#include "TEntryList.h"
+#include "TEntryListBlock.h"
+#include "TFile.h"
+#include "TSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+static const Long64_t kNEntries = 5 * TEntryList::kBlockSize + 123;
+
+static std::set<Long64_t> RandomEntries(unsigned seed, double fraction)
+{
+   std::mt19937 gen(seed);
+   std::bernoulli_distribution pass(fraction);
+   std::set<Long64_t> entries;
+   for (Long64_t i = 0; i < kNEntries; ++i)
+      if (pass(gen))
+         entries.insert(i);
+   return entries;
+}
+
+static void Fill(TEntryList &elist, const std::set<Long64_t> &entries)
+{
+   for (auto e : entries)
+      elist.Enter(e);
+   elist.OptimizeStorage();
+}
+
+static void ExpectSame(TEntryList &elist, const std::set<Long64_t> &expected)
+{
+   ASSERT_EQ(elist.GetN(), (Long64_t)expected.size());
+   Int_t i = 0;
+   for (auto e : expected) {
+      ASSERT_EQ(elist.GetEntry(i), e) << "at index " << i;
+      ++i;
+   }
+   for (Long64_t e = 0; e < kNEntries; e += 37)
+      ASSERT_EQ(elist.Contains(e) != 0, expected.count(e) != 0) << "for entry " << e;
+}
+
+TEST(TEntryList, EnterRangeUsesRuns)
+{
+   TEntryList elist("e", "e", "t", "f.root");
+   EXPECT_EQ(elist.EnterRange(100, 3 * TEntryList::kBlockSize + 7), 3 * TEntryList::kBlockSize + 7 - 100);
+   std::set<Long64_t> expected;
+   for (Long64_t i = 100; i < 3 * TEntryList::kBlockSize + 7; ++i)
+      expected.insert(i);
+   ExpectSame(elist, expected);
+   EXPECT_FALSE(elist.Contains(99));
+   EXPECT_TRUE(elist.Contains(TEntryList::kBlockSize));
+   EXPECT_FALSE(elist.Contains(3 * TEntryList::kBlockSize + 7));
+
+   // Entering in a block stored as runs switches it back to bits
+   EXPECT_TRUE(elist.Enter(50));
+   expected.insert(50);
+   ExpectSame(elist, expected);
+}
+
+TEST(TEntryList, SetAlgebra)
+{
+   for (double fraction : {0.01, 0.5, 0.99}) {
+      const auto a = RandomEntries(1, fraction);
+      const auto b = RandomEntries(2, 0.3);
+      std::set<Long64_t> expected;
+
+      TEntryList unionList("u", "u", "t", "f.root");
+      Fill(unionList, a);
+      TEntryList other("o", "o", "t", "f.root");
+      Fill(other, b);
+      unionList.Add(&other);
+      std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::inserter(expected, expected.end()));
+      ExpectSame(unionList, expected);
+
+      expected.clear();
+      TEntryList interList("i", "i", "t", "f.root");
+      Fill(interList, a);
+      interList.Intersect(&other);
+      std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::inserter(expected, expected.end()));
+      ExpectSame(interList, expected);
+
+      expected.clear();
+      TEntryList diffList("d", "d", "t", "f.root");
+      Fill(diffList, a);
+      diffList.Subtract(&other);
+      std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::inserter(expected, expected.end()));
+      ExpectSame(diffList, expected);
+
+      // Lists for other trees do not intersect
+      TEntryList otherTree("x", "x", "t2", "f.root");
+      Fill(otherTree, b);
+      TEntryList emptyInter("ei", "ei", "t", "f.root");
+      Fill(emptyInter, a);
+      emptyInter.Intersect(&otherTree);
+      EXPECT_EQ(emptyInter.GetN(), 0);
+   }
+}
+
+TEST(TEntryList, IntersectRange)
+{
+   const auto a = RandomEntries(3, 0.2);
+   TEntryList global("g", "g", "t", "f.root");
+   Fill(global, a);
+
+   const Long64_t start = TEntryList::kBlockSize / 2;
+   const Long64_t end = 2 * TEntryList::kBlockSize + 11;
+   TEntryList range("r", "r", "t", "f.root");
+   range.EnterRange(start, end);
+   range.Intersect(&global);
+   std::set<Long64_t> expected(a.lower_bound(start), a.lower_bound(end));
+   ExpectSame(range, expected);
+}
+
+TEST(TEntryList, WriteRead)
+{
+   const auto filename = "TEntryList_writeread.root";
+   auto a = RandomEntries(4, 0.1);
+   {
+      TFile f(filename, "RECREATE");
+      TEntryList elist("elist", "elist", "t", "f.root");
+      Fill(elist, a);
+      // a long run, stored as a single (first, last) pair
+      elist.EnterRange(TEntryList::kBlockSize, 3 * TEntryList::kBlockSize);
+      for (Long64_t i = TEntryList::kBlockSize; i < 3 * TEntryList::kBlockSize; ++i)
+         a.insert(i);
+      elist.Write();
+   }
+   {
+      TFile f(filename);
+      auto elist = f.Get<TEntryList>("elist");
+      ASSERT_NE(elist, nullptr);
+      ExpectSame(*elist, a);
+   }
+   gSystem->Unlink(filename);
+}
+
+TEST(TEntryList, WriteReadRunsBlock)
+{
+   const auto filename = "TEntryList_writereadruns.root";
+   const Int_t blockEntries = TEntryListBlock::kBlockSize * 16;
+   // One run per block: written as bits, as a list of the passing entries, resp. of the failing ones
+   const std::vector<std::pair<Int_t, Int_t>> ranges{{100, 50000}, {10, 20}, {5, blockEntries}};
+   {
+      TFile f(filename, "RECREATE");
+      for (std::size_t i = 0; i < ranges.size(); ++i) {
+         TEntryListBlock block;
+         block.EnterRange(ranges[i].first, ranges[i].second);
+         block.OptimizeStorage();
+         ASSERT_EQ(block.GetType(), 2);
+         block.Write(("block" + std::to_string(i)).c_str());
+         // The block written was a copy: this one keeps its runs
+         EXPECT_EQ(block.GetType(), 2);
+      }
+   }
+   {
+      TFile f(filename);
+      for (std::size_t i = 0; i < ranges.size(); ++i) {
+         auto block = f.Get<TEntryListBlock>(("block" + std::to_string(i)).c_str());
+         ASSERT_NE(block, nullptr);
+         EXPECT_EQ(block->GetType(), i == 0 ? 0 : 1);
+         EXPECT_EQ(block->GetNPassed(), ranges[i].second - ranges[i].first);
+         for (Int_t e = 0; e < blockEntries; e += 7)
+            ASSERT_EQ(block->Contains(e) != 0, ranges[i].first <= e && e < ranges[i].second) << "for entry " << e;
+      }
+   }
+   gSystem->Unlink(filename);
+}
@@ -88,6 +88,9 @@ private:
    /// User-defined selection of entry numbers to be processed, empty if none was provided
    const TEntryList fEntryList; // const to be sure to avoid race conditions among TTreeViews
    const Internal::FriendInfo fFriendInfo;
+   bool fHasEntriesRange = false;             ///< Whether SetEntriesRange has been called
+   Long64_t fBeginEntry = 0ll;                ///< First global entry to be processed
+   Long64_t fEndEntry = TTree::kMaxEntries;   ///< One past the last global entry to be processed
 
    ROOT::TThreadedObject<ROOT::Internal::TTreeView> fTreeView; ///<! Thread-local TreeViews
 
@@ -101,6 +104,7 @@ public:
    TTreeProcessorMT(TTree &tree, const TEntryList &entries);
    TTreeProcessorMT(TTree &tree);
 
+   void SetEntriesRange(Long64_t begin, Long64_t end);
    void Process(std::function<void(TTreeReader &)> func);
    static void SetMaxTasksPerFilePerWorker(unsigned int m);
    static unsigned int GetMaxTasksPerFilePerWorker();
@@ -0,0 +1,101 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeReaderArrayFast
+#define ROOT_TTreeReaderArrayFast
+
+
+////////////////////////////////////////////////////////////////////////////
+//                                                                        //
+// TTreeReaderArrayFast                                                   //
+//                                                                        //
+// Bulk access to the arrays of values of a branch: variable-size arrays  //
+// (`x[n]`), fixed-size arrays, and std::vector of fundamental types.     //
+//                                                                        //
+////////////////////////////////////////////////////////////////////////////
+
+#include "ROOT/TTreeReaderValueFast.hxx"
+
+#include "TDataType.h"
+
+#include <type_traits>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+
+/// Read the values of an array branch through the bulk API.
+///
+/// All the entries of a basket are read in one go, by
+/// TBulkBranchRead::GetBulkEntries: the values are stored contiguously, in
+/// native byte order, and the values of each entry are delimited by an array
+/// of offsets.  GetSize() and At() give access to the values of the current
+/// entry of the TTreeReaderFast; GetBatchValues() and GetBatchOffsets() to
+/// those of all the entries of the current batch (see
+/// TTreeReaderFast::NextBatch()).
+template <typename T>
+class TTreeReaderArrayFast final : public ROOT::Experimental::Internal::TTreeReaderValueFastBase {
+   static_assert(std::is_arithmetic<T>::value, "TTreeReaderArrayFast only supports fundamental types");
+
+   public:
+      TTreeReaderArrayFast(TTreeReaderFast &tr, const std::string &branchname) :
+            TTreeReaderValueFastBase(&tr, branchname) {}
+
+      /// Number of values of the current entry.
+      std::size_t GetSize() const { return fOffsets[fEntryShift + fEvtIndex + 1] - fOffsets[fEntryShift + fEvtIndex]; }
+      Bool_t IsEmpty() const { return !GetSize(); }
+
+      T &At(std::size_t idx) { return begin()[idx]; }
+      T &operator[](std::size_t idx) { return At(idx); }
+
+      T *begin() { return GetBatchValues() + fOffsets[fEntryShift + fEvtIndex]; }
+      T *end() { return GetBatchValues() + fOffsets[fEntryShift + fEvtIndex + 1]; }
+
+      /// Values of all the entries in the buffer.
+      T *GetBatchValues() { return reinterpret_cast<T *>(fBuffer.GetCurrent()); }
+
+      /// Offsets of the values of the entries of the current batch: the values
+      /// of the i-th entry are those between GetBatchValues()[offsets[i]] and
+      /// GetBatchValues()[offsets[i+1]].
+      const Int_t *GetBatchOffsets() const { return fOffsets.data() + fEntryShift; }
+
+      virtual const char *GetTypeName() override { return BranchTypeName(); }
+
+   protected:
+      virtual Int_t GetEvents(Long64_t eventNum) override {
+         if (fEventBase >= 0 && eventNum >= fEventBase && eventNum < fEventBase + fEntries) {
+            fEntryShift = eventNum - fEventBase;
+         } else {
+            fEntries = fBranch->GetBulkRead().GetBulkEntries(eventNum, fBuffer, fOffsets);
+            if (R__unlikely(fEntries < 0)) {
+               fEntries = 0;
+               fEventBase = -1;
+               fReadStatus = ROOT::Internal::TTreeReaderValueBase::kReadError;
+               return -1;
+            }
+            fEventBase = eventNum;
+            fEntryShift = 0;
+         }
+         fReadStatus = ROOT::Internal::TTreeReaderValueBase::kReadSuccess;
+         return fEntries - fEntryShift;
+      }
+
+      virtual const char *BranchTypeName() override { return TDataType::GetTypeName(TDataType::GetType(typeid(T))); }
+      virtual UInt_t GetElementSize() override { return sizeof(T); }
+
+      std::vector<Int_t> fOffsets;  // Offsets of the values of each entry in the buffer.
+      Int_t              fEntries{0};    // Number of entries in the buffer; the first one is fEventBase.
+      Int_t              fEntryShift{0}; // Index in the buffer of the first entry of the current batch.
+};
+
+}  // Experimental
+}  // ROOT
+
+#endif // ROOT_TTreeReaderArrayFast
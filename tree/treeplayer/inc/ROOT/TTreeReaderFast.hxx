@@ -134,6 +134,17 @@ public:
 
    TTreeReader::EEntryStatus SetEntry(Long64_t);
 
+   Int_t NextBatch();
+
+   /// Entry number of the first entry of the current batch.
+   Long64_t GetBatchFirstEntry() const { return fBaseEvent; }
+
+   /// Number of entries of the current batch.
+   Int_t GetBatchSize() const { return fBatchSize; }
+
+   /// Make the value readers point to the given entry of the current batch.
+   void SetBatchIndex(Int_t idx) { fEvtIndex = idx; }
+
    /// Return an iterator to the 0th TTree entry.
    Iterator_t begin() {
       return Iterator_t(*this, 0);
@@ -161,6 +172,7 @@ private:
 
    Int_t    fEvtIndex{-1};
    Long64_t fBaseEvent{-1};
+   Int_t    fBatchSize{0};
    Long64_t fLastEntry{-1};
 
    friend class ROOT::Experimental::Internal::TTreeReaderValueFastBase;
@@ -56,7 +56,7 @@ class TTreeReaderValueFastBase {
          if (fTreeReader) fTreeReader->RegisterValueReader(this);
       }
 
-      Int_t GetEvents(Long64_t eventNum) {
+      virtual Int_t GetEvents(Long64_t eventNum) {
           //printf("Getting events starting at %lld.  Current remaining is %d events with base %lld.\n", eventNum, fRemaining, fEventBase);
           if (fEventBase >= 0 && (fRemaining + fEventBase > eventNum)) {
              Int_t adjust = (eventNum - fEventBase);
@@ -87,10 +87,10 @@ class TTreeReaderValueFastBase {
       // Adjust the current buffer offset forward N events.
       virtual Int_t Adjust(Int_t eventCount) {
          Int_t bufOffset = fBuffer.Length();
-         fBuffer.SetBufferOffset(bufOffset + eventCount*GetSize());
+         fBuffer.SetBufferOffset(bufOffset + eventCount*GetElementSize());
          return 0;
       }
-      virtual UInt_t GetSize() = 0;
+      virtual UInt_t GetElementSize() = 0;
 
       void MarkTreeReaderUnavailable() {
          fTreeReader = nullptr;
@@ -142,7 +142,7 @@ class TTreeReaderValueFast final : public ROOT::Experimental::Internal::TTreeRea
       T* Deserialize(char *) {return nullptr;}
 
       virtual const char *GetTypeName() override {return "{INCOMPLETE}";}
-      virtual UInt_t GetSize() override {return sizeof(T);}
+      virtual UInt_t GetElementSize() override {return sizeof(T);}
 };
 
 template<>
@@ -162,7 +162,7 @@ class TTreeReaderValueFast<float> final : public ROOT::Experimental::Internal::T
    protected:
       virtual const char *GetTypeName() override {return "float";}
       virtual const char *BranchTypeName() override {return "float";}
-      virtual UInt_t GetSize() override {return sizeof(float);}
+      virtual UInt_t GetElementSize() override {return sizeof(float);}
       float * Deserialize(char *input) {frombuf(input, &fTmp); return &fTmp;}
 
       float fTmp;
@@ -187,7 +187,7 @@ class TTreeReaderValueFast<double> final : public ROOT::Experimental::Internal::
    protected:
       virtual const char *GetTypeName() override {return "double";}
       virtual const char *BranchTypeName() override {return "double";}
-      virtual UInt_t GetSize() override {return sizeof(double);}
+      virtual UInt_t GetElementSize() override {return sizeof(double);}
       double* Deserialize(char *input) {frombuf(input, &fTmp); return &fTmp;}
 
       double fTmp;
@@ -210,7 +210,7 @@ class TTreeReaderValueFast<Int_t> final : public ROOT::Experimental::Internal::T
    protected:
       virtual const char *GetTypeName() override {return "integer";}
       virtual const char *BranchTypeName() override {return "integer";}
-      virtual UInt_t GetSize() override {return sizeof(Int_t);}
+      virtual UInt_t GetElementSize() override {return sizeof(Int_t);}
       Int_t* Deserialize(char *input) {frombuf(input, &fTmp); return &fTmp;}
 
       Int_t fTmp;
@@ -233,7 +233,7 @@ class TTreeReaderValueFast<UInt_t> final : public ROOT::Experimental::Internal::
    protected:
       virtual const char *GetTypeName() override {return "unsigned integer";}
       virtual const char *BranchTypeName() override {return "unsigned integer";}
-      virtual UInt_t GetSize() override {return sizeof(UInt_t);}
+      virtual UInt_t GetElementSize() override {return sizeof(UInt_t);}
       UInt_t* Deserialize(char *input) {frombuf(input, &fTmp); return &fTmp;}
 
       UInt_t fTmp;
@@ -256,7 +256,7 @@ class TTreeReaderValueFast<Bool_t> final : public ROOT::Experimental::Internal::
    protected:
       virtual const char *GetTypeName() override {return "unsigned integer";}
       virtual const char *BranchTypeName() override {return "unsigned integer";}
-      virtual UInt_t GetSize() override {return sizeof(Bool_t);}
+      virtual UInt_t GetElementSize() override {return sizeof(Bool_t);}
       Bool_t* Deserialize(char *input) {frombuf(input, &fTmp); return &fTmp;}
 
       Bool_t fTmp;
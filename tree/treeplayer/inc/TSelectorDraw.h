@@ -23,6 +23,7 @@
 
 #include "TSelector.h"
 
+class TCollection;
 class TTreeFormula;
 class TTreeFormulaManager;
 class TH1;
@@ -65,6 +66,7 @@ protected:
    virtual void      ClearFormula();
    virtual Bool_t    CompileVariables(const char *varexp="", const char *selection="");
    virtual void      InitArrays(Int_t newsize);
+   virtual void      JitCompileFormulas();
 
 private:
    TSelectorDraw(const TSelectorDraw&);             // not implemented
@@ -75,6 +77,8 @@ public:
    virtual ~TSelectorDraw();
 
    virtual void      Begin(TTree *tree);
+   virtual Bool_t    CanProcessMT() const;
+   virtual void      FlushBuffer();
    virtual Int_t     GetAction() const {return fAction;}
    virtual Bool_t    GetCleanElist() const {return fCleanElist;}
    virtual Int_t     GetDimension() const {return fDimension;}
@@ -105,6 +109,8 @@ public:
    // See TSelectorDraw::GetVal
    virtual Double_t *GetV4() const   {return GetVal(3);}
    virtual Double_t *GetW() const    {return fW;}
+   virtual Bool_t    InitWorker(const TSelectorDraw &main, TTree *tree);
+   virtual void      MergeWorkers(TCollection &workers);
    virtual Bool_t    Notify();
    virtual Bool_t    Process(Long64_t /*entry*/) { return kFALSE; }
    virtual void      ProcessFill(Long64_t entry);
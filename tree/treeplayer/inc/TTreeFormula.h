@@ -131,6 +131,9 @@ protected:
 
    RealInstanceCache fRealInstanceCache; //! Cache accelerating the GetRealInstance function
 
+   typedef Double_t (*JitFunction_t)(const Double_t *);
+   JitFunction_t        fJitFunction = nullptr; //! Compiled version of the expression, see JitCompile
+
    TTreeFormula(const char *name, const char *formula, TTree *tree, const std::vector<std::string>& aliases);
    void Init(const char *name, const char *formula);
    Bool_t      BranchHasMethod(TLeaf* leaf, TBranch* branch, const char* method,const char* params, Long64_t readentry) const;
@@ -169,6 +172,9 @@ private:
 
    template<typename T> T GetConstant(Int_t k);
 
+   Bool_t            IsJitCompatibleLeaf(Int_t code) const;
+   Double_t          EvalJit(Int_t instance);
+
 public:
    TTreeFormula();
    TTreeFormula(const char *name,const char *formula, TTree *tree);
@@ -198,9 +204,11 @@ public:
    //the mutable keyword.
    //NOTE: Also modify the code in PrintValue which current goes around this limitation :(
    virtual Bool_t      IsInteger(Bool_t fast=kTRUE) const;
+           Bool_t      IsJitCompiled() const { return fJitFunction != nullptr; }
            Bool_t      IsQuickLoad() const { return fQuickLoad; }
    virtual Bool_t      IsString() const;
    virtual Bool_t      Notify() { UpdateFormulaLeaves(); return kTRUE; }
+           Bool_t      JitCompile();
    virtual char       *PrintValue(Int_t mode=0) const;
    virtual char       *PrintValue(Int_t mode, Int_t instance, const char *decform = "9.9") const;
    virtual void        SetAxis(TAxis *axis=0);
@@ -210,6 +218,8 @@ public:
    virtual TTree*      GetTree() const {return fTree;}
    virtual void        UpdateFormulaLeaves();
 
+   static  Long64_t    GetJitMinEntries();
+
    ClassDef(TTreeFormula, 10);  //The Tree formula
 };
 
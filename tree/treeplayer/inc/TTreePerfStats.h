@@ -23,6 +23,9 @@
 
 #include "TVirtualPerfStats.h"
 #include "TString.h"
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 #include <unordered_map>
 
@@ -46,6 +49,25 @@ public:
 
    using BasketList_t = std::vector<std::pair<TBranch*, std::vector<size_t>>>;
 
+   struct BranchInfo {
+      std::string fName;              // Name of the branch.
+      Long64_t  fBytesRead = {0};     // Number of bytes of the baskets unzipped by the branch, as stored in the file.
+      Long64_t  fBytesUnzipped = {0}; // Number of bytes of the baskets unzipped by the branch, once unzipped.
+      UInt_t    fBaskets = {0};       // Number of baskets unzipped by the branch.
+      Double_t  fUnzipTime = {0};     // Time spent unzipping the baskets, in seconds.
+      ULong64_t fEntries = {0};       // Number of entries deserialized (see BranchReadEvent).
+      Double_t  fReadTime = {0};      // Time spent deserializing the entries, in seconds (see BranchReadEvent).
+   };
+
+   struct BranchReadCounters;
+
+   struct TaskInfo {
+      std::string fName;     // Name of the task.
+      Int_t     fThread;     // Number of the thread which ran the task.
+      Double_t  fStart;      // Start of the task, in seconds since the creation of the TTreePerfStats.
+      Double_t  fDuration;   // Duration of the task, in seconds.
+   };
+
 protected:
    Int_t         fTreeCacheSize; //TTreeCache buffer size
    Int_t         fNleaves;       //Number of leaves in the tree
@@ -59,6 +81,9 @@ protected:
    Double_t      fDiskTime;      //Time spent in pure raw disk IO
    Double_t      fUnzipTime;     //Time spent uncompressing the data.
    Double_t      fCompress;      //Tree compression factor
+   Int_t         fUnzipAhead;    //Number of baskets unzipped ahead by the TTreeCacheUnzip tasks
+   Int_t         fUnzipWasted;   //Number of baskets unzipped ahead but not used
+   Int_t         fUnzipWaited;   //Number of baskets whose unzipping by a task had to be waited for
    TString       fName;          //name of this TTreePerfStats
    TString       fHostInfo;      //name of the host system, ROOT version and date
    TFile        *fFile;          //!pointer to the file containing the Tree
@@ -73,8 +98,24 @@ protected:
    std::unordered_map<TBranch*, size_t>  fBranchIndexCache; // Cache the index of the branch in the cache's array.
    std::vector<std::vector<BasketInfo> > fBasketsInfo;      // Details on which baskets was used, cached, 'miss-cached' or read uncached.Browse
 
+   Double_t                                fStartTime = {0};    //! Time stamp of the creation, origin of the timeline.
+   ULong64_t                               fSerial = {0};       //! Identifies this object in the caches of the threads.
+   mutable std::vector<BranchInfo>         fBranchInfo;         //! Counters of each branch read.
+   std::vector<std::unique_ptr<BranchReadCounters>> fBranchReadCounters; //! [fBranchInfo] Counters of BranchReadEvent.
+   std::unordered_map<TBranch*, size_t>    fBranchInfoIndex;    //! Index of the counters of a branch in fBranchInfo.
+   std::unordered_map<std::string, size_t> fBranchInfoByName;   //! Index of the counters of a branch name in fBranchInfo.
+   std::vector<TaskInfo>                   fTasks;              //! Timeline of the tasks of all the threads.
+   Long64_t                                fMaxTasks = {0};     //! Maximum number of tasks in the timeline (0: no timeline).
+   Long64_t                                fDroppedTasks = {0}; //! Number of tasks left out of the full timeline.
+   mutable std::mutex                      fEventMutex;         //! Protects the branch counters and the timeline.
+
    BasketInfo &GetBasketInfo(TBranch *b, size_t basketNumber);
    BasketInfo &GetBasketInfo(size_t bi, size_t basketNumber);
+   BranchInfo &GetBranchInfo(TBranch *b);
+   size_t      GetBranchIndex(TBranch *b);
+   BranchReadCounters &GetBranchReadCounters(TBranch *b);
+   void        MergeBranchReadCounters() const;
+   void        AddTask(const char *name, Double_t start, Double_t end);
 
 public:
    TTreePerfStats();
@@ -102,6 +143,9 @@ public:
    TStopwatch      *GetStopwatch() const {return fWatch;}
    virtual Int_t    GetTreeCacheSize() const {return fTreeCacheSize;}
    virtual Double_t GetUnzipTime() const {return fUnzipTime; }
+   virtual Int_t    GetUnzipAhead() const {return fUnzipAhead;}
+   virtual Int_t    GetUnzipWasted() const {return fUnzipWasted;}
+   virtual Int_t    GetUnzipWaited() const {return fUnzipWaited;}
    virtual void     Paint(Option_t *chopt="");
    virtual void     Print(Option_t *option="") const;
 
@@ -112,9 +156,13 @@ public:
    virtual void     FileOpenEvent(TFile *, const char *, Double_t) {}
    virtual void     FileReadEvent(TFile *file, Int_t len, Double_t start);
    virtual void     UnzipEvent(TObject *tree, Long64_t pos, Double_t start, Int_t complen, Int_t objlen);
+   virtual void     BranchUnzipEvent(TBranch *branch, Double_t start, Int_t complen, Int_t objlen);
+   virtual void     BranchReadEvent(TBranch *branch, Double_t start);
+   virtual void     TaskEvent(TObject *tree, const char *name, Double_t start);
    virtual void     RateEvent(Double_t , Double_t , Long64_t , Long64_t) {}
 
    virtual void     SaveAs(const char *filename="",Option_t *option="") const;
+   virtual Bool_t   SaveTrace(const char *filename) const;
    virtual void     SavePrimitive(std::ostream &out, Option_t *option = "");
    virtual void     SetBytesRead(Long64_t nbytes) {fBytesRead = nbytes;}
    virtual void     SetBytesReadExtra(Long64_t nbytes) {fBytesReadExtra = nbytes;}
@@ -133,8 +181,17 @@ public:
    virtual void     SetRealTime(Double_t rtime) {fRealTime = rtime;}
    virtual void     SetTreeCacheSize(Int_t nbytes) {fTreeCacheSize = nbytes;}
    virtual void     SetUnzipTime(Double_t uztime) {fUnzipTime = uztime;}
+   virtual void     SetUnzipAhead(Int_t n) {fUnzipAhead = n;}
+   virtual void     SetUnzipWasted(Int_t n) {fUnzipWasted = n;}
+   virtual void     SetUnzipWaited(Int_t n) {fUnzipWaited = n;}
 
    virtual void     PrintBasketInfo(Option_t *option = "") const;
+   virtual void     PrintBranchInfo(Option_t *option = "") const;
+   const std::vector<BranchInfo> &GetBranchesInfo() const;
+   const std::vector<TaskInfo>   &GetTasks() const { return fTasks; }
+   Long64_t         GetTimelineSize() const { return fMaxTasks; }
+   Long64_t         GetNDroppedTasks() const { return fDroppedTasks; }
+   virtual void     SetTimelineSize(Long64_t maxTasks = 1000000);
    virtual void     SetLoaded(TBranch *b, size_t basketNumber) { ++GetBasketInfo(b, basketNumber).fLoaded; }
    virtual void     SetLoaded(size_t bi, size_t basketNumber) { ++GetBasketInfo(bi, basketNumber).fLoaded; }
    virtual void     SetLoadedMiss(TBranch *b, size_t basketNumber) { ++GetBasketInfo(b, basketNumber).fLoadedMiss; }
@@ -147,7 +204,7 @@ public:
 
    BasketList_t     GetDuplicateBasketCache() const;
 
-   ClassDef(TTreePerfStats, 7) // TTree I/O performance measurement
+   ClassDef(TTreePerfStats, 8) // TTree I/O performance measurement
 };
 
 #endif
@@ -59,6 +59,8 @@ protected:
    void           TakeAction(Int_t nfill, Int_t &npoints, Int_t &action, TObject *obj, Option_t *option);
    void           TakeEstimate(Int_t nfill, Int_t &npoints, Int_t action, TObject *obj, Option_t *option);
    void           DeleteSelectorFromFile();
+   Bool_t         CanProcessDrawMT(Long64_t nentries) const;
+   Bool_t         ProcessDrawMT(Long64_t begin, Long64_t end);
 
 public:
    TTreePlayer();
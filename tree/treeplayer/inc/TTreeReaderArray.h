@@ -40,6 +40,8 @@ Base class of TTreeReaderArray.
    protected:
       void *UntypedAt(std::size_t idx) const { return fImpl->At(GetProxy(), idx); }
       virtual void CreateProxy();
+      // The collection readers access the values through the TBranchProxy.
+      virtual Bool_t CanReadBulk() const { return kFALSE; }
       bool GetBranchAndLeaf(TBranch* &branch, TLeaf* &myLeaf,
                             TDictionary* &branchActualType);
       void SetImpl(TBranch* branch, TLeaf* myLeaf);
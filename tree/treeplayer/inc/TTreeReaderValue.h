@@ -35,6 +35,8 @@ class TTreeReader;
 namespace ROOT {
 namespace Internal {
 
+class TTreeReaderValueBulkRead;
+
 /** \class TTreeReaderValueBase
 Base class of TTreeReaderValue.
 */
@@ -71,6 +73,7 @@ Base class of TTreeReaderValue.
       EReadStatus ProxyRead() { return (this->*fProxyReadFunc)(); }
 
       EReadStatus ProxyReadDefaultImpl();
+      EReadStatus ProxyReadBulk();
 
       typedef Bool_t (ROOT::Detail::TBranchProxy::*BranchProxyRead_t)();
       template <BranchProxyRead_t Func>
@@ -105,6 +108,10 @@ Base class of TTreeReaderValue.
 
       virtual const char* GetDerivedTypeName() const = 0;
 
+      /// Whether the values may be read with the bulk API of TBranch, bypassing the TBranchProxy.
+      virtual Bool_t CanReadBulk() const { return kTRUE; }
+      Bool_t SetupBulkRead();
+
       Detail::TBranchProxy* GetProxy() const { return fProxy; }
 
       void MarkTreeReaderUnavailable() { fTreeReader = 0; fSetupStatus = kSetupTreeDestructed; }
@@ -125,6 +132,7 @@ Base class of TTreeReaderValue.
       std::vector<Long64_t> fStaticClassOffsets;
       typedef EReadStatus (TTreeReaderValueBase::*Read_t)();
       Read_t fProxyReadFunc = &TTreeReaderValueBase::ProxyReadDefaultImpl;      ///<! Pointer to the Read implementation to use.
+      TTreeReaderValueBulkRead *fBulkRead = nullptr; ///<! State of the bulk read of the branch, owned
 
       // FIXME: re-introduce once we have ClassDefInline!
       //ClassDef(TTreeReaderValueBase, 0);//Base class for accessors to data via TTreeReader
@@ -26,6 +26,7 @@ A specialized TSelector for TTree::Draw.
 #include "TProfile2D.h"
 #include "TTreeFormulaManager.h"
 #include "TEnv.h"
+#include "TMath.h"
 #include "TTree.h"
 #include "TCut.h"
 #include "TEntryList.h"
@@ -950,6 +951,131 @@ void TSelectorDraw::ClearFormula()
    fMultiplicity = 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compile the selection and the variables into native code (see
+/// TTreeFormula::JitCompile) when the tree is large enough for the compilation
+/// to pay off.  The formulas that cannot be compiled are interpreted as before.
+
+void TSelectorDraw::JitCompileFormulas()
+{
+   const Long64_t minEntries = TTreeFormula::GetJitMinEntries();
+   if (minEntries < 0 || fTree->GetEntriesFast() < minEntries)
+      return;
+   if (fSelect) fSelect->JitCompile();
+   for (Int_t i = 0; i < fDimension; ++i) {
+      if (fVar[i]) fVar[i]->JitCompile();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the remaining entries can be processed by parallel workers
+/// (see InitWorker), i.e. if the selector only fills a histogram or a profile
+/// whose binning has been fixed.
+
+Bool_t TSelectorDraw::CanProcessMT() const
+{
+   if (fObjEval || fTreeElistArray || !fObject || fTree->GetUpdate())
+      return kFALSE;
+   return fAction == 1 || fAction == 2 || fAction == 4 || fAction == 23;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Hand the buffered values over to TakeAction.  If the binning of the
+/// histogram is automatic, it is computed from these values.
+
+void TSelectorDraw::FlushBuffer()
+{
+   if (fNfill) {
+      TakeAction();
+      fNfill = 0;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set up this selector as a worker filling, from `tree`, an empty copy of the
+/// histogram of `main`, with the same variables and selection.  `main` must
+/// have been through Begin and CanProcessMT must be true for it.  The method
+/// can be called again when the worker moves to another tree: the values
+/// buffered for the previous tree are filled first, then the formulas are
+/// compiled again and the histogram is kept.  The copies are added to the
+/// histogram of `main` by MergeWorkers.
+
+Bool_t TSelectorDraw::InitWorker(const TSelectorDraw &main, TTree *tree)
+{
+   // The buffered values and weights belong to the previous tree.
+   if (fObject)
+      FlushBuffer();
+
+   TString varexp;
+   for (Int_t i = 0; i < main.fDimension; ++i) {
+      if (i) varexp.Append(':');
+      varexp.Append(main.fVar[i]->GetTitle());
+   }
+   const char *selection = main.fSelect ? main.fSelect->GetTitle() : "";
+
+   fTree = tree;
+   // The buffers only group the fills: no need for the estimate of the main tree.
+   fTree->SetEstimate(TMath::Min(main.fTree->GetEstimate(), (Long64_t)10000));
+   if (TList *aliases = main.fTree->GetListOfAliases()) {
+      TIter next(aliases);
+      while (TObject *alias = next())
+         fTree->SetAlias(alias->GetName(), alias->GetTitle());
+   }
+   if (!CompileVariables(varexp, selection) || fDimension != main.fDimension)
+      return kFALSE;
+
+   fAction = main.fAction;
+   fForceRead = fTree->TestBit(TTree::kForceRead);
+   fWeight = fTree->GetWeight();
+   fSelectMultiple = fSelect && fSelect->GetMultiplicity();
+   for (Int_t i = 0; i < fDimension; ++i) {
+      fVarMultiple[i] = fVar[i]->GetMultiplicity() != 0;
+      if (!fVal[i]) fVal[i] = new Double_t[(Int_t)fTree->GetEstimate()];
+   }
+   if (!fW) fW = new Double_t[(Int_t)fTree->GetEstimate()];
+
+   if (!fObject) {
+      TDirectory::TContext ctxt(nullptr);
+      TH1 *hist = (TH1*)main.fObject->Clone();
+      hist->SetDirectory(nullptr);
+      hist->Reset();
+      fObject = hist;
+      fSelectedRows = 0;
+   }
+   TH1 *hist = (TH1*)fObject;
+   if (fAction == 1) {
+      fVar[0]->SetAxis(hist->GetXaxis());
+   } else if (fAction == 2) {
+      fVar[0]->SetAxis(hist->GetYaxis());
+      fVar[1]->SetAxis(hist->GetXaxis());
+   } else if (fAction == 4) {
+      fVar[1]->SetAxis(hist->GetXaxis());
+   } else if (fAction == 23) {
+      fVar[1]->SetAxis(hist->GetYaxis());
+      fVar[2]->SetAxis(hist->GetXaxis());
+   }
+   fNfill = 0;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the histograms filled by the workers (see InitWorker) to the histogram
+/// of this selector, and delete them.
+
+void TSelectorDraw::MergeWorkers(TCollection &workers)
+{
+   TList histograms;
+   TIter next(&workers);
+   while (TSelectorDraw *worker = (TSelectorDraw*)next()) {
+      worker->FlushBuffer();
+      fSelectedRows += worker->fSelectedRows;
+      if (worker->fObject) histograms.Add(worker->fObject);
+      worker->fObject = nullptr;
+   }
+   if (histograms.GetSize()) ((TH1*)fObject)->Merge(&histograms);
+   histograms.Delete();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Compile input variables and selection expression.
 ///
@@ -1008,6 +1134,7 @@ Bool_t TSelectorDraw::CompileVariables(const char *varexp, const char *selection
          if (fManager->GetMultiplicity() == -1) fTree->SetBit(TTree::kForceRead);
          if (fManager->GetMultiplicity() >= 1) fMultiplicity = fManager->GetMultiplicity();
       }
+      JitCompileFormulas();
 
       return kTRUE;
    }
@@ -1033,6 +1160,7 @@ Bool_t TSelectorDraw::CompileVariables(const char *varexp, const char *selection
    if (fManager->GetMultiplicity() >= 1) fMultiplicity = fManager->GetMultiplicity();
 
    fDimension    = ncols;
+   JitCompileFormulas();
 
    if (ncols == 1) {
       TClass *cl = fVar[0]->EvalClass();
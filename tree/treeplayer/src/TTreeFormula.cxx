@@ -45,6 +45,7 @@
 #include "TFormLeafInfoReference.h"
 
 #include "TEntryList.h"
+#include "TEnv.h"
 
 #include <ctype.h>
 #include <stdio.h>
@@ -52,6 +53,10 @@
 #include <stdlib.h>
 #include <typeinfo>
 #include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <type_traits>
 
 const Int_t kMaxLen     = 1024;
 
@@ -3937,6 +3942,7 @@ T TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[])
 // Note that the redundance and structure in this code is tailored to improve
 // efficiencies.
    if (TestBit(kMissingLeaf)) return 0;
+   if (std::is_same<T, Double_t>::value && fJitFunction) return EvalJit(instance);
    if (fNoper == 1 && fNcodes > 0) {
 
       switch (fLookupType[0]) {
@@ -4405,6 +4411,240 @@ template double TTreeFormula::EvalInstance<double> (int, char const**);
 template long double TTreeFormula::EvalInstance<long double> (int, char const**);
 template long long TTreeFormula::EvalInstance<long long> (int, char const**);
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the minimum number of entries a query must process for TTree::Draw
+/// and TTree::Scan to compile their formulas (see JitCompile).  It is read from
+/// the resource `TTreeFormula.JitMinEntries` (default 1000000); a negative
+/// value disables the compilation.
+
+Long64_t TTreeFormula::GetJitMinEntries()
+{
+   static const Long64_t minEntries = gEnv->GetValue("TTreeFormula.JitMinEntries", 1000000);
+   return minEntries;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the leaf at `code` holds a single numerical value that
+/// can be handed to the compiled expression.
+
+Bool_t TTreeFormula::IsJitCompatibleLeaf(Int_t code) const
+{
+   if (fLookupType[code] != kDirect || fCodes[code] < 0 || fNdimensions[code] != 0)
+      return kFALSE;
+   const TLeaf *leaf = (const TLeaf *)fLeaves.UncheckedAt(code);
+   if (!leaf || leaf->GetLeafCount() || leaf->GetLenStatic() != 1 || IsLeafString(code))
+      return kFALSE;
+   return leaf->IsA() != TLeafObject::Class() && leaf->IsA() != TLeafC::Class();
+}
+
+namespace {
+
+// The guarded math functions used by the compiled expressions, mirroring the
+// protections of TTreeFormula::EvalInstance.
+const char *gJitHelpers = R"CODE(
+#include "TMath.h"
+#include <cmath>
+namespace ROOT {
+namespace Internal {
+namespace TTreeFormulaJit {
+inline double Div(double a, double b) { return b == 0 ? 0 : a / b; }
+inline double Mod(double a, double b) { return double((long long)a % (long long)b); }
+inline double Tan(double a) { return TMath::Cos(a) == 0 ? 0 : TMath::Tan(a); }
+inline double ACos(double a) { return TMath::Abs(a) > 1 ? 0 : TMath::ACos(a); }
+inline double ASin(double a) { return TMath::Abs(a) > 1 ? 0 : TMath::ASin(a); }
+inline double TanH(double a) { return TMath::CosH(a) == 0 ? 0 : TMath::TanH(a); }
+inline double ACosH(double a) { return a < 1 ? 0 : TMath::ACosH(a); }
+inline double ATanH(double a) { return TMath::Abs(a) > 1 ? 0 : TMath::ATanH(a); }
+inline double Sq(double a) { return a * a; }
+inline double Log(double a) { return a > 0 ? TMath::Log(a) : 0; }
+inline double Log10(double a) { return a > 0 ? TMath::Log10(a) : 0; }
+inline double Exp(double a) { return a < -700 ? 0 : (a > 700 ? TMath::Exp(700) : TMath::Exp(a)); }
+inline double Sign(double a) { return a < 0 ? -1 : 1; }
+inline double Int(double a) { return double((long long)a); }
+}
+}
+}
+)CODE";
+
+typedef Double_t (*JitFunction_t)(const Double_t *);
+
+std::mutex gJitMutex;
+std::map<std::string, JitFunction_t> gJitCache;
+
+// Compile `expr`, a C++ expression of the array `v`, into a function; the
+// result (possibly a failure) is cached so that each expression is handed to
+// the interpreter at most once per process.
+JitFunction_t JitExpression(const std::string &expr)
+{
+   std::lock_guard<std::mutex> lock(gJitMutex);
+   auto found = gJitCache.find(expr);
+   if (found != gJitCache.end())
+      return found->second;
+
+   JitFunction_t func = nullptr;
+   static Bool_t helpersDeclared = gInterpreter->Declare(gJitHelpers);
+   if (helpersDeclared) {
+      const TString name = TString::Format("Eval%d", (int)gJitCache.size());
+      const TString code = TString::Format("namespace ROOT { namespace Internal { namespace TTreeFormulaJit {\n"
+                                           "double %s(const double *v) { return %s; }\n}}}",
+                                           name.Data(), expr.c_str());
+      if (gInterpreter->Declare(code)) {
+         TInterpreter::EErrorCode error = TInterpreter::kNoError;
+         const Long_t addr = gInterpreter->Calc(TString::Format("(long)&ROOT::Internal::TTreeFormulaJit::%s", name.Data()), &error);
+         if (error == TInterpreter::kNoError)
+            func = reinterpret_cast<JitFunction_t>(addr);
+      }
+   }
+   gJitCache[expr] = func;
+   return func;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translate the expression into C++ and compile it with the interpreter, so
+/// that EvalInstance (for doubles) runs native code instead of walking the
+/// operator stack.
+///
+/// Only the arithmetic, mathematical, comparison, logical and bitwise
+/// operators on constants and on leaves holding a single numerical value are
+/// supported.  Expressions using arrays, strings, aliases, data members,
+/// methods, function calls, special variables (Entry$, ...), cuts or the `?:`
+/// operator are left to the interpreter; in that case, or if the compilation
+/// fails, kFALSE is returned and the formula is unchanged.
+///
+/// All the leaves are read for each entry: the right hand side of `&&` and `||`
+/// is no longer skipped, which gives the same result since the expression has
+/// no side effect.
+
+Bool_t TTreeFormula::JitCompile()
+{
+   if (fJitFunction)
+      return kTRUE;
+   if (TestBit(kMissingLeaf) || fNoper < 2 || fMultiplicity != 0 || fHasCast || fAxis || IsString())
+      return kFALSE;
+
+   for (Int_t code = 0; code < fNcodes; ++code) {
+      if (!IsJitCompatibleLeaf(code))
+         return kFALSE;
+   }
+
+   // Rebuild the expression from the operator stack, one C++ string per operand.
+   std::vector<std::string> stack;
+   auto unary = [&stack](const std::string &prefix, const std::string &suffix) {
+      if (stack.empty()) return false;
+      stack.back() = prefix + "(" + stack.back() + ")" + suffix;
+      return true;
+   };
+   auto binary = [&stack](const std::string &prefix, const std::string &op, const std::string &suffix) {
+      if (stack.size() < 2) return false;
+      const std::string rhs = stack.back();
+      stack.pop_back();
+      stack.back() = prefix + "(" + stack.back() + ")" + op + "(" + rhs + ")" + suffix;
+      return true;
+   };
+   auto call = [&binary](const std::string &func) { return binary(func + "(", ",", ")"); };
+   auto compare = [&binary](const std::string &op) { return binary("double(", op, ")"); };
+   auto bitwise = [&binary](const std::string &op) {
+      return binary("double((unsigned long long)", op + "(unsigned long long)", ")");
+   };
+
+   for (Int_t i = 0; i < fNoper; ++i) {
+      const Int_t oper = GetOper()[i];
+      const Int_t action = oper >> kTFOperShift;
+      Bool_t ok = kTRUE;
+      switch (action) {
+         case kEnd: i = fNoper; break;
+         case kConstant: {
+            const Double_t value = fConst[oper & kTFOperMask];
+            if (!std::isfinite(value)) return kFALSE;
+            stack.emplace_back(TString::Format("(%.17g)", value).Data());
+            break;
+         }
+         case kDefinedVariable: {
+            const Int_t code = oper & kTFOperMask;
+            if (!IsJitCompatibleLeaf(code)) return kFALSE;
+            stack.emplace_back(TString::Format("v[%d]", code).Data());
+            break;
+         }
+         case kBoolOptimize: break; // the right hand side is always evaluated
+         case kpi: stack.emplace_back("TMath::Pi()"); break;
+         case kAdd: ok = binary("(", "+", ")"); break;
+         case kSubstract: ok = binary("(", "-", ")"); break;
+         case kMultiply: ok = binary("(", "*", ")"); break;
+         case kDivide: ok = call("Div"); break;
+         case kModulo: ok = call("Mod"); break;
+         case katan2: ok = call("TMath::ATan2"); break;
+         case kfmod: ok = call("std::fmod"); break;
+         case kpow: ok = call("TMath::Power"); break;
+         case kmin: ok = call("TMath::Min"); break;
+         case kmax: ok = call("TMath::Max"); break;
+         case kcos: ok = unary("TMath::Cos", ""); break;
+         case ksin: ok = unary("TMath::Sin", ""); break;
+         case ktan: ok = unary("Tan", ""); break;
+         case kacos: ok = unary("ACos", ""); break;
+         case kasin: ok = unary("ASin", ""); break;
+         case katan: ok = unary("TMath::ATan", ""); break;
+         case kcosh: ok = unary("TMath::CosH", ""); break;
+         case ksinh: ok = unary("TMath::SinH", ""); break;
+         case ktanh: ok = unary("TanH", ""); break;
+         case kacosh: ok = unary("ACosH", ""); break;
+         case kasinh: ok = unary("TMath::ASinH", ""); break;
+         case katanh: ok = unary("ATanH", ""); break;
+         case ksq: ok = unary("Sq", ""); break;
+         case ksqrt: ok = unary("TMath::Sqrt(TMath::Abs", ")"); break;
+         case klog: ok = unary("Log", ""); break;
+         case kexp: ok = unary("Exp", ""); break;
+         case klog10: ok = unary("Log10", ""); break;
+         case kabs: ok = unary("TMath::Abs", ""); break;
+         case ksign: ok = unary("Sign", ""); break;
+         case kint: ok = unary("Int", ""); break;
+         case kSignInv: ok = unary("(-", ")"); break;
+         case kNot: ok = unary("double(0==", ")"); break;
+         case kAnd: ok = binary("double(0!=", "&&0!=", ")"); break;
+         case kOr: ok = binary("double(0!=", "||0!=", ")"); break;
+         case kEqual: ok = compare("=="); break;
+         case kNotEqual: ok = compare("!="); break;
+         case kLess: ok = compare("<"); break;
+         case kGreater: ok = compare(">"); break;
+         case kLessThan: ok = compare("<="); break;
+         case kGreaterThan: ok = compare(">="); break;
+         case kBitAnd: ok = bitwise("&"); break;
+         case kBitOr: ok = bitwise("|"); break;
+         case kLeftShift: ok = bitwise("<<"); break;
+         case kRightShift: ok = bitwise(">>"); break;
+         default: return kFALSE; // jumps, strings, functions, aliases, ...
+      }
+      if (!ok) return kFALSE;
+   }
+   if (stack.size() != 1)
+      return kFALSE;
+
+   fJitFunction = JitExpression(stack.front());
+   return fJitFunction != nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the compiled version of the formula (see JitCompile).
+
+Double_t TTreeFormula::EvalJit(Int_t instance)
+{
+   const Bool_t willLoad = (instance == 0 || fNeedLoading);
+   fNeedLoading = kFALSE;
+   if (willLoad) fDidBooleanOptimization = kFALSE;
+
+   Double_t values[kMAXCODES];
+   for (Int_t code = 0; code < fNcodes; ++code) {
+      TLeaf *leaf = (TLeaf *)fLeaves.UncheckedAt(code);
+      if (willLoad) {
+         TBranch *branch = (TBranch *)fBranches.UncheckedAt(code);
+         if (branch) R__LoadBranch(branch, branch->GetTree()->GetReadEntry(), fQuickLoad);
+      }
+      values[code] = leaf->GetValue(0);
+   }
+   return fJitFunction(values);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return DataMember corresponding to code.
 ///
@@ -5137,6 +5377,15 @@ void TTreeFormula::UpdateFormulaLeaves()
             break;
       }
    }
+   if (fJitFunction) {
+      // The leaves of the new tree may not be usable by the compiled expression.
+      for (Int_t code = 0; code < fNcodes; ++code) {
+         if (!IsJitCompatibleLeaf(code)) {
+            fJitFunction = nullptr;
+            break;
+         }
+      }
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -11,11 +11,33 @@
 
 /** \class TTreeIndex
 A Tree Index with majorname and minorname.
+
+When implicit multi-threading is enabled, the index of a TTree read from a
+file is built in parallel: the major and minor values of plain numerical
+branches are read cluster by cluster with the bulk IO interface, and the
+(major, minor) pairs are sorted with a parallel radix sort.
 */
 
 #include "TTreeIndex.h"
 #include "TTree.h"
 #include "TMath.h"
+#include "TROOT.h"
+#include "TBranch.h"
+#include "TLeaf.h"
+#include "TDataType.h"
+#include "TBufferFile.h"
+#include "TFile.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TTreeProcessorMT.hxx"
+#include "TTreeReader.h"
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
 
 ClassImp(TTreeIndex);
 
@@ -39,6 +61,256 @@ struct IndexSortComparator {
   Long64_t *fValMajor, *fValMinor;
 };
 
+namespace {
+
+const Int_t kRadixBits = 8;
+const Int_t kRadixSize = 1 << kRadixBits;
+const Int_t kRadixDigits = 2 * 64 / kRadixBits; // The digits of the minor value come first.
+const Long64_t kMinRadixSort = 1 << 16;         // Below this size std::sort is faster.
+
+////////////////////////////////////////////////////////////////////////////////
+/// Run `func(chunk)` for each chunk, in the ROOT thread pool if possible.
+
+template <typename F>
+void ForEachChunk(UInt_t nchunks, const F &func)
+{
+#ifdef R__USE_IMT
+   if (nchunks > 1) {
+      ROOT::TThreadExecutor().Foreach(func, ROOT::TSeq<UInt_t>(nchunks));
+      return;
+   }
+#endif
+   for (UInt_t c = 0; c < nchunks; ++c)
+      func(c);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the digit `d` of the 128 bit key (major, minor) of entry `i`.
+/// The sign bits are flipped so that the unsigned order matches the signed one.
+
+inline UInt_t RadixDigit(const Long64_t *major, const Long64_t *minor, Long64_t i, Int_t d)
+{
+   const Int_t half = kRadixDigits / 2;
+   const ULong64_t key = ULong64_t(d < half ? minor[i] : major[i]) ^ (1ULL << 63);
+   return (key >> ((d % half) * kRadixBits)) & (kRadixSize - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sort the entries by (major, minor) with a stable LSD radix sort.
+///
+/// major, minor and index are arrays of n elements allocated with new[]; on return
+/// they point to the sorted arrays, which are either the input ones or the scratch
+/// ones (the others are deleted). The histograms and the scatter of each pass are
+/// done in parallel over contiguous chunks; passes on digits that are the same for
+/// all the entries, typically the high bytes of the run and event numbers, are skipped.
+
+void RadixSortIndex(Long64_t n, Long64_t *&major, Long64_t *&minor, Long64_t *&index)
+{
+   UInt_t nchunks = ROOT::IsImplicitMTEnabled() ? ROOT::GetImplicitMTPoolSize() : 1;
+   if (nchunks < 1)
+      nchunks = 1;
+   const Long64_t chunkSize = (n + nchunks - 1) / nchunks;
+   nchunks = (n + chunkSize - 1) / chunkSize;
+   auto chunkBegin = [&](UInt_t c) { return c * chunkSize; };
+   auto chunkEnd = [&](UInt_t c) { return TMath::Min(n, (c + 1) * chunkSize); };
+
+   // The digit histograms of the whole sample do not depend on the order of the
+   // entries: compute them once to find out which passes are needed.
+   std::vector<Long64_t> counts(nchunks * kRadixDigits * kRadixSize, 0);
+   ForEachChunk(nchunks, [&](UInt_t c) {
+      Long64_t *h = &counts[c * kRadixDigits * kRadixSize];
+      for (Long64_t i = chunkBegin(c); i < chunkEnd(c); ++i)
+         for (Int_t d = 0; d < kRadixDigits; ++d)
+            ++h[d * kRadixSize + RadixDigit(major, minor, i, d)];
+   });
+   std::vector<Int_t> passes;
+   for (Int_t d = 0; d < kRadixDigits; ++d) {
+      Bool_t trivial = kFALSE;
+      for (Int_t b = 0; b < kRadixSize && !trivial; ++b) {
+         Long64_t total = 0;
+         for (UInt_t c = 0; c < nchunks; ++c)
+            total += counts[(c * kRadixDigits + d) * kRadixSize + b];
+         trivial = (total == n);
+      }
+      if (!trivial)
+         passes.push_back(d);
+   }
+   if (passes.empty())
+      return;
+
+   Long64_t *tmpMajor = new Long64_t[n];
+   Long64_t *tmpMinor = new Long64_t[n];
+   Long64_t *tmpIndex = new Long64_t[n];
+   std::vector<Long64_t> offsets(nchunks * kRadixSize);
+   for (size_t p = 0; p < passes.size(); ++p) {
+      const Int_t d = passes[p];
+      if (p == 0) {
+         // The chunks still hold the original entries: reuse the first histograms.
+         for (UInt_t c = 0; c < nchunks; ++c)
+            std::memcpy(&offsets[c * kRadixSize], &counts[(c * kRadixDigits + d) * kRadixSize],
+                        kRadixSize * sizeof(Long64_t));
+      } else {
+         ForEachChunk(nchunks, [&](UInt_t c) {
+            Long64_t *h = &offsets[c * kRadixSize];
+            std::fill(h, h + kRadixSize, 0);
+            for (Long64_t i = chunkBegin(c); i < chunkEnd(c); ++i)
+               ++h[RadixDigit(major, minor, i, d)];
+         });
+      }
+      // Turn the counts into the output position of each (bucket, chunk): the
+      // chunks are scattered in order within a bucket, which keeps the sort stable.
+      Long64_t sum = 0;
+      for (Int_t b = 0; b < kRadixSize; ++b) {
+         for (UInt_t c = 0; c < nchunks; ++c) {
+            const Long64_t cnt = offsets[c * kRadixSize + b];
+            offsets[c * kRadixSize + b] = sum;
+            sum += cnt;
+         }
+      }
+      ForEachChunk(nchunks, [&](UInt_t c) {
+         Long64_t *pos = &offsets[c * kRadixSize];
+         for (Long64_t i = chunkBegin(c); i < chunkEnd(c); ++i) {
+            const Long64_t where = pos[RadixDigit(major, minor, i, d)]++;
+            tmpMajor[where] = major[i];
+            tmpMinor[where] = minor[i];
+            tmpIndex[where] = index[i];
+         }
+      });
+      std::swap(major, tmpMajor);
+      std::swap(minor, tmpMinor);
+      std::swap(index, tmpIndex);
+   }
+   delete[] tmpMajor;
+   delete[] tmpMinor;
+   delete[] tmpIndex;
+}
+
+#ifdef R__USE_IMT
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the type of the values of `name` if it is a branch with a single
+/// numerical value per entry that can be read in bulk, kNoType_t otherwise.
+
+EDataType GetBulkIndexType(TTree *tree, const char *name)
+{
+   TBranch *branch = tree->GetBranch(name);
+   if (!branch || !branch->SupportsBulkRead())
+      return kNoType_t;
+   TLeaf *leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->UncheckedAt(0));
+   if (leaf->GetLeafCount() || leaf->GetLen() != 1)
+      return kNoType_t;
+   TDataType *dt = gROOT->GetType(leaf->GetTypeName());
+   if (!dt)
+      return kNoType_t;
+   switch (dt->GetType()) {
+   case kChar_t: case kUChar_t: case kShort_t: case kUShort_t: case kInt_t: case kUInt_t:
+   case kLong64_t: case kULong64_t: case kBool_t: case kFloat_t: case kDouble_t:
+      return (EDataType)dt->GetType();
+   default: return kNoType_t;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert n values of type T to Long64_t, as TTreeFormula would.
+
+template <typename T>
+void ConvertIndexValues(const char *src, Int_t n, Long64_t *dest)
+{
+   for (Int_t i = 0; i < n; ++i) {
+      T value;
+      std::memcpy(&value, src + i * sizeof(T), sizeof(T));
+      dest[i] = (Long64_t)(LongDouble_t)value;
+   }
+}
+
+void ConvertIndexValues(EDataType type, const char *src, Int_t n, Long64_t *dest)
+{
+   switch (type) {
+   case kChar_t: ConvertIndexValues<Char_t>(src, n, dest); break;
+   case kUChar_t: ConvertIndexValues<UChar_t>(src, n, dest); break;
+   case kShort_t: ConvertIndexValues<Short_t>(src, n, dest); break;
+   case kUShort_t: ConvertIndexValues<UShort_t>(src, n, dest); break;
+   case kInt_t: ConvertIndexValues<Int_t>(src, n, dest); break;
+   case kUInt_t: ConvertIndexValues<UInt_t>(src, n, dest); break;
+   case kLong64_t: ConvertIndexValues<Long64_t>(src, n, dest); break;
+   case kULong64_t: ConvertIndexValues<ULong64_t>(src, n, dest); break;
+   case kBool_t: ConvertIndexValues<Bool_t>(src, n, dest); break;
+   case kFloat_t: ConvertIndexValues<Float_t>(src, n, dest); break;
+   case kDouble_t: ConvertIndexValues<Double_t>(src, n, dest); break;
+   default: break;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the values of the branch `name` for the entries [begin, end) of `tree`
+/// into `dest`. The baskets are read with the bulk IO interface; the entries it
+/// cannot serve (a range not starting on a basket boundary) are read one by one.
+
+void ReadIndexValues(TTree *tree, const char *name, EDataType type, Long64_t begin, Long64_t end, Long64_t *dest)
+{
+   TBranch *branch = tree->GetBranch(name);
+   TLeaf *leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->UncheckedAt(0));
+   TBufferFile buf(TBuffer::kWrite, 32 * 1024);
+   Long64_t entry = begin;
+   while (entry < end) {
+      const Int_t n = branch->GetBulkRead().GetBulkEntries(entry, buf);
+      if (n > 0) {
+         const Int_t ncopy = (Int_t)TMath::Min((Long64_t)n, end - entry);
+         ConvertIndexValues(type, buf.GetCurrent(), ncopy, dest + (entry - begin));
+         entry += ncopy;
+      } else {
+         branch->GetEntry(entry);
+         dest[entry - begin] = leaf->GetValueLong64();
+         ++entry;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill major and minor for all the entries of `tree`, processing its clusters in
+/// parallel. Return false, without touching the arrays, if the tree does not
+/// qualify: the index must be made of plain numerical branches (or the constant
+/// "0" for the minor) of a TTree read from a file.
+
+Bool_t ReadIndexValuesMT(TTree *tree, const char *majorname, const char *minorname, Long64_t *major, Long64_t *minor)
+{
+   if (!ROOT::IsImplicitMTEnabled() || tree->IsA() != TTree::Class())
+      return kFALSE;
+   TFile *file = tree->GetCurrentFile();
+   if (!file || file->IsWritable() || tree->GetEntriesFast() != tree->GetEntries())
+      return kFALSE;
+   const Bool_t noMinor = !strcmp(minorname, "0");
+   const EDataType majorType = GetBulkIndexType(tree, majorname);
+   const EDataType minorType = noMinor ? kLong64_t : GetBulkIndexType(tree, minorname);
+   if (majorType == kNoType_t || minorType == kNoType_t)
+      return kFALSE;
+
+   try {
+      ROOT::TTreeProcessorMT processor(*tree);
+      processor.Process([&](TTreeReader &reader) {
+         const auto range = reader.GetEntriesRange();
+         TTree *chain = reader.GetTree();
+         if (chain->LoadTree(range.first) < 0)
+            throw std::runtime_error("cannot load the entry range");
+         // There is a single file: the local entry numbers are the global ones.
+         TTree *t = chain->GetTree();
+         ReadIndexValues(t, majorname, majorType, range.first, range.second, major + range.first);
+         if (noMinor)
+            std::fill(minor + range.first, minor + range.second, 0);
+         else
+            ReadIndexValues(t, minorname, minorType, range.first, range.second, minor + range.first);
+      });
+   } catch (const std::exception &e) {
+      ::Warning("TTreeIndex", "Falling back to the sequential build of the index: %s", e.what());
+      return kFALSE;
+   }
+   return kTRUE;
+}
+
+#endif // R__USE_IMT
+
+} // anonymous namespace
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor for TTreeIndex
@@ -119,6 +391,15 @@ TTreeIndex::TTreeIndex(): TVirtualIndex()
 ///
 /// It is possible to play with different TreeIndex in the same Tree.
 /// see comments in TTree::SetTreeIndex.
+///
+/// ## Parallel build
+///
+/// If implicit multi-threading is enabled (ROOT::EnableImplicitMT()), the Tree
+/// is read from a file and majorname and minorname are the names of branches
+/// holding one number per entry (or minorname is "0"), the values are read in
+/// parallel, one task per cluster, using the bulk IO interface. Large indices
+/// are sorted with a parallel radix sort whatever the way they were read.
+/// The resulting index is identical to the one built sequentially.
 
 TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorname)
            : TVirtualIndex()
@@ -165,31 +446,44 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    Long64_t *tmp_minor = new Long64_t[fN];
    Long64_t i;
    Long64_t oldEntry = fTree->GetReadEntry();
-   Int_t current = -1;
-   for (i=0;i<fN;i++) {
-      Long64_t centry = fTree->LoadTree(i);
-      if (centry < 0) break;
-      if (fTree->GetTreeNumber() != current) {
-         current = fTree->GetTreeNumber();
-         fMajorFormula->UpdateFormulaLeaves();
-         fMinorFormula->UpdateFormulaLeaves();
+   Bool_t filled = kFALSE;
+#ifdef R__USE_IMT
+   filled = ReadIndexValuesMT(fTree, majorname, minorname, tmp_major, tmp_minor);
+#endif
+   if (!filled) {
+      Int_t current = -1;
+      for (i=0;i<fN;i++) {
+         Long64_t centry = fTree->LoadTree(i);
+         if (centry < 0) break;
+         if (fTree->GetTreeNumber() != current) {
+            current = fTree->GetTreeNumber();
+            fMajorFormula->UpdateFormulaLeaves();
+            fMinorFormula->UpdateFormulaLeaves();
+         }
+         tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
+         tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
       }
-      tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
-      tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
    }
    fIndex = new Long64_t[fN];
    for(i = 0; i < fN; i++) { fIndex[i] = i; }
-   std::sort(fIndex, fIndex + fN, IndexSortComparator(tmp_major, tmp_minor) );
-   //TMath::Sort(fN,w,fIndex,0);
-   fIndexValues = new Long64_t[fN];
-   fIndexValuesMinor = new Long64_t[fN];
-   for (i=0;i<fN;i++) {
-      fIndexValues[i] = tmp_major[fIndex[i]];
-      fIndexValuesMinor[i] = tmp_minor[fIndex[i]];
-   }
+   if (fN >= kMinRadixSort) {
+      // The sorted arrays become the index itself.
+      RadixSortIndex(fN, tmp_major, tmp_minor, fIndex);
+      fIndexValues = tmp_major;
+      fIndexValuesMinor = tmp_minor;
+   } else {
+      std::sort(fIndex, fIndex + fN, IndexSortComparator(tmp_major, tmp_minor) );
+      //TMath::Sort(fN,w,fIndex,0);
+      fIndexValues = new Long64_t[fN];
+      fIndexValuesMinor = new Long64_t[fN];
+      for (i=0;i<fN;i++) {
+         fIndexValues[i] = tmp_major[fIndex[i]];
+         fIndexValuesMinor[i] = tmp_minor[fIndex[i]];
+      }
 
-   delete [] tmp_major;
-   delete [] tmp_minor;
+      delete [] tmp_major;
+      delete [] tmp_minor;
+   }
    fTree->LoadTree(oldEntry);
 }
 
@@ -77,6 +77,24 @@ ReadTotal +ReadTotal*Readextra/100. Same for ReadSize.
 A consequence of NOTE1, the Disk I/O speed corresponds to the effective
 number of bytes returned to the application per second.
 The Physical disk speed is DiskIO + DiskIO*ReadExtra/100.
+
+ ### Branches and timeline
+The time spent by each branch unzipping its baskets and deserializing its
+entries is recorded as well; `Print("branch")` shows it. The file reads,
+the fills of the TTreeCache, the tasks of TTreeCacheUnzip and the tasks of
+TTree::GetEntry reading the branches in parallel make up a timeline of each
+thread. The timeline is recorded only after a call to SetTimelineSize, which
+also bounds the number of tasks it keeps. SaveTrace writes both in the JSON
+format of the Chrome trace events, which can be loaded in `chrome://tracing`
+or https://ui.perfetto.dev:
+~~~{.cpp}
+   ps->SetTimelineSize();
+   ...
+   ps->SaveTrace("cmsperf.json");
+~~~
+Baskets unzipped ahead by the tasks of TTreeCacheUnzip are not accounted to
+their branch, only to the timeline of the tasks. Unlike the rest of the
+object, the branch counters and the timeline are not saved by SaveAs.
 */
 
 #include "TTreePerfStats.h"
@@ -86,6 +104,7 @@ The Physical disk speed is DiskIO + DiskIO*ReadExtra/100.
 #include "TFile.h"
 #include "TTree.h"
 #include "TTreeCache.h"
+#include "TTreeCacheUnzip.h"
 #include "TAxis.h"
 #include "TBrowser.h"
 #include "TVirtualPad.h"
@@ -97,8 +116,62 @@ The Physical disk speed is DiskIO + DiskIO*ReadExtra/100.
 #include "TDatime.h"
 #include "TMath.h"
 
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+
 ClassImp(TTreePerfStats);
 
+////////////////////////////////////////////////////////////////////////////////
+/// Number of the current thread in the timelines: threads are numbered in the
+/// order in which they first report an event.
+
+static Int_t R__GetThreadNumber()
+{
+   static std::atomic<Int_t> nthreads(0);
+   thread_local Int_t number = nthreads++;
+   return number;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a new serial number, identifying a TTreePerfStats in the caches of
+/// the threads even if another one is created at the same address.
+
+static ULong64_t R__GetPerfStatsSerial()
+{
+   static std::atomic<ULong64_t> serial(0);
+   return ++serial;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The entries read and the time spent reading them, of all the branches of a
+/// name, counted by BranchReadEvent without lock.  The time is in nanoseconds.
+
+struct TTreePerfStats::BranchReadCounters {
+   const std::string fName;
+   std::atomic<ULong64_t> fEntries{0};
+   std::atomic<ULong64_t> fReadTime{0};
+
+   BranchReadCounters(const std::string &name) : fName(name) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write s as a JSON string.
+
+static void R__WriteJSONString(std::ostream &out, const std::string &s)
+{
+   out << '"';
+   for (char c : s) {
+      if (c == '"' || c == '\\')
+         out << '\\' << c;
+      else if ((unsigned char)c < 0x20)
+         out << TString::Format("\\u%04x", (unsigned char)c);
+      else
+         out << c;
+   }
+   out << '"';
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// default constructor (used when reading an object only)
 
@@ -123,9 +196,13 @@ TTreePerfStats::TTreePerfStats() : TVirtualPerfStats()
    fCpuTime       = 0;
    fDiskTime      = 0;
    fUnzipTime     = 0;
+   fUnzipAhead    = 0;
+   fUnzipWasted   = 0;
+   fUnzipWaited   = 0;
    fCompress      = 0;
    fRealTimeAxis  = 0;
    fHostInfoText  = 0;
+   fSerial        = R__GetPerfStatsSerial();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -159,6 +236,9 @@ TTreePerfStats::TTreePerfStats(const char *name, TTree *T) : TVirtualPerfStats()
    fCpuTime       = 0;
    fDiskTime      = 0;
    fUnzipTime     = 0;
+   fUnzipAhead    = 0;
+   fUnzipWasted   = 0;
+   fUnzipWaited   = 0;
    fRealTimeAxis  = 0;
    fCompress      = (T->GetTotBytes()+0.00001)/T->GetZipBytes();
 
@@ -172,6 +252,9 @@ TTreePerfStats::TTreePerfStats(const char *name, TTree *T) : TVirtualPerfStats()
    TDatime dt;
    fHostInfo += TString::Format(" %s",dt.AsString());
    fHostInfoText   = 0;
+   fStartTime      = TTimeStamp();
+   fSerial         = R__GetPerfStatsSerial();
+   R__GetThreadNumber();
 
    gPerfStats = this;
 }
@@ -292,6 +375,7 @@ void TTreePerfStats::FileReadEvent(TFile *file, Int_t len, Double_t start)
       fGraphTime->SetPointError(np,0.001,dtime);
       fReadCalls++;
       fBytesRead += len;
+      AddTask("TFile::ReadBuffer", start, tnow);
    }
 }
 
@@ -312,6 +396,157 @@ void TTreePerfStats::UnzipEvent(TObject * tree, Long64_t /* pos */, Double_t sta
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Record the unzipping of a basket of a branch.
+/// -  start is the TimeStamp before unzip
+/// -  complen is the length of the basket in the file
+/// -  objlen is the length of the unzipped basket
+
+void TTreePerfStats::BranchUnzipEvent(TBranch *branch, Double_t start, Int_t complen, Int_t objlen)
+{
+   Double_t tnow = TTimeStamp();
+   std::lock_guard<std::mutex> lock(fEventMutex);
+   auto &info = GetBranchInfo(branch);
+   info.fBytesRead += complen;
+   info.fBytesUnzipped += objlen;
+   ++info.fBaskets;
+   info.fUnzipTime += tnow - start;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record the deserialization of an entry of a branch.
+/// -  start is the TimeStamp before the deserialization
+///
+/// This is called for every entry of every branch read, possibly by several
+/// threads at once: the counters of the branch are found through a cache of
+/// the thread and incremented atomically, without taking fEventMutex.
+
+void TTreePerfStats::BranchReadEvent(TBranch *branch, Double_t start)
+{
+   Double_t tnow = TTimeStamp();
+   auto &counters = GetBranchReadCounters(branch);
+   counters.fEntries.fetch_add(1, std::memory_order_relaxed);
+   counters.fReadTime.fetch_add((ULong64_t)(1e9 * (tnow - start)), std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record a task run by the current thread, from start until now, in the timeline.
+
+void TTreePerfStats::TaskEvent(TObject * /* tree */, const char *name, Double_t start)
+{
+   AddTask(name, start, TTimeStamp());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a task of the current thread to the timeline.
+
+void TTreePerfStats::AddTask(const char *name, Double_t start, Double_t end)
+{
+   if (!fMaxTasks)
+      return;
+   const Int_t thread = R__GetThreadNumber();
+   std::lock_guard<std::mutex> lock(fEventMutex);
+   if ((Long64_t)fTasks.size() >= fMaxTasks) {
+      ++fDroppedTasks;
+      return;
+   }
+   fTasks.push_back({name, thread, start - fStartTime, end - start});
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record the timeline of the tasks of the threads, keeping at most maxTasks
+/// of them: once it is full, the next tasks are only counted (see
+/// GetNDroppedTasks). A maxTasks of 0 stops the recording; the timeline is
+/// not recorded by default.
+
+void TTreePerfStats::SetTimelineSize(Long64_t maxTasks)
+{
+   std::lock_guard<std::mutex> lock(fEventMutex);
+   fMaxTasks = maxTasks > 0 ? maxTasks : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the counters of a branch; fEventMutex must be held.  The branches
+/// of the successive trees of a chain share the counters of their name.
+
+TTreePerfStats::BranchInfo &TTreePerfStats::GetBranchInfo(TBranch *br)
+{
+   return fBranchInfo[GetBranchIndex(br)];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the counters of a branch in fBranchInfo, creating them
+/// if needed; fEventMutex must be held.
+
+size_t TTreePerfStats::GetBranchIndex(TBranch *br)
+{
+   auto iter = fBranchInfoIndex.find(br);
+   // The branch may have been deleted, and another one created at the same address.
+   if (iter != fBranchInfoIndex.end() && fBranchInfo[iter->second].fName == br->GetName())
+      return iter->second;
+
+   auto named = fBranchInfoByName.find(br->GetName());
+   size_t index;
+   if (named == fBranchInfoByName.end()) {
+      index = fBranchInfo.size();
+      fBranchInfo.emplace_back();
+      fBranchInfo.back().fName = br->GetName();
+      fBranchInfoByName.emplace(fBranchInfo.back().fName, index);
+      fBranchReadCounters.emplace_back(new BranchReadCounters(fBranchInfo.back().fName));
+   } else {
+      index = named->second;
+   }
+   fBranchInfoIndex[br] = index;
+   return index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the counters of BranchReadEvent for a branch.  Each thread caches
+/// them by branch: fEventMutex is only taken the first time a thread reads a
+/// branch.
+
+TTreePerfStats::BranchReadCounters &TTreePerfStats::GetBranchReadCounters(TBranch *br)
+{
+   struct ThreadCache {
+      ULong64_t fSerial = 0;
+      std::unordered_map<TBranch *, BranchReadCounters *> fCounters;
+   };
+   thread_local ThreadCache cache;
+   if (cache.fSerial != fSerial) {
+      cache.fCounters.clear();
+      cache.fSerial = fSerial;
+   }
+   auto &counters = cache.fCounters[br];
+   // The branch may have been deleted, and another one created at the same address.
+   if (!counters || counters->fName != br->GetName()) {
+      std::lock_guard<std::mutex> lock(fEventMutex);
+      counters = fBranchReadCounters[GetBranchIndex(br)].get();
+   }
+   return *counters;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the counters of BranchReadEvent to fBranchInfo; fEventMutex must be
+/// held.
+
+void TTreePerfStats::MergeBranchReadCounters() const
+{
+   for (size_t i = 0; i < fBranchInfo.size(); ++i) {
+      fBranchInfo[i].fEntries = fBranchReadCounters[i]->fEntries.load(std::memory_order_relaxed);
+      fBranchInfo[i].fReadTime = 1e-9 * fBranchReadCounters[i]->fReadTime.load(std::memory_order_relaxed);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the counters of the branches read.
+
+const std::vector<TTreePerfStats::BranchInfo> &TTreePerfStats::GetBranchesInfo() const
+{
+   std::lock_guard<std::mutex> lock(fEventMutex);
+   MergeBranchReadCounters();
+   return fBranchInfo;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// When the run is finished this function must be called
 /// to save the current parameters in the file and Tree in this object
@@ -327,6 +562,11 @@ void TTreePerfStats::Finish()
    fBytesReadExtra= fFile->GetBytesReadExtra();
    fRealTime      = fWatch->RealTime();
    fCpuTime       = fWatch->CpuTime();
+   if (auto unzipCache = dynamic_cast<TTreeCacheUnzip *>(fFile->GetCacheRead(fTree))) {
+      fUnzipAhead  = unzipCache->GetNUnzip();
+      fUnzipWasted = unzipCache->GetNWasted();
+      fUnzipWaited = unzipCache->GetNStalls();
+   }
    Int_t npoints  = fGraphIO->GetN();
    if (!npoints) return;
    Double_t iomax = TMath::MaxElement(npoints,fGraphIO->GetY());
@@ -522,6 +762,8 @@ void TTreePerfStats::Paint(Option_t *option)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Print the TTree I/O perf stats.
+/// The options "basket" and "branch" add the information on the baskets
+/// and the branches (see PrintBranchInfo).
 
 void TTreePerfStats::Print(Option_t * option) const
 {
@@ -529,6 +771,7 @@ void TTreePerfStats::Print(Option_t * option) const
    opts.ToLower();
    Bool_t unzip = opts.Contains("unzip");
    Bool_t basket = opts.Contains("basket");
+   Bool_t branch = opts.Contains("branch");
    TTreePerfStats *ps = (TTreePerfStats*)this;
    ps->Finish();
 
@@ -547,6 +790,11 @@ void TTreePerfStats::Print(Option_t * option) const
    if (unzip) {
       printf("Strm Time = %7.3f seconds\n",fCpuTime-fUnzipTime);
       printf("UnzipTime = %7.3f seconds\n",fUnzipTime);
+      if (fUnzipAhead) {
+         printf("UnzipAhead= %d baskets\n",fUnzipAhead);
+         printf("UnzipWaste= %d baskets\n",fUnzipWasted);
+         printf("UnzipWait = %d baskets\n",fUnzipWaited);
+      }
    }
    printf("Disk IO   = %7.3f MBytes/s\n",1e-6*fBytesRead/fDiskTime);
    printf("ReadUZRT  = %7.3f MBytes/s\n",1e-6*fCompress*fBytesRead/fRealTime);
@@ -559,6 +807,31 @@ void TTreePerfStats::Print(Option_t * option) const
    }
    if (basket)
       PrintBasketInfo(option);
+   if (branch)
+      PrintBranchInfo(option);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the counters of the branches, the slowest to read first.
+
+void TTreePerfStats::PrintBranchInfo(Option_t * /* option */) const
+{
+   std::vector<const BranchInfo *> infos;
+   {
+      std::lock_guard<std::mutex> lock(fEventMutex);
+      MergeBranchReadCounters();
+      for (auto &info : fBranchInfo)
+         infos.push_back(&info);
+   }
+   std::sort(infos.begin(), infos.end(), [](const BranchInfo *a, const BranchInfo *b) {
+      return a->fUnzipTime + a->fReadTime > b->fUnzipTime + b->fReadTime;
+   });
+   printf("%-30s %12s %12s %8s %10s %10s %10s\n", "Branch", "ReadBytes", "UnzipBytes", "Baskets", "UnzipTime",
+          "Entries", "ReadTime");
+   for (auto info : infos) {
+      printf("%-30s %12lld %12lld %8u %9.3fs %10llu %9.3fs\n", info->fName.c_str(), info->fBytesRead,
+             info->fBytesUnzipped, info->fBaskets, info->fUnzipTime, info->fEntries, info->fReadTime);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -637,6 +910,63 @@ void TTreePerfStats::SaveAs(const char *filename, Option_t * /*option*/) const
    ps->TObject::SaveAs(filename);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Write the timeline of the threads and the counters of the branches to
+/// filename, in the JSON format of the Chrome trace events.
+///
+/// The tasks are complete events ("ph": "X"), one row per thread; the
+/// timeline is empty unless SetTimelineSize was called before the reading.
+/// The counters of the branches are in the extra "branches" array, which trace
+/// viewers ignore. Return kFALSE if the file cannot be written.
+
+Bool_t TTreePerfStats::SaveTrace(const char *filename) const
+{
+   std::ofstream out(filename);
+   if (!out) {
+      Error("SaveTrace", "Cannot open %s", filename);
+      return kFALSE;
+   }
+
+   std::lock_guard<std::mutex> lock(fEventMutex);
+   std::vector<Int_t> threads;
+   for (auto &task : fTasks)
+      threads.push_back(task.fThread);
+   std::sort(threads.begin(), threads.end());
+   threads.erase(std::unique(threads.begin(), threads.end()), threads.end());
+
+   out << "{\"traceEvents\": [";
+   const char *sep = "\n";
+   for (auto thread : threads) {
+      out << sep << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << thread
+          << ", \"args\": {\"name\": \"thread " << thread << "\"}}";
+      sep = ",\n";
+   }
+   for (auto &task : fTasks) {
+      out << sep << "{\"name\": ";
+      R__WriteJSONString(out, task.fName);
+      out << ", \"cat\": \"io\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << task.fThread
+          << TString::Format(", \"ts\": %.3f, \"dur\": %.3f}", 1e6 * task.fStart, 1e6 * task.fDuration);
+      sep = ",\n";
+   }
+   out << "\n],\n\"displayTimeUnit\": \"ms\",\n\"otherData\": {\"name\": ";
+   R__WriteJSONString(out, fName.Data());
+   out << ", \"host\": ";
+   R__WriteJSONString(out, fHostInfo.Data());
+   out << ", \"droppedTasks\": " << fDroppedTasks << "},\n\"branches\": [";
+   sep = "\n";
+   MergeBranchReadCounters();
+   for (auto &info : fBranchInfo) {
+      out << sep << "{\"name\": ";
+      R__WriteJSONString(out, info.fName);
+      out << ", \"bytesRead\": " << info.fBytesRead << ", \"bytesUnzipped\": " << info.fBytesUnzipped
+          << ", \"baskets\": " << info.fBaskets << ", \"entries\": " << info.fEntries
+          << TString::Format(", \"unzipTime\": %g, \"readTime\": %g}", info.fUnzipTime, info.fReadTime);
+      sep = ",\n";
+   }
+   out << "\n]}\n";
+   return out.good();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Save primitive as a C++ statement(s) on output stream out
 
@@ -663,6 +993,9 @@ void TTreePerfStats::SavePrimitive(std::ostream &out, Option_t *option /*= ""*/)
    out<<"   ps->SetCpuTime("<<fCpuTime<<");"<<std::endl;
    out<<"   ps->SetDiskTime("<<fDiskTime<<");"<<std::endl;
    out<<"   ps->SetUnzipTime("<<fUnzipTime<<");"<<std::endl;
+   out<<"   ps->SetUnzipAhead("<<fUnzipAhead<<");"<<std::endl;
+   out<<"   ps->SetUnzipWasted("<<fUnzipWasted<<");"<<std::endl;
+   out<<"   ps->SetUnzipWaited("<<fUnzipWaited<<");"<<std::endl;
    out<<"   ps->SetCompress("<<fCompress<<");"<<std::endl;
 
    Int_t i, npoints = fGraphIO->GetN();
@@ -19,6 +19,15 @@ extra libraries (Histogram, display, etc).
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "Riostream.h"
 #include "TTreePlayer.h"
 #include "TROOT.h"
@@ -77,6 +86,10 @@ extra libraries (Histogram, display, etc).
 #include "TTreeCache.h"
 #include "TStyle.h"
 #include "TVirtualMutex.h"
+#include "TTreeReader.h"
+#ifdef R__USE_IMT
+#include "ROOT/TTreeProcessorMT.hxx"
+#endif
 
 #include "HFitInterface.h"
 #include "Foption.h"
@@ -2201,6 +2214,123 @@ Long64_t TTreePlayer::Process(const char *filename,Option_t *option, Long64_t ne
    return nsel;
 }
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Deactivation by TTreePlayer::Process of the branches that the selector does
+/// not read (see TTree::SetAutoBranchActivation).
+///
+/// A branch counts as read if its read entry (TBranch::GetReadEntry) changes
+/// while the selector processes one of the first entries.  The branches are
+/// told apart by their path in the tree, so that the trees of a chain loaded
+/// later get the same branches deactivated.
+
+class TAutoBranchActivation {
+   struct TBranchInfo {
+      TBranch *fBranch;
+      std::string fPath;
+      Int_t fParent;       // Index of the parent branch, -1 for a top-level branch
+      Long64_t fReadEntry; // Read entry of the branch when the tree was loaded, kRead once read
+   };
+
+   TTree *fTree;                        // The tree or chain being processed
+   Long64_t fLearnEntries;              // Number of entries to watch
+   Long64_t fNEntries = 0;              // Number of entries watched so far
+   Int_t fTreeNumber = -1;              // Number of the tree of fBranches
+   std::vector<TBranchInfo> fBranches;  // All the branches of the current tree, parents before their sub-branches
+   std::map<TBranch *, Int_t> fIndex;   // Index of each branch in fBranches
+   std::set<std::string> fRead;         // Paths of the branches read
+
+   static constexpr Long64_t kRead = -2;
+
+   void AddBranches(TObjArray *branches, const std::string &prefix, Int_t parent)
+   {
+      for (Int_t i = 0, n = branches->GetEntriesFast(); i < n; ++i) {
+         TBranch *branch = static_cast<TBranch *>(branches->UncheckedAt(i));
+         const Int_t index = fBranches.size();
+         fBranches.push_back({branch, prefix + branch->GetName(), parent, branch->GetReadEntry()});
+         fIndex[branch] = index;
+         AddBranches(branch->GetListOfBranches(), fBranches.back().fPath + "/", index);
+      }
+   }
+
+   void Deactivate()
+   {
+      // A branch is needed if it, or one of its sub-branches, was read.
+      std::vector<char> read(fBranches.size(), 0);
+      for (Int_t i = fBranches.size() - 1; i >= 0; --i) {
+         read[i] |= fRead.count(fBranches[i].fPath) != 0;
+         if (read[i] && fBranches[i].fParent >= 0)
+            read[fBranches[i].fParent] = 1;
+      }
+      Int_t ndeactivated = 0;
+      for (std::size_t i = 0; i < fBranches.size(); ++i) {
+         TBranch *branch = fBranches[i].fBranch;
+         if (read[i] || branch->TestBit(kDoNotProcess))
+            continue;
+         branch->SetAutoDeactivated();
+         ++ndeactivated;
+      }
+      if (gDebug > 0)
+         ::Info("TTreePlayer::Process", "%d of the %d branches of tree %d are not read and deactivated", ndeactivated,
+                (Int_t)fBranches.size(), fTreeNumber);
+   }
+
+public:
+   TAutoBranchActivation(TTree *tree, Long64_t learnEntries) : fTree(tree), fLearnEntries(learnEntries) {}
+
+   /// Reactivate the branches of the current tree.
+   ~TAutoBranchActivation()
+   {
+      if (!fTree->GetTree() || fTreeNumber != fTree->GetTreeNumber())
+         return;
+      for (auto &info : fBranches)
+         if (info.fBranch->IsAutoDeactivated())
+            info.fBranch->SetAutoDeactivated(kFALSE);
+   }
+
+   /// To be called once the tree of the next entry is loaded.
+   void TreeLoaded()
+   {
+      if (fTreeNumber == fTree->GetTreeNumber())
+         return;
+      fTreeNumber = fTree->GetTreeNumber();
+      fBranches.clear();
+      fIndex.clear();
+      AddBranches(fTree->GetTree()->GetListOfBranches(), "", -1);
+      if (fNEntries >= fLearnEntries)
+         Deactivate();
+   }
+
+   /// To be called once the selector has processed an entry.
+   void EntryProcessed()
+   {
+      if (fNEntries >= fLearnEntries)
+         return;
+      for (auto &info : fBranches) {
+         TBranch *branch = info.fBranch;
+         if (info.fReadEntry == kRead || branch->TestBit(kDoNotProcess) || branch->GetReadEntry() == info.fReadEntry)
+            continue;
+         info.fReadEntry = kRead;
+         fRead.insert(info.fPath);
+         // The branch of a leaf count is needed to read the leaf.
+         TObjArray *leaves = branch->GetListOfLeaves();
+         for (Int_t i = 0, n = leaves->GetEntriesFast(); i < n; ++i) {
+            TLeaf *leafcount = static_cast<TLeaf *>(leaves->UncheckedAt(i))->GetLeafCount();
+            auto count = leafcount ? fIndex.find(leafcount->GetBranch()) : fIndex.end();
+            if (count != fIndex.end())
+               fRead.insert(fBranches[count->second].fPath);
+         }
+      }
+      if (++fNEntries == fLearnEntries)
+         Deactivate();
+   }
+};
+
+constexpr Long64_t TAutoBranchActivation::kRead;
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Process this tree executing the code in the specified selector.
 /// The return value is -1 in case of error and TSelector::GetStatus() in
@@ -2284,19 +2414,38 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
       fSelectorUpdate = selector;
       UpdateFormulaLeaves();
 
+      // TTree::Draw of a histogram: once its binning is known, the remaining entries
+      // may be processed in parallel (see ProcessDrawMT).
+      Bool_t drawMT = selector == fSelector && CanProcessDrawMT(nentries);
+
+      // Deactivate the branches that the selector does not read, see TTree::SetAutoBranchActivation.
+      std::unique_ptr<TAutoBranchActivation> autoActivation;
+      const Long64_t learnEntries = fTree->GetAutoBranchActivation();
+      if (selector != fSelector && learnEntries > 0 && learnEntries < nentries)
+         autoActivation.reset(new TAutoBranchActivation(fTree, learnEntries));
+
       for (entry=firstentry;entry<firstentry+nentries;entry++) {
+         // An automatic binning is computed, as in the sequential processing, from the
+         // first GetEstimate() selected values: the selector is not parallel until then.
+         if (drawMT && fSelector->CanProcessMT()) {
+            if (ProcessDrawMT(entry, firstentry + nentries))
+               break;
+            drawMT = kFALSE;
+         }
          entryNumber = fTree->GetEntryNumber(entry);
          if (entryNumber < 0) break;
          if (timer && timer->ProcessEvents()) break;
          if (gROOT->IsInterrupted()) break;
          localEntry = fTree->LoadTree(entryNumber);
          if (localEntry < 0) break;
+         if (autoActivation) autoActivation->TreeLoaded();
          if(useCutFill) {
             if (selector->ProcessCut(localEntry))
                selector->ProcessFill(localEntry); //<==call user analysis function
          } else {
             selector->Process(localEntry);        //<==call user analysis function
          }
+         if (autoActivation) autoActivation->EntryProcessed();
          if (gMonitoringWriter)
             gMonitoringWriter->SendProcessingProgress((entry-firstentry),TFile::GetFileBytesRead()-readbytesatstart,kTRUE);
          if (selector->GetAbort() == TSelector::kAbortProcess) break;
@@ -2334,6 +2483,104 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
    return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if TTree::Draw may process its entries in parallel (see
+/// ProcessDrawMT): implicit multi-threading must be enabled, the tree must be
+/// read from files and have no entry list, and there must be more entries
+/// than TTree::GetEstimate(), i.e. more than what GetV1() and the other
+/// arrays of values can hold anyway.
+
+Bool_t TTreePlayer::CanProcessDrawMT(Long64_t nentries) const
+{
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled() || nentries <= fTree->GetEstimate() || fTree->GetEntryList())
+      return kFALSE;
+   if (fTree->TestBit(TChain::kGlobalWeight) || fTree->GetWeight() != 1)
+      return kFALSE;
+   if (!fTree->InheritsFrom(TChain::Class())) {
+      // The tree being written cannot be read again from its file.
+      TFile *file = fTree->GetCurrentFile();
+      if (!file || file->IsWritable())
+         return kFALSE;
+   }
+   return kTRUE;
+#else
+   (void)nentries;
+   return kFALSE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Process the entries [begin, end) of TTree::Draw in parallel with a
+/// ROOT::TTreeProcessorMT.  Each thread fills its own copy of the histogram of
+/// fSelector through a worker TSelectorDraw (see TSelectorDraw::InitWorker)
+/// and the copies are merged into the histogram at the end.  Return kFALSE,
+/// with nothing added to the histogram, if the parallel processing cannot be
+/// set up or if the expressions cannot be compiled for one of the trees: the
+/// entries are then processed sequentially.
+
+Bool_t TTreePlayer::ProcessDrawMT(Long64_t begin, Long64_t end)
+{
+#ifdef R__USE_IMT
+   std::unique_ptr<ROOT::TTreeProcessorMT> processor;
+   try {
+      processor.reset(new ROOT::TTreeProcessorMT(*fTree));
+   } catch (const std::exception &) {
+      return kFALSE;
+   }
+   processor->SetEntriesRange(begin, end);
+
+   // One worker per thread; the formulas are compiled one worker at a time.
+   std::mutex workersMutex;
+   std::map<std::thread::id, std::unique_ptr<TSelectorDraw>> workers;
+   std::atomic<bool> failed(false);
+   processor->Process([&](TTreeReader &reader) {
+      if (failed)
+         return;
+      TTree *tree = reader.GetTree();
+      TSelectorDraw *worker = nullptr;
+      Int_t treeNumber = -1;
+      while (reader.Next()) {
+         if (!worker) {
+            // The formulas are bound to the tree of the first entry of the range.
+            std::lock_guard<std::mutex> lock(workersMutex);
+            auto &slot = workers[std::this_thread::get_id()];
+            if (!slot) slot.reset(new TSelectorDraw());
+            worker = slot.get();
+            if (worker->GetTree() != tree && !worker->InitWorker(*fSelector, tree)) {
+               failed = true;
+               return;
+            }
+         }
+         if (treeNumber != tree->GetTreeNumber()) {
+            treeNumber = tree->GetTreeNumber();
+            worker->Notify();
+         }
+         worker->ProcessFill(tree->GetTree()->GetReadEntry());
+      }
+      // The tree of the reader does not outlive the task: nothing may stay buffered for it.
+      if (worker)
+         worker->FlushBuffer();
+   });
+
+   if (failed) {
+      // The histogram of fSelector is untouched: its entries are all processed sequentially.
+      for (auto &worker : workers)
+         delete worker.second->GetObject();
+      return kFALSE;
+   }
+   TList list;
+   for (auto &worker : workers)
+      list.Add(worker.second.get());
+   fSelector->MergeWorkers(list);
+   return kTRUE;
+#else
+   (void)begin;
+   (void)end;
+   return kFALSE;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// cleanup pointers in the player pointing to obj
 
@@ -2566,6 +2813,9 @@ Long64_t TTreePlayer::Scan(const char *varexp, const char *selection,
       if (!select) return -1;
       if (!select->GetNdim()) { delete select; return -1; }
       fFormulaList->Add(select);
+      // Most of the entries are only tested against the selection.
+      const Long64_t jitMinEntries = TTreeFormula::GetJitMinEntries();
+      if (jitMinEntries >= 0 && nentries >= jitMinEntries) select->JitCompile();
    }
 //*-*- if varexp is empty, take first 8 columns by default
    int allvar = 0;
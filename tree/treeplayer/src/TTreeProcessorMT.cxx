@@ -22,12 +22,23 @@ The implementation of ROOT::TTreeProcessorMT parallelizes the processing of the
 each corresponding to a cluster in the TTree. This is possible thanks to the use
 of a ROOT::TThreadedObject, so that each thread works with its own TFile and TTree
 objects.
+
+All workers take subranges from a single queue, whatever the file they belong to. The clusters of
+a file are retrieved by one of the workers while the others keep processing the subranges already
+in the queue. Once the clusters of all files are known, subranges that are taken from a queue that
+holds fewer subranges than workers are split further, so that no worker stays idle while a few
+large clusters are processed.
 */
 
 #include "TROOT.h"
 #include "ROOT/TTreeProcessorMT.hxx"
 #include "ROOT/TThreadExecutor.hxx"
 
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
+
 using namespace ROOT;
 
 namespace ROOT {
@@ -42,6 +53,90 @@ struct EntryCluster {
    Long64_t end;
 };
 
+/// A range of entries of one of the input files, processed by a single task
+struct FileEntryRange {
+   std::size_t fileIdx;
+   EntryCluster range;
+};
+
+/// Entry ranges are not split in sub-ranges smaller than this
+static constexpr Long64_t kMinEntriesPerSubRange = 1000ll;
+
+/// The queue of entry ranges from which all TTreeProcessorMT workers take their work items.
+/// Workers process ranges of any file; when the queue runs low, one of them retrieves the clusters of the next input
+/// file while the others keep processing. Once all clusters are known, ranges taken from a queue with fewer ranges than
+/// workers are split in equal sub-ranges.
+class EntryRangeQueue {
+   std::deque<FileEntryRange> fRanges;
+   std::size_t fNextFile = 0u;     ///< Index of the next file whose clusters must be retrieved
+   const std::size_t fNFiles;      ///< Number of files whose clusters are retrieved by the workers
+   unsigned int fNPendingFiles = 0u; ///< Number of files whose clusters are being retrieved
+   const unsigned int fNWorkers;
+   std::mutex fMutex;
+   std::condition_variable fCondVar;
+
+   /// Split `r` so that no worker stays idle, enqueueing all sub-ranges but the first. Called with fMutex locked.
+   void Split(FileEntryRange &r)
+   {
+      const auto nIdleWorkers = fNWorkers > fRanges.size() ? fNWorkers - fRanges.size() : 0u;
+      const auto nEntries = r.range.end - r.range.start;
+      const auto nSubRanges = std::min<Long64_t>(nIdleWorkers, nEntries / kMinEntriesPerSubRange);
+      if (nSubRanges < 2)
+         return;
+      const auto subRangeSize = nEntries / nSubRanges;
+      // enqueue sub-ranges at the front, last to first, so that entries are still processed roughly in order
+      for (auto i = nSubRanges - 1; i > 0; --i) {
+         const auto start = r.range.start + i * subRangeSize;
+         const auto end = i == nSubRanges - 1 ? r.range.end : start + subRangeSize;
+         fRanges.emplace_front(FileEntryRange{r.fileIdx, EntryCluster{start, end}});
+      }
+      r.range.end = r.range.start + subRangeSize;
+      fCondVar.notify_all();
+   }
+
+public:
+   enum class ENext { kProcessRange, kRetrieveClusters, kDone };
+
+   EntryRangeQueue(std::size_t nFiles, unsigned int nWorkers) : fNFiles(nFiles), fNWorkers(std::max(nWorkers, 1u)) {}
+
+   /// Enqueue the ranges of file `fileIdx`. If they were retrieved by a worker, the file is not pending anymore.
+   void Push(std::size_t fileIdx, const std::vector<EntryCluster> &clusters, bool wasPending)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      for (const auto &c : clusters)
+         fRanges.emplace_back(FileEntryRange{fileIdx, c});
+      if (wasPending)
+         --fNPendingFiles;
+      fCondVar.notify_all();
+   }
+
+   /// Tell the calling worker what to do next: process `range`, retrieve the clusters of file `fileIdx`, or stop.
+   ENext Next(FileEntryRange &range, std::size_t &fileIdx)
+   {
+      std::unique_lock<std::mutex> lock(fMutex);
+      while (true) {
+         const bool filesLeft = fNextFile < fNFiles;
+         // retrieve the clusters of the next file before the queue empties, one file at a time
+         if (filesLeft && (fRanges.empty() || (fNPendingFiles == 0u && fRanges.size() < fNWorkers))) {
+            fileIdx = fNextFile++;
+            ++fNPendingFiles;
+            return ENext::kRetrieveClusters;
+         }
+         if (!fRanges.empty()) {
+            range = fRanges.front();
+            fRanges.pop_front();
+            if (!filesLeft && fNPendingFiles == 0u)
+               Split(range);
+            return ENext::kProcessRange;
+         }
+         if (fNPendingFiles == 0u)
+            return ENext::kDone;
+         // other workers are retrieving the clusters of the last files
+         fCondVar.wait(lock);
+      }
+   }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Construct fChain, also adding friends if needed and injecting knowledge of offsets if available.
 void TTreeView::MakeChain(const std::string &treeName, const std::vector<std::string> &fileNames,
@@ -101,18 +196,16 @@ TTreeView::MakeReaderWithEntryList(TEntryList &globalList, Long64_t start, Long6
    auto localList = std::make_unique<TEntryList>();
 
    for (auto gl : globalEntryLists) {
-      Long64_t entry = gl->GetEntry(0);
-
       // this may be owned by the local list
-      auto tmp_list = new TEntryList(gl->GetName(), gl->GetTitle(), gl->GetFileName(), gl->GetTreeName());
+      auto tmp_list = new TEntryList(gl->GetName(), gl->GetTitle(), gl->GetTreeName(), gl->GetFileName());
+      // Intersect matches the lists by tree and file name: use exactly those of the global list.
+      tmp_list->SetTreeName(gl->GetTreeName());
+      tmp_list->SetFileName(gl->GetFileName());
 
-      do {
-         if (entry >= end) {
-            break;
-         } else if (entry >= start) {
-            tmp_list->Enter(entry);
-         }
-      } while ((entry = gl->Next()) >= 0);
+      // Select [start, end) and mask it with the global list, block by block: this only
+      // touches the blocks in the range instead of iterating over all the entries.
+      tmp_list->EnterRange(start, end);
+      tmp_list->Intersect(gl);
 
       if (tmp_list->GetN() > 0) {
          localList->Add(tmp_list);
@@ -140,7 +233,8 @@ TTreeView::GetTreeReader(Long64_t start, Long64_t end, const std::string &treeNa
                          const std::vector<Long64_t> &nEntries, const std::vector<std::vector<Long64_t>> &friendEntries)
 {
    const bool usingLocalEntries = friendInfo.fFriendNames.empty() && entryList.GetN() == 0;
-   if (fChain == nullptr || (usingLocalEntries && fileNames[0] != fChain->GetListOfFiles()->At(0)->GetTitle()))
+   if (fChain == nullptr || static_cast<std::size_t>(fChain->GetListOfFiles()->GetEntries()) != fileNames.size() ||
+       (usingLocalEntries && fileNames[0] != fChain->GetListOfFiles()->At(0)->GetTitle()))
       MakeChain(treeName, fileNames, friendInfo, nEntries, friendEntries);
 
    std::unique_ptr<TTreeReader> reader;
@@ -157,9 +251,11 @@ TTreeView::GetTreeReader(Long64_t start, Long64_t end, const std::string &treeNa
 
 ////////////////////////////////////////////////////////////////////////
 /// Return a vector of cluster boundaries for the given tree and files.
+/// Files are opened until the global entry `maxEntry` is reached: the returned vectors only cover the files opened.
 // EntryClusters and number of entries per file
 using ClustersAndEntries = std::pair<std::vector<std::vector<EntryCluster>>, std::vector<Long64_t>>;
-static ClustersAndEntries MakeClusters(const std::string &treeName, const std::vector<std::string> &fileNames)
+static ClustersAndEntries MakeClusters(const std::string &treeName, const std::vector<std::string> &fileNames,
+                                       Long64_t maxEntry = std::numeric_limits<Long64_t>::max())
 {
    // Note that as a side-effect of opening all files that are going to be used in the
    // analysis once, all necessary streamers will be loaded into memory.
@@ -170,6 +266,8 @@ static ClustersAndEntries MakeClusters(const std::string &treeName, const std::v
    entriesPerFile.reserve(nFileNames);
    Long64_t offset = 0ll;
    for (const auto &fileName : fileNames) {
+      if (offset >= maxEntry)
+         break;
       auto fileNameC = fileName.c_str();
       std::unique_ptr<TFile> f(TFile::Open(fileNameC)); // need TFile::Open to load plugins if need be
       if (!f || f->IsZombie()) {
@@ -252,6 +350,22 @@ static ClustersAndEntries MakeClusters(const std::string &treeName, const std::v
    return std::make_pair(std::move(eventRangesPerFile), std::move(entriesPerFile));
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Restrict clusters with global entry numbers to the [begin, end) range of global entries.
+static void ClipClusters(std::vector<std::vector<EntryCluster>> &clustersPerFile, Long64_t begin, Long64_t end)
+{
+   for (auto &clusters : clustersPerFile) {
+      std::vector<EntryCluster> clipped;
+      for (const auto &c : clusters) {
+         const auto start = std::max(c.start, begin);
+         const auto stop = std::min(c.end, end);
+         if (start < stop)
+            clipped.emplace_back(EntryCluster{start, stop});
+      }
+      clusters = std::move(clipped);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// Return a vector containing the number of entries of each file of each friend TChain
 static std::vector<std::vector<Long64_t>>
@@ -480,55 +594,96 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    const std::vector<Internal::NameAlias> &friendNames = fFriendInfo.fFriendNames;
    const std::vector<std::vector<std::string>> &friendFileNames = fFriendInfo.fFriendFileNames;
 
-   // If an entry list or friend trees are present, we need to generate clusters with global entry numbers,
-   // so we do it here for all files.
+   // If an entry list, friend trees or a range of entries are present, we need to generate clusters with global
+   // entry numbers, so we do it here for all files (or for all files up to the end of the range).
    const bool hasFriends = !friendNames.empty();
    const bool hasEntryList = fEntryList.GetN() > 0;
-   const bool shouldRetrieveAllClusters = hasFriends || hasEntryList;
-   const auto clustersAndEntries =
-      shouldRetrieveAllClusters ? Internal::MakeClusters(fTreeName, fFileNames) : Internal::ClustersAndEntries{};
+   const bool shouldRetrieveAllClusters = hasFriends || hasEntryList || fHasEntriesRange;
+   auto clustersAndEntries = shouldRetrieveAllClusters
+                                ? Internal::MakeClusters(fTreeName, fFileNames, fEndEntry)
+                                : Internal::ClustersAndEntries{};
+   if (fHasEntriesRange)
+      Internal::ClipClusters(clustersAndEntries.first, fBeginEntry, fEndEntry);
    const auto &clusters = clustersAndEntries.first;
    const auto &entries = clustersAndEntries.second;
+   // With global entry numbers, the chains only need to contain the files that have been opened
+   const std::vector<std::string> allFiles(fFileNames.begin(),
+                                           fFileNames.begin() + (shouldRetrieveAllClusters ? entries.size() : 0u));
 
    // Retrieve number of entries for each file for each friend tree
    const auto friendEntries =
       hasFriends ? Internal::GetFriendEntries(friendNames, friendFileNames) : std::vector<std::vector<Long64_t>>{};
 
+   const auto nFiles = fFileNames.size();
    TThreadExecutor pool;
-   // Parent task, spawns tasks that process each of the entry clusters for each input file
-   using Internal::EntryCluster;
-   auto processFile = [&](std::size_t fileIdx) {
-      // theseFiles contains either all files or just the single file to process
-      const auto &theseFiles = shouldRetrieveAllClusters ? fFileNames : std::vector<std::string>({fFileNames[fileIdx]});
-      // Evaluate clusters (with local entry numbers) and number of entries for this file, if needed
-      const auto theseClustersAndEntries =
-         shouldRetrieveAllClusters ? Internal::ClustersAndEntries{} : Internal::MakeClusters(fTreeName, theseFiles);
-
-      // All clusters for the file to process, either with global or local entry numbers
-      const auto &thisFileClusters = shouldRetrieveAllClusters ? clusters[fileIdx] : theseClustersAndEntries.first[0];
-
-      // Either all number of entries or just the ones for this file
-      const auto &theseEntries =
-         shouldRetrieveAllClusters ? entries : std::vector<Long64_t>({theseClustersAndEntries.second[0]});
-
-      auto processCluster = [&](const Internal::EntryCluster &c) {
-         std::unique_ptr<TTreeReader> reader;
-         std::unique_ptr<TEntryList> elist;
-         std::tie(reader, elist) = fTreeView->GetTreeReader(c.start, c.end, fTreeName, theseFiles, fFriendInfo,
-                                                            fEntryList, theseEntries, friendEntries);
-         func(*reader);
-      };
+   // If all clusters are known in advance all ranges are enqueued now, otherwise workers retrieve them file by file
+   Internal::EntryRangeQueue queue(shouldRetrieveAllClusters ? 0u : nFiles, pool.GetPoolSize());
+   if (shouldRetrieveAllClusters) {
+      for (auto fileIdx = 0u; fileIdx < clusters.size(); ++fileIdx)
+         queue.Push(fileIdx, clusters[fileIdx], /*wasPending*/ false);
+   }
+   // Number of entries of each file, filled by the workers when clusters are retrieved file by file
+   std::vector<Long64_t> entriesPerFile(shouldRetrieveAllClusters ? 0u : nFiles, 0ll);
+
+   auto retrieveClusters = [&](std::size_t fileIdx) {
+      Internal::ClustersAndEntries theseClustersAndEntries;
+      try {
+         theseClustersAndEntries = Internal::MakeClusters(fTreeName, {fFileNames[fileIdx]});
+      } catch (...) {
+         // other workers might be waiting for this file: it must leave the pending state in any case
+         queue.Push(fileIdx, {}, /*wasPending*/ true);
+         throw;
+      }
+      entriesPerFile[fileIdx] = theseClustersAndEntries.second[0];
+      queue.Push(fileIdx, theseClustersAndEntries.first[0], /*wasPending*/ true);
+   };
 
-      pool.Foreach(processCluster, thisFileClusters);
+   auto processRange = [&](const Internal::FileEntryRange &r) {
+      // theseFiles contains either all files or just the file to which the range belongs
+      const auto &theseFiles =
+         shouldRetrieveAllClusters ? allFiles : std::vector<std::string>({fFileNames[r.fileIdx]});
+      // Either all number of entries or just the one of this file
+      const auto &theseEntries =
+         shouldRetrieveAllClusters ? entries : std::vector<Long64_t>({entriesPerFile[r.fileIdx]});
+      std::unique_ptr<TTreeReader> reader;
+      std::unique_ptr<TEntryList> elist;
+      std::tie(reader, elist) = fTreeView->GetTreeReader(r.range.start, r.range.end, fTreeName, theseFiles,
+                                                         fFriendInfo, fEntryList, theseEntries, friendEntries);
+      func(*reader);
    };
 
-   std::vector<std::size_t> fileIdxs(fFileNames.size());
-   std::iota(fileIdxs.begin(), fileIdxs.end(), 0u);
+   // Each worker takes work items from the queue until there are none left
+   auto worker = [&]() {
+      Internal::FileEntryRange range;
+      std::size_t fileIdx = 0u;
+      using ENext = Internal::EntryRangeQueue::ENext;
+      for (auto next = queue.Next(range, fileIdx); next != ENext::kDone; next = queue.Next(range, fileIdx)) {
+         if (next == ENext::kRetrieveClusters)
+            retrieveClusters(fileIdx);
+         else
+            processRange(range);
+      }
+   };
 
    // Enable this IMT use case (activate its locks)
    Internal::TParTreeProcessingRAII ptpRAII;
 
-   pool.Foreach(processFile, fileIdxs);
+   pool.Foreach(worker, std::max(pool.GetPoolSize(), 1u));
+}
+
+////////////////////////////////////////////////////////////////////////
+/// \brief Restrict the processing to a range of entries.
+/// \param[in] begin First entry to be processed.
+/// \param[in] end One past the last entry to be processed. If not positive, entries are processed up to the last one.
+///
+/// Entry numbers are global, i.e. they refer to the chain of all input files. Files that only contain entries
+/// beyond `end` are never opened. The TTreeReader passed to the user function is then
+/// associated to a chain of the input files, so that its current entry is a global entry number.
+void TTreeProcessorMT::SetEntriesRange(Long64_t begin, Long64_t end)
+{
+   fHasEntriesRange = true;
+   fBeginEntry = begin > 0 ? begin : 0ll;
+   fEndEntry = end > 0 ? end : TTree::kMaxEntries;
 }
 
 ////////////////////////////////////////////////////////////////////////
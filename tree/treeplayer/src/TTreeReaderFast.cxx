@@ -115,6 +115,54 @@ TTreeReaderFast::SetEntry(Long64_t entry)
    return fEntryStatus;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Load the next batch of entries: the largest range of entries, following the
+/// current batch, that all the value readers hold in their buffers.
+///
+/// Returns the number of entries of the batch, 0 once all the entries have
+/// been read and -1 in case of error.  The entries of the batch are selected
+/// with SetBatchIndex(); TTreeReaderArrayFast also gives access to the values
+/// of the whole batch at once.
+///
+/// ~~~ {.cpp}
+/// TTreeReaderFast reader("T", file);
+/// TTreeReaderArrayFast<float> px(reader, "px");
+/// Int_t n;
+/// while ((n = reader.NextBatch()) > 0) {
+///    for (Int_t i = 0; i < n; ++i) {
+///       reader.SetBatchIndex(i);
+///       for (auto x : px) ...
+///    }
+/// }
+/// ~~~
+
+Int_t TTreeReaderFast::NextBatch()
+{
+   if (fBaseEvent < 0 && SetEntry(0) != TTreeReader::kEntryValid) {
+      return -1;
+   }
+   const Long64_t next = fBaseEvent < 0 ? 0 : fBaseEvent + fBatchSize;
+   fEvtIndex = 0;
+   fBatchSize = 0;
+   const Long64_t entries = fTree->GetEntries();
+   if (next >= entries) {
+      fEntryStatus = TTreeReader::kEntryNotFound;
+      return 0;
+   }
+   Int_t count = GetNextRange(next);
+   if (count <= 0) {
+      fEntryStatus = TTreeReader::kEntryBadReader;
+      return -1;
+   }
+   if (count > entries - next) {
+      count = entries - next;
+   }
+   fBaseEvent = next;
+   fBatchSize = count;
+   fEntryStatus = TTreeReader::kEntryValid;
+   return count;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Add a value reader for this tree.
 
@@ -13,6 +13,7 @@
 
 #include "TTreeReader.h"
 #include "TBranchClones.h"
+#include "TBufferFile.h"
 #include "TBranchElement.h"
 #include "TBranchRef.h"
 #include "TBranchSTL.h"
@@ -27,6 +28,11 @@
 #include "TStreamerInfo.h"
 #include "TStreamerElement.h"
 #include "TNtuple.h"
+#include "TDataType.h"
+#include "TMath.h"
+#include "ROOT/TBulkBranchRead.hxx"
+
+#include <cstring>
 #include <vector>
 
 // clang-format off
@@ -45,6 +51,53 @@
 */
 // clang-format on
 
+namespace ROOT {
+namespace Internal {
+
+/// The values of a simple branch of fundamental type, read one basket at a
+/// time through TBranch::GetBulkEntries() instead of one entry at a time
+/// through the TBranchProxy.
+class TTreeReaderValueBulkRead {
+public:
+   TBranch *fBranch = nullptr;  ///< The branch being read
+   Int_t fSize = 0;             ///< Size of a value
+   Bool_t fFailed = kFALSE;     ///< Whether the bulk API failed for this tree: the proxy is used instead
+   Long64_t fFirst = -1;        ///< First entry of the basket held in fBuffer
+   Long64_t fEnd = -1;          ///< Entry following the last one held in fBuffer
+   TBufferFile fBuffer{TBuffer::kWrite, 32 * 1024}; ///< Values of the basket, in native byte order
+   std::vector<Int_t> fOffsets; ///< Entry offsets filled by GetBulkEntries
+   alignas(8) char fValue[8];   ///< Copy of the value of the current entry
+
+   void Reset(TBranch *branch, Int_t size)
+   {
+      fBranch = branch;
+      fSize = size;
+      fFailed = kFALSE;
+      fFirst = fEnd = -1;
+   }
+
+   /// Read the basket holding the given entry; return false if the bulk API cannot be used.
+   Bool_t Load(Long64_t entry)
+   {
+      if (entry < 0) return kFALSE;
+      const Int_t basket = TMath::BinarySearch(fBranch->GetWriteBasket() + 1, fBranch->GetBasketEntry(), entry);
+      // Baskets which were never written (e.g. in-memory trees) are only reachable through GetEntry.
+      if (basket < 0 || !fBranch->GetBasketSeek(basket)) return kFALSE;
+      const Long64_t first = fBranch->GetBasketEntry()[basket];
+      const Int_t n = fBranch->GetBulkRead().GetBulkEntries(first, fBuffer, fOffsets);
+      if (n <= 0 || entry >= first + n) {
+         fFirst = fEnd = -1;
+         return kFALSE;
+      }
+      fFirst = first;
+      fEnd = first + n;
+      return kTRUE;
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
 ClassImp(ROOT::Internal::TTreeReaderValueBase);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -104,6 +157,9 @@ ROOT::Internal::TTreeReaderValueBase::operator=(const TTreeReaderValueBase& rhs)
       fSetupStatus = rhs.fSetupStatus;
       fReadStatus = rhs.fReadStatus;
       fStaticClassOffsets = rhs.fStaticClassOffsets;
+      fProxyReadFunc = &TTreeReaderValueBase::ProxyReadDefaultImpl;
+      if (fBulkRead)
+         fBulkRead->Reset(nullptr, 0);
    }
    return *this;
 }
@@ -113,6 +169,7 @@ ROOT::Internal::TTreeReaderValueBase::operator=(const TTreeReaderValueBase& rhs)
 
 ROOT::Internal::TTreeReaderValueBase::~TTreeReaderValueBase()
 {
+   delete fBulkRead;
    if (fTreeReader) fTreeReader->DeregisterValueReader(this);
    R__ASSERT((fLeafName.Length() == 0 ) == !fHaveLeaf
           && "leafness disagreement");
@@ -153,6 +210,11 @@ ROOT::Internal::TTreeReaderValueBase::ProxyReadDefaultImpl() {
    if (!fProxy) return kReadNothingYet;
    if (fProxy->IsInitialized() || fProxy->Setup()) {
 
+      if (SetupBulkRead()) {
+         fProxyReadFunc = &TTreeReaderValueBase::ProxyReadBulk;
+         return ProxyReadBulk();
+      }
+
       using EReadType = ROOT::Detail::TBranchProxy::EReadType;
       using TBranchPoxy = ROOT::Detail::TBranchProxy;
 
@@ -208,6 +270,70 @@ ROOT::Internal::TTreeReaderValueBase::ProxyReadDefaultImpl() {
    return fReadStatus;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the value of the current entry from the basket read in bulk, reading
+/// the next basket if needed.  If the bulk API fails, the TBranchProxy is used
+/// for the rest of the current tree.
+
+ROOT::Internal::TTreeReaderValueBase::EReadStatus
+ROOT::Internal::TTreeReaderValueBase::ProxyReadBulk() {
+   auto &bulk = *fBulkRead;
+   const Long64_t entry = fTreeReader->fDirector->GetReadEntry();
+   if (R__unlikely(entry < bulk.fFirst || entry >= bulk.fEnd)) {
+      if (!bulk.Load(entry)) {
+         bulk.fFailed = kTRUE;
+         fProxyReadFunc = &TTreeReaderValueBase::ProxyReadDefaultImpl;
+         return ProxyReadDefaultImpl();
+      }
+   }
+   memcpy(bulk.fValue, bulk.fBuffer.GetCurrent() + (entry - bulk.fFirst) * bulk.fSize, bulk.fSize);
+   fReadStatus = kReadSuccess;
+   return fReadStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Decide whether the values can be read with the bulk API of TBranch, which
+/// reads and byte-swaps a whole basket at once, and prepare for it.
+///
+/// This is the case for a top-level branch of the tree with a single leaf
+/// holding one value of the requested fundamental type per entry, provided
+/// that the leaf supports bulk reading.
+
+Bool_t ROOT::Internal::TTreeReaderValueBase::SetupBulkRead() {
+   if (!CanReadBulk() || fHaveLeaf || fHaveStaticClassOffsets || !fTreeReader || fProxy->IsaPointer())
+      return kFALSE;
+   if (fBulkRead && fBulkRead->fFailed)
+      return kFALSE;
+   auto dataType = dynamic_cast<TDataType *>(fDict);
+   if (!dataType)
+      return kFALSE;
+
+   TTree *tree = fTreeReader->fDirector->GetTree();
+   TBranch *branch = tree ? tree->GetBranch(fBranchName) : nullptr;
+   // Friend trees have entry numbers of their own.
+   if (!branch || branch->IsA() != TBranch::Class() || branch->GetTree() != tree || !branch->SupportsBulkRead())
+      return kFALSE;
+   auto leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->UncheckedAt(0));
+   if (leaf->GetLeafCount() || leaf->GetLenStatic() != 1)
+      return kFALSE;
+   TClass *cl = nullptr;
+   EDataType type = kOther_t;
+   if (branch->GetExpectedType(cl, type) || cl || type != dataType->GetType())
+      return kFALSE;
+   switch (type) {
+   case kChar_t: case kUChar_t: case kBool_t:
+   case kShort_t: case kUShort_t:
+   case kInt_t: case kUInt_t: case kFloat_t:
+   case kDouble_t: case kLong64_t: case kULong64_t: break;
+   default: return kFALSE;
+   }
+
+   if (!fBulkRead)
+      fBulkRead = new TTreeReaderValueBulkRead;
+   fBulkRead->Reset(branch, dataType->Size());
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Stringify the template argument.
 std::string ROOT::Internal::TTreeReaderValueBase::GetElementTypeName(const std::type_info& ti) {
@@ -225,6 +351,8 @@ void ROOT::Internal::TTreeReaderValueBase::NotifyNewTree(TTree* newTree) {
    // Since the TTree structure might have change, let's make sure we
    // use the right reading function.
    fProxyReadFunc = &TTreeReaderValueBase::ProxyReadDefaultImpl;
+   if (fBulkRead)
+      fBulkRead->Reset(nullptr, 0);
 
    if (!fHaveLeaf || !newTree) {
       fLeaf = nullptr;
@@ -251,6 +379,9 @@ void ROOT::Internal::TTreeReaderValueBase::NotifyNewTree(TTree* newTree) {
 void* ROOT::Internal::TTreeReaderValueBase::GetAddress() {
    if (ProxyRead() != kReadSuccess) return 0;
 
+   if (fProxyReadFunc == &TTreeReaderValueBase::ProxyReadBulk)
+      return fBulkRead->fValue;
+
    if (fHaveLeaf){
       if (GetLeaf()){
          return fLeaf->GetValuePointer();
@@ -443,6 +574,10 @@ void ROOT::Internal::TTreeReaderValueBase::CreateProxy() {
       return;
    }
 
+   fProxyReadFunc = &TTreeReaderValueBase::ProxyReadDefaultImpl;
+   if (fBulkRead)
+      fBulkRead->Reset(nullptr, 0);
+
    fSetupStatus = kSetupInternalError; // Fallback; set to something concrete below.
    if (!fTreeReader) {
       Error(errPrefix, "TTreeReader object not set / available for branch %s!",
@@ -0,0 +1,197 @@
+#include "TBranch.h"
+#include "TChain.h"
+#include "TFile.h"
+#include "TNamed.h"
+#include "TSelector.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+// A MakeClass-style selector: it reads `a` for every entry, and `c` for one entry only.
+class TSelectorReadSome : public TSelector {
+public:
+   TTree *fChain = nullptr;
+   Int_t fA = 0, fB = 0, fC = 0;
+   TBranch *fBranchA = nullptr;
+   TBranch *fBranchC = nullptr;
+   Long64_t fSumA = 0;
+   Int_t fValueC = -1;
+   Long64_t fEntries = 0;
+   Long64_t fRareEntry = 0;
+   Bool_t fStatusB = kTRUE;
+
+   int Version() const override { return 2; }
+   void Init(TTree *tree) override
+   {
+      fChain = tree;
+      fChain->SetBranchAddress("a", &fA, &fBranchA);
+      fChain->SetBranchAddress("b", &fB);
+      fChain->SetBranchAddress("c", &fC, &fBranchC);
+   }
+   Bool_t Process(Long64_t entry) override
+   {
+      fBranchA->GetEntry(entry);
+      fSumA += fA;
+      if (fEntries == fRareEntry) {
+         fBranchC->GetEntry(entry);
+         fValueC = fC;
+      }
+      if (++fEntries == fRareEntry - 1)
+         fStatusB = fChain->GetTree()->GetBranchStatus("b");
+      return kTRUE;
+   }
+};
+
+static const int kNFiles = 2;
+static const Long64_t kNEntries = 500; // per file
+
+class TTreeAutoBranchActivation : public ::testing::Test {
+protected:
+   static std::string FileName(int f) { return "autobranchactivation" + std::to_string(f) + ".root"; }
+
+   static void SetUpTestCase()
+   {
+      for (int f = 0; f < kNFiles; ++f) {
+         TFile file(FileName(f).c_str(), "RECREATE");
+         TTree tree("t", "t");
+         Int_t a, b, c;
+         tree.Branch("a", &a);
+         tree.Branch("b", &b);
+         tree.Branch("c", &c);
+         for (Long64_t i = 0; i < kNEntries; ++i) {
+            a = 1;
+            b = 2;
+            c = f * kNEntries + i;
+            tree.Fill();
+         }
+         file.Write();
+      }
+   }
+
+   static void TearDownTestCase()
+   {
+      for (int f = 0; f < kNFiles; ++f)
+         gSystem->Unlink(FileName(f).c_str());
+   }
+};
+
+TEST_F(TTreeAutoBranchActivation, Tree)
+{
+   TFile file(FileName(0).c_str());
+   auto tree = file.Get<TTree>("t");
+   tree->SetAutoBranchActivation(100);
+   EXPECT_EQ(tree->GetAutoBranchActivation(), 100);
+
+   TSelectorReadSome selector;
+   selector.fRareEntry = 300;
+   tree->Process(&selector);
+
+   EXPECT_EQ(selector.fSumA, kNEntries);
+   EXPECT_FALSE(selector.fStatusB);
+   // `c` is read after its deactivation: it is reactivated on the spot.
+   EXPECT_EQ(selector.fValueC, 300);
+   // Process reactivates the branches at the end.
+   EXPECT_TRUE(tree->GetBranchStatus("b"));
+   EXPECT_TRUE(tree->GetBranchStatus("c"));
+   EXPECT_FALSE(tree->GetBranch("b")->IsAutoDeactivated());
+}
+
+TEST_F(TTreeAutoBranchActivation, Chain)
+{
+   TChain chain("t");
+   for (int f = 0; f < kNFiles; ++f)
+      chain.Add(FileName(f).c_str());
+   chain.SetAutoBranchActivation(100);
+
+   // The deactivation applies to the trees loaded after the first one.
+   TSelectorReadSome selector;
+   selector.fRareEntry = kNEntries + 50;
+   chain.Process(&selector);
+
+   EXPECT_EQ(selector.fSumA, kNFiles * kNEntries);
+   EXPECT_FALSE(selector.fStatusB);
+   EXPECT_EQ(selector.fValueC, kNEntries + 50);
+   EXPECT_FALSE(chain.GetTree()->GetBranch("b")->IsAutoDeactivated());
+}
+
+TEST_F(TTreeAutoBranchActivation, Disabled)
+{
+   TFile file(FileName(0).c_str());
+   auto tree = file.Get<TTree>("t");
+   tree->SetAutoBranchActivation(0);
+
+   TSelectorReadSome selector;
+   selector.fRareEntry = 300;
+   tree->Process(&selector);
+   EXPECT_TRUE(selector.fStatusB);
+   EXPECT_EQ(selector.fValueC, 300);
+}
+
+// Reads `a` for every entry, and the object branch `obj` for one entry only.
+class TSelectorReadObject : public TSelector {
+public:
+   Int_t fA = 0;
+   TNamed *fObj = nullptr;
+   TBranch *fBranchA = nullptr;
+   TBranch *fBranchObj = nullptr;
+   std::string fTitle;
+   Long64_t fRareEntry = 0;
+
+   ~TSelectorReadObject() { delete fObj; }
+   int Version() const override { return 2; }
+   void Init(TTree *tree) override
+   {
+      tree->SetBranchAddress("a", &fA, &fBranchA);
+      tree->SetBranchAddress("obj", &fObj, &fBranchObj);
+   }
+   Bool_t Process(Long64_t entry) override
+   {
+      fBranchA->GetEntry(entry);
+      if (entry == fRareEntry) {
+         fBranchObj->GetEntry(entry);
+         fTitle = fObj->GetTitle();
+      }
+      return kTRUE;
+   }
+};
+
+TEST(TTreeAutoBranchActivationObject, TBranchObject)
+{
+   const char *fileName = "autobranchactivation_object.root";
+   {
+      TFile file(fileName, "RECREATE");
+      TTree tree("t", "t");
+      Int_t a;
+      auto obj = new TNamed("obj", "");
+      tree.Branch("a", &a);
+      // An unsplit object branch is a TBranchObject.
+      auto branch = tree.BranchOld("obj", "TNamed", &obj, 32000, 0);
+      ASSERT_TRUE(branch->InheritsFrom("TBranchObject"));
+      for (Int_t i = 0; i < 500; ++i) {
+         a = i;
+         obj->SetTitle(std::to_string(i).c_str());
+         tree.Fill();
+      }
+      file.Write();
+      tree.ResetBranchAddresses();
+      delete obj;
+   }
+
+   TFile file(fileName);
+   auto tree = file.Get<TTree>("t");
+   tree->SetAutoBranchActivation(100);
+
+   // `obj` is deactivated after the first 100 entries, and first read at entry 300.
+   TSelectorReadObject selector;
+   selector.fRareEntry = 300;
+   tree->Process(&selector);
+
+   EXPECT_EQ(selector.fTitle, "300");
+   EXPECT_FALSE(tree->GetBranch("obj")->IsAutoDeactivated());
+   EXPECT_TRUE(tree->GetBranchStatus("obj"));
+
+   gSystem->Unlink(fileName);
+}
@@ -0,0 +1,169 @@
+#include "TChain.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeReader.h"
+#include "TTreeReaderArray.h"
+#include "TTreeReaderValue.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+// TTreeReaderValue reads the simple branches of fundamental type (here `i` and `d`) one basket at a time
+// through the bulk API of TBranch; the other readers go through the TBranchProxy.
+
+// Fill `tree` with `n` entries, the first one numbered `first`. Small baskets give many baskets per tree.
+static void FillTree(TTree &tree, Long64_t first, Long64_t n, Int_t bufsize)
+{
+   Int_t i;
+   Double_t d;
+   std::vector<float> v;
+   struct {
+      Int_t a;
+      Float_t b;
+   } s;
+   tree.Branch("i", &i, bufsize);
+   tree.Branch("d", &d, bufsize);
+   tree.Branch("v", &v, bufsize);
+   tree.Branch("s", &s, "a/I:b/F", bufsize);
+   for (Long64_t e = first; e < first + n; ++e) {
+      i = e;
+      d = 0.5 * e;
+      v.assign(e % 3, e);
+      s.a = -e;
+      s.b = 2 * e;
+      tree.Fill();
+   }
+   tree.ResetBranchAddresses();
+}
+
+static void ExpectEntry(TTreeReaderValue<Int_t> &i, TTreeReaderValue<Double_t> &d, Long64_t e)
+{
+   ASSERT_EQ(*i, e);
+   ASSERT_EQ(*d, 0.5 * e);
+}
+
+static const Long64_t kNEntries0 = 1000;
+static const Long64_t kNEntries1 = 1500;
+
+class TTreeReaderBulk : public ::testing::Test {
+protected:
+   static std::string FileName(int f) { return "treereaderbulk" + std::to_string(f) + ".root"; }
+
+   static void SetUpTestCase()
+   {
+      // The baskets of the two trees do not have the same size.
+      {
+         TFile file(FileName(0).c_str(), "RECREATE");
+         TTree tree("t", "t");
+         FillTree(tree, 0, kNEntries0, 400);
+         file.Write();
+      }
+      {
+         TFile file(FileName(1).c_str(), "RECREATE");
+         TTree tree("t", "t");
+         FillTree(tree, kNEntries0, kNEntries1, 1000);
+         file.Write();
+      }
+   }
+
+   static void TearDownTestCase()
+   {
+      gSystem->Unlink(FileName(0).c_str());
+      gSystem->Unlink(FileName(1).c_str());
+   }
+};
+
+TEST_F(TTreeReaderBulk, ChainBoundary)
+{
+   TChain chain("t");
+   chain.Add(FileName(0).c_str());
+   chain.Add(FileName(1).c_str());
+   TTreeReader reader(&chain);
+   TTreeReaderValue<Int_t> i(reader, "i");
+   TTreeReaderValue<Double_t> d(reader, "d");
+
+   Long64_t e = 0;
+   while (reader.Next())
+      ExpectEntry(i, d, e++);
+   EXPECT_EQ(e, kNEntries0 + kNEntries1);
+
+   // Jump back and forth across the boundary between the trees.
+   for (Long64_t entry : {kNEntries0 - 1, kNEntries0, kNEntries0 + kNEntries1 - 1, Long64_t(17), kNEntries0 + 3,
+                          kNEntries0 - 2}) {
+      ASSERT_EQ(reader.SetEntry(entry), TTreeReader::kEntryValid);
+      ExpectEntry(i, d, entry);
+   }
+}
+
+TEST_F(TTreeReaderBulk, InMemoryTree)
+{
+   // None of the baskets was written: the values are read through the TBranchProxy.
+   TTree tree("t", "t");
+   tree.SetDirectory(nullptr);
+   FillTree(tree, 0, kNEntries0, 400);
+   {
+      TTreeReader reader(&tree);
+      TTreeReaderValue<Int_t> i(reader, "i");
+      TTreeReaderValue<Double_t> d(reader, "d");
+      Long64_t e = 0;
+      while (reader.Next())
+         ExpectEntry(i, d, e++);
+      EXPECT_EQ(e, kNEntries0);
+   }
+
+   // The full baskets were written but not the last ones, which are still in memory.
+   const auto fileName = "treereaderbulk_inmemory.root";
+   {
+      TFile file(fileName, "RECREATE");
+      TTree fileTree("t", "t");
+      FillTree(fileTree, 0, kNEntries0, 400);
+      ASSERT_NE(fileTree.GetBranch("i")->GetBasketSeek(0), 0);
+      ASSERT_EQ(fileTree.GetBranch("i")->GetBasketSeek(fileTree.GetBranch("i")->GetWriteBasket()), 0);
+
+      TTreeReader reader(&fileTree);
+      TTreeReaderValue<Int_t> i(reader, "i");
+      TTreeReaderValue<Double_t> d(reader, "d");
+      Long64_t e = 0;
+      while (reader.Next())
+         ExpectEntry(i, d, e++);
+      EXPECT_EQ(e, kNEntries0);
+      ASSERT_EQ(reader.SetEntry(3), TTreeReader::kEntryValid);
+      ExpectEntry(i, d, 3);
+   }
+   gSystem->Unlink(fileName);
+}
+
+TEST_F(TTreeReaderBulk, MixedReaders)
+{
+   TChain chain("t");
+   chain.Add(FileName(0).c_str());
+   chain.Add(FileName(1).c_str());
+   TTreeReader reader(&chain);
+   TTreeReaderValue<Int_t> i(reader, "i");
+   TTreeReaderValue<Double_t> d(reader, "d");
+   // Read through the TBranchProxy: a collection, leaves of a branch with several leaves, a second reader
+   // of `i` through its leaf.
+   TTreeReaderValue<std::vector<float>> v(reader, "v");
+   TTreeReaderArray<float> varray(reader, "v");
+   TTreeReaderValue<Int_t> a(reader, "s.a");
+   TTreeReaderValue<Float_t> b(reader, "s.b");
+   TTreeReaderValue<Int_t> ileaf(reader, "i.i");
+
+   Long64_t e = 0;
+   while (reader.Next()) {
+      // Read the values in an order which alternates between the bulk and the proxy readers.
+      ASSERT_EQ(*a, -e);
+      ExpectEntry(i, d, e);
+      ASSERT_EQ(v->size(), std::size_t(e % 3));
+      ASSERT_EQ(varray.GetSize(), std::size_t(e % 3));
+      for (auto x : varray)
+         ASSERT_EQ(x, float(e));
+      ASSERT_EQ(*b, 2.f * e);
+      ASSERT_EQ(*ileaf, e);
+      ++e;
+   }
+   EXPECT_EQ(e, kNEntries0 + kNEntries1);
+}
@@ -0,0 +1,137 @@
+#include "TChain.h"
+#include "TFile.h"
+#include "TH1.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+
+class TTreeDrawMT : public ::testing::Test {
+protected:
+   static constexpr const char *kFileName = "treedrawmt.root";
+   static const Long64_t kNEntries = 50000;
+
+   static void SetUpTestCase()
+   {
+      TFile f(kFileName, "RECREATE");
+      TTree t("t", "t");
+      Double_t x;
+      Int_t n;
+      t.Branch("x", &x);
+      t.Branch("n", &n);
+      t.SetAutoFlush(1000);
+      for (Long64_t i = 0; i < kNEntries; ++i) {
+         x = (i % 1000) * 0.01 - 3.;
+         n = i % 17;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   static void TearDownTestCase() { gSystem->Unlink(kFileName); }
+
+   // Draw `varexp` twice, sequentially and with implicit multi-threading.
+   static std::pair<std::unique_ptr<TH1>, std::unique_ptr<TH1>>
+   DrawTwice(const char *varexp, const char *selection, const char *hname)
+   {
+      std::unique_ptr<TH1> results[2];
+      for (int mt = 0; mt < 2; ++mt) {
+         if (mt)
+            ROOT::EnableImplicitMT(4);
+         TFile f(kFileName);
+         auto t = f.Get<TTree>("t");
+         // GetV1() can hold only a fraction of the values: the parallel path is allowed.
+         t->SetEstimate(1000);
+         const std::string name = std::string(hname) + std::to_string(mt);
+         const std::string target = std::string(varexp) + ">>" + name;
+         EXPECT_GT(t->Draw(target.c_str(), selection, "goff"), 0);
+         auto h = static_cast<TH1 *>(gDirectory->Get(name.c_str()));
+         EXPECT_NE(h, nullptr);
+         if (h) {
+            h->SetDirectory(nullptr);
+            results[mt].reset(h);
+         }
+         if (mt)
+            ROOT::DisableImplicitMT();
+      }
+      return {std::move(results[0]), std::move(results[1])};
+   }
+};
+
+TEST_F(TTreeDrawMT, FixedBinning)
+{
+   auto hs = DrawTwice("x", "n%3==0", "hfixed(40,-4,8)");
+   ASSERT_TRUE(hs.first && hs.second);
+   EXPECT_EQ(hs.first->GetEntries(), hs.second->GetEntries());
+   for (Int_t bin = 0; bin <= hs.first->GetNbinsX() + 1; ++bin)
+      EXPECT_EQ(hs.first->GetBinContent(bin), hs.second->GetBinContent(bin)) << "bin " << bin;
+}
+
+TEST_F(TTreeDrawMT, AutomaticBinning)
+{
+   auto hs = DrawTwice("x*n", "", "hauto");
+   ASSERT_TRUE(hs.first && hs.second);
+   EXPECT_EQ(hs.first->GetEntries(), hs.second->GetEntries());
+   EXPECT_DOUBLE_EQ(hs.first->GetSumOfWeights(), hs.second->GetSumOfWeights());
+   EXPECT_NEAR(hs.first->GetMean(), hs.second->GetMean(), 1e-6);
+}
+
+TEST_F(TTreeDrawMT, AutomaticBinningSelective)
+{
+   // The binning comes from the first 1000 selected values, which span many more entries.
+   auto hs = DrawTwice("x*n", "n==5", "hautosel");
+   ASSERT_TRUE(hs.first && hs.second);
+   EXPECT_EQ(hs.first->GetEntries(), hs.second->GetEntries());
+   EXPECT_EQ(hs.first->GetXaxis()->GetXmin(), hs.second->GetXaxis()->GetXmin());
+   EXPECT_EQ(hs.first->GetXaxis()->GetXmax(), hs.second->GetXaxis()->GetXmax());
+   for (Int_t bin = 0; bin <= hs.first->GetNbinsX() + 1; ++bin)
+      EXPECT_EQ(hs.first->GetBinContent(bin), hs.second->GetBinContent(bin)) << "bin " << bin;
+}
+
+TEST_F(TTreeDrawMT, MultiFileChain)
+{
+   // The threads move from the tree of one file to the next one: none of their fills may be lost.
+   const int kNFiles = 4;
+   for (int i = 0; i < kNFiles; ++i)
+      gSystem->CopyFile(kFileName, ("treedrawmt_chain" + std::to_string(i) + ".root").c_str(), kTRUE);
+
+   std::unique_ptr<TH1> results[2];
+   for (int mt = 0; mt < 2; ++mt) {
+      if (mt)
+         ROOT::EnableImplicitMT(4);
+      TChain chain("t");
+      chain.Add("treedrawmt_chain*.root");
+      // Buffers larger than the entries of a task.
+      chain.SetEstimate(20000);
+      const std::string name = "hchain" + std::to_string(mt);
+      EXPECT_GT(chain.Draw(("x>>" + name + "(40,-4,8)").c_str(), "n%2==0", "goff"), 0);
+      auto h = static_cast<TH1 *>(gDirectory->Get(name.c_str()));
+      EXPECT_NE(h, nullptr);
+      if (h) {
+         h->SetDirectory(nullptr);
+         results[mt].reset(h);
+      }
+      if (mt)
+         ROOT::DisableImplicitMT();
+   }
+   for (int i = 0; i < kNFiles; ++i)
+      gSystem->Unlink(("treedrawmt_chain" + std::to_string(i) + ".root").c_str());
+
+   ASSERT_TRUE(results[0] && results[1]);
+   EXPECT_EQ(results[0]->GetEntries(), results[1]->GetEntries());
+   for (Int_t bin = 0; bin <= results[0]->GetNbinsX() + 1; ++bin)
+      EXPECT_EQ(results[0]->GetBinContent(bin), results[1]->GetBinContent(bin)) << "bin " << bin;
+}
+
+TEST_F(TTreeDrawMT, TwoDimensions)
+{
+   auto hs = DrawTwice("x:n", "x>0", "h2d(17,0,17,20,-3,7)");
+   ASSERT_TRUE(hs.first && hs.second);
+   EXPECT_EQ(hs.first->GetEntries(), hs.second->GetEntries());
+   for (Int_t bin = 0; bin < hs.first->GetNcells(); ++bin)
+      EXPECT_EQ(hs.first->GetBinContent(bin), hs.second->GetBinContent(bin)) << "bin " << bin;
+}
@@ -0,0 +1,75 @@
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeFormula.h"
+
+#include "gtest/gtest.h"
+
+class TTreeFormulaJit : public ::testing::Test {
+protected:
+   static constexpr const char *kFileName = "treeformulajit.root";
+
+   static void SetUpTestCase()
+   {
+      TFile f(kFileName, "RECREATE");
+      TTree t("t", "t");
+      Double_t x;
+      Float_t y;
+      Int_t n;
+      Int_t arr[3];
+      t.Branch("x", &x);
+      t.Branch("y", &y);
+      t.Branch("n", &n);
+      t.Branch("arr", arr, "arr[3]/I");
+      for (Int_t i = 0; i < 200; ++i) {
+         x = (i - 100) * 0.37;
+         y = i % 7 - 3.5;
+         n = i;
+         arr[0] = i; arr[1] = -i; arr[2] = 2 * i;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   static void TearDownTestCase() { gSystem->Unlink(kFileName); }
+};
+
+TEST_F(TTreeFormulaJit, SameResultsAsInterpreter)
+{
+   TFile f(kFileName);
+   auto t = f.Get<TTree>("t");
+   const char *expressions[] = {"x*y+n",
+                                "x>0 && y<2",
+                                "x<-10 || !(n%3)",
+                                "sqrt(x)+log(y)+exp(x/10)-atan2(x,y)",
+                                "x/(n-100)",
+                                "n%7 + (n&5) + (n<<2) + (n>>1) + int(x) + sign(y) + abs(y)",
+                                "pow(x,2) - sq(y) + min(x,y)*max(x,y) + fmod(x,3.) + pi",
+                                "acos(y/4)+asin(y/4)+tan(x)+tanh(y)+acosh(x)+atanh(y/4)",
+                                "-x == n ? 1 : 2"};
+   for (auto expr : expressions) {
+      TTreeFormula interpreted("interpreted", expr, t);
+      TTreeFormula compiled("compiled", expr, t);
+      ASSERT_GT(compiled.GetNdim(), 0) << expr;
+      compiled.JitCompile();
+      for (Long64_t entry = 0; entry < t->GetEntries(); ++entry) {
+         t->LoadTree(entry);
+         const Double_t expected = interpreted.EvalInstance();
+         const Double_t value = compiled.EvalInstance();
+         ASSERT_TRUE(expected == value || (expected != expected && value != value))
+            << expr << " at entry " << entry << ": " << expected << " != " << value;
+      }
+   }
+}
+
+TEST_F(TTreeFormulaJit, Coverage)
+{
+   TFile f(kFileName);
+   auto t = f.Get<TTree>("t");
+   EXPECT_TRUE(TTreeFormula("f", "x*y>n && n!=3", t).JitCompile());
+   // Left to the interpreter: arrays, the ternary operator, special variables.
+   EXPECT_FALSE(TTreeFormula("f", "arr*x", t).JitCompile());
+   EXPECT_FALSE(TTreeFormula("f", "arr[1]+x", t).JitCompile());
+   EXPECT_FALSE(TTreeFormula("f", "x>0 ? y : n", t).JitCompile());
+   EXPECT_FALSE(TTreeFormula("f", "Entry$*x", t).JitCompile());
+}
@@ -0,0 +1,97 @@
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeIndex.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Enough entries for the radix sort to kick in, with negative and equal keys.
+void WriteIndexFile(const char *filename, Long64_t nentries)
+{
+   TFile f(filename, "RECREATE");
+   TTree t("t", "t");
+   Int_t run;
+   Long64_t event;
+   t.Branch("run", &run);
+   t.Branch("event", &event);
+   t.SetAutoFlush(10000);
+   std::vector<Long64_t> order(nentries);
+   std::iota(order.begin(), order.end(), 0);
+   std::shuffle(order.begin(), order.end(), std::mt19937(42));
+   for (auto i : order) {
+      run = Int_t(i % 7) - 3;
+      event = (i / 7) * ((i % 2) ? -1 : 1) * 1000003LL;
+      t.Fill();
+   }
+   t.Write();
+}
+
+void CheckIndex(TTree *t)
+{
+   ASSERT_GT(t->BuildIndex("run", "event"), 0);
+   auto index = static_cast<TTreeIndex *>(t->GetTreeIndex());
+   ASSERT_NE(index, nullptr);
+   const Long64_t n = index->GetN();
+   ASSERT_EQ(n, t->GetEntries());
+
+   Int_t run;
+   Long64_t event;
+   t->SetBranchAddress("run", &run);
+   t->SetBranchAddress("event", &event);
+   std::vector<bool> seen(n, false);
+   for (Long64_t i = 0; i < n; ++i) {
+      if (i > 0) {
+         const bool ordered = index->GetIndexValues()[i - 1] < index->GetIndexValues()[i] ||
+                              (index->GetIndexValues()[i - 1] == index->GetIndexValues()[i] &&
+                               index->GetIndexValuesMinor()[i - 1] <= index->GetIndexValuesMinor()[i]);
+         ASSERT_TRUE(ordered) << "at position " << i;
+      }
+      const Long64_t entry = index->GetIndex()[i];
+      ASSERT_FALSE(seen[entry]);
+      seen[entry] = true;
+      if (i % 997 == 0) {
+         t->GetEntry(entry);
+         EXPECT_EQ(run, index->GetIndexValues()[i]);
+         EXPECT_EQ(event, index->GetIndexValuesMinor()[i]);
+      }
+   }
+
+   EXPECT_GT(t->GetEntryWithIndex(-3, 0), 0);
+   EXPECT_EQ(run, -3);
+   EXPECT_EQ(event, 0);
+   EXPECT_LT(t->GetEntryWithIndex(42, 42), 0);
+   t->ResetBranchAddresses();
+}
+
+TEST(TTreeIndex, Sequential)
+{
+   const auto filename = "treeindex_sequential.root";
+   WriteIndexFile(filename, 100000);
+   {
+      TFile f(filename);
+      CheckIndex(f.Get<TTree>("t"));
+   }
+   gSystem->Unlink(filename);
+}
+
+#ifdef R__USE_IMT
+TEST(TTreeIndex, Parallel)
+{
+   const auto filename = "treeindex_parallel.root";
+   WriteIndexFile(filename, 100000);
+   ROOT::EnableImplicitMT(4);
+   {
+      TFile f(filename);
+      CheckIndex(f.Get<TTree>("t"));
+   }
+   ROOT::DisableImplicitMT();
+   gSystem->Unlink(filename);
+}
+#endif
@@ -0,0 +1,141 @@
+#include "RConfigure.h" // R__USE_IMT
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreePerfStats.h"
+
+#include "gtest/gtest.h"
+
+#include <fstream>
+#include <string>
+
+TEST(TTreePerfStats, BranchesAndTrace)
+{
+   const char *fname = "treeperfstats.root";
+   const char *tracename = "treeperfstats.json";
+   {
+      TFile file(fname, "RECREATE");
+      TTree tree("t", "t");
+      Int_t a;
+      Double_t b;
+      tree.Branch("a", &a);
+      tree.Branch("b", &b);
+      for (a = 0; a < 10000; ++a) {
+         b = a / 3.;
+         tree.Fill();
+      }
+      file.Write();
+   }
+
+   TFile file(fname);
+   auto tree = file.Get<TTree>("t");
+   TTreePerfStats ps("ioperf", tree);
+   ps.SetTimelineSize();
+   tree->SetBranchStatus("b", false);
+   for (Long64_t i = 0; i < tree->GetEntries(); ++i)
+      tree->GetEntry(i);
+
+   const auto &branches = ps.GetBranchesInfo();
+   ASSERT_EQ(branches.size(), 1u);
+   EXPECT_EQ(branches[0].fName, "a");
+   EXPECT_EQ(branches[0].fEntries, 10000u);
+   EXPECT_EQ(branches[0].fBaskets, UInt_t(tree->GetBranch("a")->GetWriteBasket()));
+   EXPECT_GT(branches[0].fBytesUnzipped, 0);
+
+   Bool_t cacheFill = kFALSE;
+   for (const auto &task : ps.GetTasks()) {
+      EXPECT_GE(task.fDuration, 0.);
+      cacheFill |= task.fName == "TTreeCache::FillBuffer";
+   }
+   EXPECT_TRUE(cacheFill);
+   EXPECT_EQ(ps.GetNDroppedTasks(), 0);
+
+   EXPECT_TRUE(ps.SaveTrace(tracename));
+   std::ifstream trace(tracename);
+   std::string start(15, ' ');
+   trace.read(&start[0], start.size());
+   EXPECT_EQ(start, "{\"traceEvents\":");
+   trace.close();
+
+   gSystem->Unlink(tracename);
+   gSystem->Unlink(fname);
+}
+
+TEST(TTreePerfStats, TimelineSize)
+{
+   const char *fname = "treeperfstats_timeline.root";
+   {
+      TFile file(fname, "RECREATE");
+      TTree tree("t", "t");
+      Int_t a;
+      tree.Branch("a", &a, 1000);
+      for (a = 0; a < 10000; ++a)
+         tree.Fill();
+      file.Write();
+   }
+
+   for (Long64_t timelineSize : {0, 1}) {
+      TFile file(fname);
+      auto tree = file.Get<TTree>("t");
+      TTreePerfStats ps("ioperf", tree);
+      if (timelineSize)
+         ps.SetTimelineSize(timelineSize);
+      for (Long64_t i = 0; i < tree->GetEntries(); ++i)
+         tree->GetEntry(i);
+      EXPECT_EQ(ps.GetBranchesInfo().size(), 1u);
+      if (timelineSize) {
+         // The timeline keeps the first tasks only
+         EXPECT_EQ(ps.GetTasks().size(), 1u);
+         EXPECT_GT(ps.GetNDroppedTasks(), 0);
+      } else {
+         // No timeline by default
+         EXPECT_TRUE(ps.GetTasks().empty());
+         EXPECT_EQ(ps.GetNDroppedTasks(), 0);
+      }
+      tree->SetPerfStats(nullptr);
+   }
+
+   gSystem->Unlink(fname);
+}
+
+#ifdef R__USE_IMT
+TEST(TTreePerfStats, ParallelGetEntry)
+{
+   // The branches are read in parallel by TTree::GetEntry: the counters of the threads must all be merged.
+   const char *fname = "treeperfstats_mt.root";
+   const int nBranches = 8;
+   {
+      TFile file(fname, "RECREATE");
+      TTree tree("t", "t");
+      Double_t x[nBranches];
+      for (int b = 0; b < nBranches; ++b)
+         tree.Branch(("x" + std::to_string(b)).c_str(), &x[b]);
+      for (int i = 0; i < 5000; ++i) {
+         for (int b = 0; b < nBranches; ++b)
+            x[b] = i * b;
+         tree.Fill();
+      }
+      file.Write();
+   }
+
+   ROOT::EnableImplicitMT(4);
+   {
+      TFile file(fname);
+      auto tree = file.Get<TTree>("t");
+      TTreePerfStats ps("ioperf", tree);
+      for (Long64_t i = 0; i < tree->GetEntries(); ++i)
+         tree->GetEntry(i);
+      const auto &branches = ps.GetBranchesInfo();
+      EXPECT_EQ(branches.size(), size_t(nBranches));
+      for (const auto &info : branches) {
+         EXPECT_EQ(info.fEntries, 5000u) << info.fName;
+         EXPECT_GE(info.fReadTime, 0.) << info.fName;
+      }
+      tree->SetPerfStats(nullptr);
+   }
+   ROOT::DisableImplicitMT();
+
+   gSystem->Unlink(fname);
+}
+#endif
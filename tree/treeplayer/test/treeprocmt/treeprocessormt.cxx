@@ -101,6 +101,45 @@ void WriteFileManyClusters(unsigned int nevents, const char *treename, const cha
       DeleteFiles(filenames);
    }
 
+   TEST(TreeProcessorMT, SetEntriesRange)
+   {
+      const auto nFiles = 5u;
+      const std::string treename = "t";
+      std::vector<std::string> filenames;
+      for (auto i = 0u; i < nFiles; ++i)
+         filenames.emplace_back("treeprocmt_range_" + std::to_string(i) + ".root");
+
+      WriteFiles(treename, filenames);
+
+      std::atomic_int sum(0);
+      std::atomic_int count(0);
+      std::atomic_bool entriesAreGlobal(true);
+      auto sumValues = [&](TTreeReader &r) {
+         TTreeReaderValue<int> v(r, "v");
+         while (r.Next()) {
+            // the value of v is the global entry number + 1
+            if (*v != r.GetCurrentEntry() + 1)
+               entriesAreGlobal = false;
+            sum += *v;
+            ++count;
+         }
+      };
+
+      std::vector<std::string_view> fnames;
+      for (const auto &f : filenames)
+         fnames.emplace_back(f);
+
+      ROOT::TTreeProcessorMT proc(fnames, treename);
+      proc.SetEntriesRange(15, 35);
+      proc.Process(sumValues);
+
+      EXPECT_EQ(count.load(), 20);
+      EXPECT_EQ(sum.load(), 510); // sum 16..35
+      EXPECT_TRUE(entriesAreGlobal.load());
+
+      DeleteFiles(filenames);
+   }
+
    TEST(TreeProcessorMT, TreeInSubDirectory)
    {
       auto filename = "fileTreeInSubDirectory.root";
@@ -217,6 +256,51 @@ TEST(TreeProcessorMT, LimitNTasks_CheckClusters)
    ROOT::DisableImplicitMT();
 }
 
+TEST(TreeProcessorMT, SplitLargeClusters)
+{
+   const auto nEvents = 100000;
+   const auto filename = "TreeProcessorMT_SplitLargeClusters.root";
+   const auto treename = "t";
+   {
+      // a single cluster
+      int v = 0;
+      TFile file(filename, "recreate");
+      TTree t(treename, treename);
+      t.Branch("v", &v);
+      for (auto i = 0; i < nEvents; ++i) {
+         v = i;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   std::mutex m;
+   std::vector<std::pair<Long64_t, Long64_t>> ranges;
+   std::atomic<Long64_t> sum(0ll);
+   auto f = [&](TTreeReader &t) {
+      {
+         std::lock_guard<std::mutex> l(m);
+         ranges.emplace_back(t.GetEntriesRange());
+      }
+      TTreeReaderValue<int> v(t, "v");
+      while (t.Next())
+         sum += *v;
+   };
+
+   ROOT::DisableImplicitMT();
+   ROOT::EnableImplicitMT(4);
+
+   ROOT::TTreeProcessorMT p(filename, treename);
+   p.Process(f);
+
+   EXPECT_GE(ranges.size(), 4u) << "The cluster was not split among the workers\n";
+   CheckClusters(ranges, nEvents);
+   EXPECT_EQ(sum.load(), Long64_t(nEvents) * (nEvents - 1) / 2);
+
+   gSystem->Unlink(filename);
+   ROOT::DisableImplicitMT();
+}
+
 TEST(TreeProcessorMT, PathName)
 {
    auto fname = "root://eospublic.cern.ch//eos/root-eos/cms_opendata_2012_nanoaod/ZZTo4mu.root";